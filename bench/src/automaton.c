@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the timed scrambles
+ */
+#define SCRAMBLE_LENGTH 100
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the scrambles following a set of rules, walked move by move then
+ * sampled uniformly, and prints the results as JSON lines
+ *
+ * @param name - the name of the rules in the report
+ *
+ * @param rules - the rules to follow
+ */
+static void report_rules(char const * name, struct rba_scramble_rules const * rules)
+{
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton;
+	struct rba_uniform_sampler * sampler;
+	rba_move_code moves[SCRAMBLE_LENGTH];
+	unsigned long checksum = 0;
+	unsigned long iterations = 1;
+	double elapsed;
+	double start = now();
+
+	automaton = rba_compile_scramble_rules(rules, 0);
+	elapsed = now() - start;
+	if (automaton == NULL)
+	{
+		fprintf(stderr, "the rules couldn't be compiled\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf(
+		"{\"benchmark\": \"automaton\", \"api\": \"rba_compile_scramble_rules\", \"rules\": \"%s\", \"us\": %.3f}\n",
+		name,
+		elapsed * 1e6);
+
+	do
+	{
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			checksum += rba_generate_constrained_moves_r(context, automaton, moves, SCRAMBLE_LENGTH);
+			checksum += moves[iteration % SCRAMBLE_LENGTH];
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"automaton\", \"api\": \"rba_generate_constrained_moves_r\", \"rules\": \"%s\", "
+		"\"ns_per_move\": %.3f, \"checksum\": %lu}\n",
+		name,
+		elapsed * 1e9 / ((double) iterations * SCRAMBLE_LENGTH),
+		checksum);
+	fflush(stdout);
+
+	start = now();
+	sampler = rba_create_uniform_sampler(automaton, SCRAMBLE_LENGTH);
+	elapsed = now() - start;
+	if (sampler == NULL)
+	{
+		fprintf(stderr, "the sampler couldn't be created\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf(
+		"{\"benchmark\": \"automaton\", \"api\": \"rba_create_uniform_sampler\", \"rules\": \"%s\", \"us\": %.3f}\n",
+		name,
+		elapsed * 1e6);
+
+	iterations = 1;
+	do
+	{
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			checksum += rba_generate_uniform_moves_r(context, sampler, moves, SCRAMBLE_LENGTH);
+			checksum += moves[iteration % SCRAMBLE_LENGTH];
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"automaton\", \"api\": \"rba_generate_uniform_moves_r\", \"rules\": \"%s\", "
+		"\"ns_per_move\": %.3f, \"checksum\": %lu}\n",
+		name,
+		elapsed * 1e9 / ((double) iterations * SCRAMBLE_LENGTH),
+		checksum);
+	fflush(stdout);
+
+	rba_destroy_uniform_sampler(sampler);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+
+/**
+ * Times weighted regular scrambles, favoring half turns and avoiding slice
+ * moves, and prints the result as a JSON line
+ */
+static void report_weights(void)
+{
+	struct rba_scramble_rules const rules = { 1, 0, 0 };
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	rba_move_code moves[SCRAMBLE_LENGTH];
+	double weights[MOVE_CODES_COUNT];
+	unsigned long checksum = 0;
+	unsigned long iterations = 1;
+	double elapsed;
+
+	for (size_t code = 0; code < MOVE_CODES_COUNT; code++)
+		weights[code] = (code / 3 % 3 == 1) ? 0.1 : (code % 3 == 2) ? 2.0 : 1.0;
+
+	if ((automaton == NULL) || ! rba_weight_scramble_moves(automaton, weights))
+	{
+		fprintf(stderr, "the weights couldn't be set\n");
+		exit(EXIT_FAILURE);
+	}
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			checksum += rba_generate_constrained_moves_r(context, automaton, moves, SCRAMBLE_LENGTH);
+			checksum += moves[iteration % SCRAMBLE_LENGTH];
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"automaton\", \"api\": \"rba_generate_constrained_moves_r\", \"rules\": \"weighted\", "
+		"\"ns_per_move\": %.3f, \"checksum\": %lu}\n",
+		elapsed * 1e9 / ((double) iterations * SCRAMBLE_LENGTH),
+		checksum);
+	fflush(stdout);
+
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+
+
+int main(void)
+{
+	struct rba_scramble_rules const regular_rules = { 1, 0, 0 };
+	struct rba_scramble_rules const run_rules = { 3, 1, 0 };
+	struct rba_scramble_rules const slice_rules = { 2, 1, 8 };
+
+	report_rules("regular", & regular_rules);
+	report_rules("ordered runs", & run_rules);
+	report_rules("spaced slices", & slice_rules);
+	report_weights();
+
+	return EXIT_SUCCESS;
+}
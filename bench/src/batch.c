@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the scramble of each cube
+ */
+#define SCRAMBLE_SIZE 25
+
+
+/**
+ * The number of cubes of the largest batch
+ */
+#define MAX_CUBES_COUNT 65536
+
+
+
+
+/**
+ * The way the scrambles are applied
+ */
+enum application
+{
+	/**
+	 * One cube at a time, with rba_apply_moves()
+	 */
+	EACH_CUBE,
+
+	/**
+	 * Its own scramble to each cube of a batch
+	 */
+	LANE_MOVES,
+
+	/**
+	 * The same scramble to every cube of a batch
+	 */
+	SAME_MOVES
+};
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the application of a scramble to each cube of a set and prints the
+ * result as a JSON line
+ *
+ * @param scrambles - the scramble of each cube, back to back
+ *
+ * @param cubes_count - the number of cubes
+ *
+ * @param application - the way the scrambles are applied
+ *
+ * @return double - the time taken by a move, in nanoseconds
+ */
+static double report(rba_move_code const * scrambles, size_t cubes_count, enum application application)
+{
+	static char const * const names[] = { "rba_apply_moves", "rba_apply_batch_lane_moves", "rba_apply_batch_moves" };
+	static struct rba_cube cubes[MAX_CUBES_COUNT];
+	struct rba_cube_batch * batch = rba_create_cube_batch(cubes_count);
+	unsigned long iterations = 1;
+	size_t solved_count;
+	double elapsed;
+	double ns_per_move;
+
+	for (size_t index = 0; index < cubes_count; index++)
+		rba_init_cube(cubes + index);
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			if (application == LANE_MOVES)
+				rba_apply_batch_lane_moves(batch, scrambles, SCRAMBLE_SIZE);
+			else if (application == SAME_MOVES)
+				rba_apply_batch_moves(batch, scrambles, SCRAMBLE_SIZE);
+			else
+			{
+				for (size_t index = 0; index < cubes_count; index++)
+					rba_apply_moves(cubes + index, scrambles + index * SCRAMBLE_SIZE, SCRAMBLE_SIZE);
+			}
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	if (application == EACH_CUBE)
+	{
+		solved_count = 0;
+		for (size_t index = 0; index < cubes_count; index++)
+			solved_count += rba_is_cube_solved(cubes + index);
+	}
+	else
+		solved_count = rba_count_solved_batch_cubes(batch);
+
+	ns_per_move = elapsed * 1e9 / ((double) iterations * cubes_count * SCRAMBLE_SIZE);
+
+	printf(
+		"{\"benchmark\": \"batch\", \"api\": \"%s\", \"cubes\": %zu, \"length\": %d, "
+		"\"cubes_per_second\": %.1f, \"ns_per_move\": %.3f, \"solved\": %zu}\n",
+		names[application],
+		cubes_count,
+		SCRAMBLE_SIZE,
+		iterations * cubes_count / elapsed,
+		ns_per_move,
+		solved_count);
+	fflush(stdout);
+
+	rba_destroy_cube_batch(batch);
+
+	return ns_per_move;
+}
+
+
+
+
+int main(void)
+{
+	static size_t const counts[] = { 256, 4096, MAX_CUBES_COUNT };
+	static rba_move_code scrambles[MAX_CUBES_COUNT * SCRAMBLE_SIZE];
+	struct rba_context * context = rba_create_context(0);
+	int status = EXIT_SUCCESS;
+
+	for (size_t index = 0; index < MAX_CUBES_COUNT; index++)
+		rba_generate_scramble_moves_r(context, scrambles + index * SCRAMBLE_SIZE, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	for (size_t count = 0; count < sizeof(counts) / sizeof(* counts); count++)
+	{
+		double each_cube = report(scrambles, counts[count], EACH_CUBE);
+		double lane_moves = report(scrambles, counts[count], LANE_MOVES);
+
+		report(scrambles, counts[count], SAME_MOVES);
+
+		/* the lane API only exists to beat the loop over the cubes */
+		if (lane_moves >= each_cube)
+		{
+			fprintf(
+				stderr,
+				"rba_apply_batch_lane_moves is slower than rba_apply_moves on %zu cubes: %.3f ns per move against %.3f\n",
+				counts[count],
+				lane_moves,
+				each_cube);
+			status = EXIT_FAILURE;
+		}
+	}
+
+	rba_destroy_context(context);
+
+	return status;
+}
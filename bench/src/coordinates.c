@@ -0,0 +1,168 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The number of face moves of the walk the coordinates follow
+ */
+#define WALK_LENGTH 4096
+
+
+/**
+ * The number of face moves, the quarter, half and reverse quarter turns of
+ * U R F D L B
+ */
+#define FACE_MOVES_COUNT 18
+
+
+
+
+/**
+ * The code of each face move
+ */
+static rba_move_code const face_moves[FACE_MOVES_COUNT] =
+{
+	0, 1, 2, 6, 7, 8, 9, 10, 11, 15, 16, 17, 18, 19, 20, 24, 25, 26
+};
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the coordinates following a walk move by move through the move
+ * tables, and prints the result as a JSON line
+ *
+ * @param walk - the face moves of the walk
+ */
+static void report_moves(rba_move_code const * walk)
+{
+	struct rba_coordinates coordinates = { 0, 0, 0, 0 };
+	unsigned long iterations = 1;
+	size_t moved_count = 0;
+	double elapsed;
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			for (size_t index = 0; index < WALK_LENGTH; index++)
+				moved_count += rba_move_coordinates(& coordinates, walk + index, 1);
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"coordinates\", \"api\": \"rba_move_coordinates\", \"ns_per_move\": %.3f, "
+		"\"moved\": %zu, \"twist\": %u}\n",
+		elapsed * 1e9 / ((double) iterations * WALK_LENGTH),
+		moved_count,
+		coordinates.twist);
+	fflush(stdout);
+}
+
+
+/**
+ * Times the coordinates computed from scratch on each state of a walk, and
+ * prints the result as a JSON line
+ *
+ * @param walk - the face moves of the walk
+ */
+static void report_from_scratch(rba_move_code const * walk)
+{
+	static struct rba_cube cubes[WALK_LENGTH];
+	struct rba_coordinates coordinates;
+	unsigned long iterations = 1;
+	unsigned long twists = 0;
+	double elapsed;
+
+	rba_init_cube(cubes);
+	for (size_t index = 1; index < WALK_LENGTH; index++)
+	{
+		cubes[index] = cubes[index - 1];
+		rba_apply_moves(cubes + index, walk + index, 1);
+	}
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			for (size_t index = 0; index < WALK_LENGTH; index++)
+			{
+				rba_get_coordinates(cubes + index, & coordinates);
+				twists += coordinates.twist;
+			}
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"coordinates\", \"api\": \"rba_get_coordinates\", \"ns_per_state\": %.3f, "
+		"\"twists\": %lu}\n",
+		elapsed * 1e9 / ((double) iterations * WALK_LENGTH),
+		twists);
+	fflush(stdout);
+}
+
+
+
+
+int main(void)
+{
+	static rba_move_code walk[WALK_LENGTH];
+
+	srand(42);
+	for (size_t index = 0; index < WALK_LENGTH; index++)
+		walk[index] = face_moves[rand() % FACE_MOVES_COUNT];
+
+	if (rba_build_solver_tables(0) != TABLES_OK)
+	{
+		fprintf(stderr, "the tables couldn't be built\n");
+		return EXIT_FAILURE;
+	}
+
+	report_moves(walk);
+	report_from_scratch(walk);
+
+	return EXIT_SUCCESS;
+}
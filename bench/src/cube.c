@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the longest applied sequence
+ */
+#define MAX_SEQUENCE_LENGTH 4096
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the application of a sequence of moves and prints the result as a
+ * JSON line
+ *
+ * @param moves - the sequence to apply
+ *
+ * @param length - the length of the sequence
+ *
+ * @param flags - the options the sequence was generated with
+ */
+static void report(rba_move_code const * moves, size_t length, enum rba_option flags)
+{
+	struct rba_cube cube;
+	unsigned long iterations = 1;
+	size_t applied_moves = 0;
+	double elapsed;
+
+	rba_init_cube(& cube);
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+			applied_moves += rba_apply_moves(& cube, moves, length);
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	if (applied_moves == 0)
+		fprintf(stderr, "no move applied\n");
+
+	printf(
+		"{\"benchmark\": \"cube\", \"api\": \"rba_apply_moves\", \"length\": %zu, "
+		"\"wide_moves\": %s, \"moves_per_second\": %.1f, \"ns_per_move\": %.3f, "
+		"\"first_facelet\": %d}\n",
+		length,
+		(flags & USE_WIDE_MOVES) ? "true" : "false",
+		iterations * length / elapsed,
+		elapsed * 1e9 / ((double) iterations * length),
+		cube.facelets[0]);
+	fflush(stdout);
+}
+
+
+
+
+int main(void)
+{
+	static size_t const lengths[] = { 1, 20, 100, MAX_SEQUENCE_LENGTH };
+	static enum rba_option const flags[] = { NO_OPTIONS, USE_WIDE_MOVES };
+	rba_move_code moves[MAX_SEQUENCE_LENGTH];
+	struct rba_context * context = rba_create_context(0);
+
+	for (size_t flag = 0; flag < sizeof(flags) / sizeof(* flags); flag++)
+	{
+		rba_generate_scramble_moves_r(context, moves, MAX_SEQUENCE_LENGTH, flags[flag]);
+
+		for (size_t length = 0; length < sizeof(lengths) / sizeof(* lengths); length++)
+			report(moves, lengths[length], flags[flag]);
+	}
+
+	rba_destroy_context(context);
+
+	return EXIT_SUCCESS;
+}
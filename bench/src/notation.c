@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the longest parsed scramble
+ */
+#define MAX_SCRAMBLE_LENGTH 8192
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the parsing of a scramble and prints the result as a JSON line
+ *
+ * @param context - the random generator to draw the scramble from
+ *
+ * @param length - the length of the scramble
+ *
+ * @param flags - the options to generate the scramble with
+ */
+static void report(struct rba_context * context, size_t length, enum rba_option flags)
+{
+	static rba_move_code moves[MAX_SCRAMBLE_LENGTH];
+	char * scramble = rba_generate_scramble_r(context, length, flags);
+	size_t scramble_length = strlen(scramble);
+	unsigned long iterations = 1;
+	size_t parsed_moves;
+	double elapsed;
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		parsed_moves = 0;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+			parsed_moves += rba_parse_scramble(scramble, scramble_length, moves, length, NULL);
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	if (parsed_moves != iterations * length)
+		fprintf(stderr, "[%s] wasn't parsed\n", scramble);
+
+	printf(
+		"{\"benchmark\": \"notation\", \"api\": \"rba_parse_scramble\", \"length\": %zu, "
+		"\"wide_moves\": %s, \"scrambles_per_second\": %.1f, \"ns_per_move\": %.3f, "
+		"\"megabytes_per_second\": %.1f}\n",
+		length,
+		(flags & USE_WIDE_MOVES) ? "true" : "false",
+		iterations / elapsed,
+		elapsed * 1e9 / ((double) iterations * length),
+		iterations * scramble_length / elapsed * 1e-6);
+	fflush(stdout);
+
+	free(scramble);
+}
+
+
+
+
+int main(void)
+{
+	static size_t const lengths[] = { 20, 25, 100, MAX_SCRAMBLE_LENGTH };
+	static enum rba_option const flags[] = { NO_OPTIONS, USE_WIDE_MOVES };
+	struct rba_context * context = rba_create_context(0);
+
+	for (size_t flag = 0; flag < sizeof(flags) / sizeof(* flags); flag++)
+	{
+		for (size_t length = 0; length < sizeof(lengths) / sizeof(* lengths); length++)
+			report(context, lengths[length], flags[flag]);
+	}
+
+	rba_destroy_context(context);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the timed scrambles, the one of 7x7 scrambles in
+ * competitions
+ */
+#define SCRAMBLE_LENGTH 100
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the scrambles of a size of cube, as move codes and as strings, and
+ * prints the results as JSON lines
+ *
+ * @param size - the number of layers of the cube
+ */
+static void report_size(size_t size)
+{
+	struct rba_context * context = rba_create_context(42);
+	size_t capacity = rba_compute_nxn_scramble_buffer_size(SCRAMBLE_LENGTH);
+	char * buffer = malloc(capacity);
+	rba_nxn_move_code moves[SCRAMBLE_LENGTH];
+	unsigned long checksum = 0;
+	unsigned long iterations = 1;
+	double elapsed;
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			checksum += rba_generate_nxn_scramble_moves_r(context, size, moves, SCRAMBLE_LENGTH);
+			checksum += moves[iteration % SCRAMBLE_LENGTH];
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"nxn\", \"api\": \"rba_generate_nxn_scramble_moves_r\", \"size\": %zu, "
+		"\"ns_per_move\": %.3f, \"checksum\": %lu}\n",
+		size,
+		elapsed * 1e9 / ((double) iterations * SCRAMBLE_LENGTH),
+		checksum);
+	fflush(stdout);
+
+	iterations = 1;
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+			checksum += rba_generate_nxn_scramble_into_r(context, size, buffer, capacity, SCRAMBLE_LENGTH);
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"nxn\", \"api\": \"rba_generate_nxn_scramble_into_r\", \"size\": %zu, "
+		"\"ns_per_move\": %.3f, \"checksum\": %lu}\n",
+		size,
+		elapsed * 1e9 / ((double) iterations * SCRAMBLE_LENGTH),
+		checksum);
+	fflush(stdout);
+
+	free(buffer);
+	rba_destroy_context(context);
+}
+
+
+
+
+int main(void)
+{
+	for (size_t size = MIN_NXN_SIZE; size <= MAX_NXN_SIZE; size++)
+		report_size(size);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The number of scrambled cubes solved by each iteration
+ */
+#define CUBES_COUNT 1024
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times random state scrambles of a 2x2x2 cube, and prints the result as a
+ * JSON line
+ */
+static void report_random_state_scrambles(void)
+{
+	struct rba_context * context = rba_create_context(42);
+	rba_move_code scramble[POCKET_MAX_LENGTH];
+	unsigned long iterations = 1;
+	size_t moves_count = 0;
+	double elapsed;
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		moves_count = 0;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			moves_count += rba_generate_scramble_moves_r(
+				context,
+				scramble,
+				POCKET_MAX_LENGTH,
+				POCKET_CUBE | RANDOM_STATE);
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"pocket\", \"api\": \"rba_generate_scramble_moves_r\", \"ns_per_scramble\": %.3f, "
+		"\"average_length\": %.3f}\n",
+		elapsed * 1e9 / iterations,
+		(double) moves_count / iterations);
+	fflush(stdout);
+
+	rba_destroy_context(context);
+}
+
+
+/**
+ * Times optimal solves of scrambled cubes, and prints the result as a JSON
+ * line
+ */
+static void report_solves(void)
+{
+	static struct rba_cube cubes[CUBES_COUNT];
+	struct rba_context * context = rba_create_context(42);
+	rba_move_code solution[POCKET_MAX_LENGTH];
+	unsigned long iterations = 1;
+	size_t moves_count = 0;
+	double elapsed;
+
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+	{
+		rba_move_code scramble[POCKET_MAX_LENGTH];
+		size_t length = rba_generate_scramble_moves_r(
+			context,
+			scramble,
+			POCKET_MAX_LENGTH,
+			POCKET_CUBE | RANDOM_STATE);
+
+		rba_init_cube(cubes + index);
+		rba_apply_moves(cubes + index, scramble, length);
+	}
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		moves_count = 0;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			for (size_t index = 0; index < CUBES_COUNT; index++)
+				moves_count += rba_solve_pocket_cube(cubes + index, solution, POCKET_MAX_LENGTH);
+		}
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"pocket\", \"api\": \"rba_solve_pocket_cube\", \"ns_per_solve\": %.3f, "
+		"\"average_length\": %.3f}\n",
+		elapsed * 1e9 / ((double) iterations * CUBES_COUNT),
+		(double) moves_count / ((double) iterations * CUBES_COUNT));
+	fflush(stdout);
+
+	rba_destroy_context(context);
+}
+
+
+
+
+int main(void)
+{
+	double start = now();
+
+	if (rba_build_solver_tables(0) != TABLES_OK)
+	{
+		fprintf(stderr, "the tables couldn't be built\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("{\"benchmark\": \"pocket\", \"api\": \"rba_build_solver_tables\", \"ms\": %.3f}\n", (now() - start) * 1e3);
+	fflush(stdout);
+
+	report_random_state_scrambles();
+	report_solves();
+
+	return EXIT_SUCCESS;
+}
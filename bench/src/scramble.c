@@ -0,0 +1,325 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the scrambles timed across threads
+ */
+#define SCALING_LENGTH 25
+
+
+
+
+/**
+ * The number of allocations made by the library, counted by the malloc()
+ * wrappers below, the library is statically linked with --wrap
+ */
+static unsigned long allocations_count;
+
+
+
+
+void * __real_malloc(size_t size);
+void * __real_realloc(void * pointer, size_t size);
+
+
+void * __wrap_malloc(size_t size)
+{
+	__sync_fetch_and_add(& allocations_count, 1);
+
+	return __real_malloc(size);
+}
+
+
+void * __wrap_realloc(void * pointer, size_t size)
+{
+	__sync_fetch_and_add(& allocations_count, 1);
+
+	return __real_realloc(pointer, size);
+}
+
+
+
+
+/**
+ * The scramble generation functions to time
+ */
+typedef enum benchmarked_api
+{
+	GENERATE_SCRAMBLE_R,
+	GENERATE_SCRAMBLE_INTO_R
+} benchmarked_api;
+
+
+/**
+ * The state of a measuring thread
+ */
+typedef struct bench_worker
+{
+	/**
+	 * The generator of the thread
+	 */
+	struct rba_context * context;
+
+	/**
+	 * The buffer generated scrambles are writen to
+	 */
+	char * buffer;
+
+	/**
+	 * The size of the buffer
+	 */
+	size_t capacity;
+
+	/**
+	 * The length of the generated scrambles
+	 */
+	size_t length;
+
+	/**
+	 * The options of the generated scrambles
+	 */
+	enum rba_option flags;
+
+	/**
+	 * The function to time
+	 */
+	benchmarked_api api;
+
+	/**
+	 * The number of scrambles to generate
+	 */
+	unsigned long iterations;
+
+	/**
+	 * Sum of the generated lengths, so the work can't be optimized out
+	 */
+	size_t checksum;
+} bench_worker;
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Generates the scrambles of a worker
+ *
+ * @param argument - the worker
+ *
+ * @return void * - NULL
+ */
+static void * run_worker(void * argument)
+{
+	bench_worker * worker = argument;
+
+	for (unsigned long iteration = 0; iteration < worker->iterations; iteration++)
+	{
+		if (worker->api == GENERATE_SCRAMBLE_R)
+		{
+			char * scramble = rba_generate_scramble_r(worker->context, worker->length, worker->flags);
+			worker->checksum += scramble[0];
+			free(scramble);
+		}
+		else
+		{
+			worker->checksum += rba_generate_scramble_into_r(
+				worker->context,
+				worker->buffer,
+				worker->capacity,
+				worker->length,
+				worker->flags);
+		}
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Times scramble generation on several threads, each thread generating the
+ * same number of scrambles with its own context
+ *
+ * @param api - the function to time
+ *
+ * @param length - the length of the scrambles
+ *
+ * @param flags - the options of the scrambles
+ *
+ * @param threads_count - the number of threads to run
+ *
+ * @param scrambles_count - the total number of generated scrambles, output
+ *
+ * @param allocations - the number of allocations made, output
+ *
+ * @return double - the elapsed time, in seconds
+ */
+static double time_generation(
+	benchmarked_api api,
+	size_t length,
+	enum rba_option flags,
+	size_t threads_count,
+	unsigned long * scrambles_count,
+	unsigned long * allocations)
+{
+	bench_worker * workers = calloc(threads_count, sizeof(* workers));
+	pthread_t * threads = calloc(threads_count, sizeof(* threads));
+	unsigned long iterations = 1;
+	double elapsed;
+
+	for (size_t index = 0; index < threads_count; index++)
+	{
+		workers[index].context = rba_create_context(index);
+		workers[index].capacity = rba_compute_scramble_buffer_size(length, flags);
+		workers[index].buffer = malloc(workers[index].capacity);
+		workers[index].length = length;
+		workers[index].flags = flags;
+		workers[index].api = api;
+	}
+
+	do
+	{
+		unsigned long allocations_before;
+		double start;
+
+		iterations *= 2;
+		for (size_t index = 0; index < threads_count; index++)
+			workers[index].iterations = iterations;
+
+		allocations_before = allocations_count;
+		start = now();
+
+		for (size_t index = 0; index < threads_count; index++)
+			pthread_create(threads + index, NULL, run_worker, workers + index);
+		for (size_t index = 0; index < threads_count; index++)
+			pthread_join(threads[index], NULL);
+
+		elapsed = now() - start;
+		* allocations = allocations_count - allocations_before;
+	}
+	while (elapsed < MIN_DURATION);
+
+	* scrambles_count = iterations * threads_count;
+
+	for (size_t index = 0; index < threads_count; index++)
+	{
+		if (workers[index].checksum == 0)
+			fprintf(stderr, "nothing generated on thread %zu\n", index);
+
+		free(workers[index].buffer);
+		rba_destroy_context(workers[index].context);
+	}
+	free(workers);
+	free(threads);
+
+	return elapsed;
+}
+
+
+/**
+ * Times scramble generation and prints the result as a JSON line
+ *
+ * @param api - the function to time
+ *
+ * @param length - the length of the scrambles
+ *
+ * @param flags - the options of the scrambles
+ *
+ * @param threads_count - the number of threads to run
+ *
+ * @param reference_rate - the rate of a single thread to compute the
+ * 	speedup from, or 0 when measuring a single thread
+ *
+ * @return double - the measured rate, in scrambles per second
+ */
+static double report(
+	benchmarked_api api,
+	size_t length,
+	enum rba_option flags,
+	size_t threads_count,
+	double reference_rate)
+{
+	static char const * api_names[] = { "rba_generate_scramble_r", "rba_generate_scramble_into_r" };
+	unsigned long scrambles_count;
+	unsigned long allocations;
+	double elapsed = time_generation(api, length, flags, threads_count, & scrambles_count, & allocations);
+	double rate = scrambles_count / elapsed;
+
+	printf(
+		"{\"benchmark\": \"scramble\", \"api\": \"%s\", \"length\": %zu, "
+		"\"wide_moves\": %s, \"threads\": %zu, \"scrambles_per_second\": %.1f, "
+		"\"ns_per_move\": %.3f, \"allocations_per_scramble\": %.3f, \"speedup\": %.2f}\n",
+		api_names[api],
+		length,
+		(flags & USE_WIDE_MOVES) ? "true" : "false",
+		threads_count,
+		rate,
+		elapsed * 1e9 / ((double) scrambles_count * length),
+		(double) allocations / scrambles_count,
+		reference_rate > 0 ? rate / reference_rate : 1.0);
+	fflush(stdout);
+
+	return rate;
+}
+
+
+
+
+int main(void)
+{
+	static size_t const lengths[] = { 20, 25, 100, 8192 };
+	static enum rba_option const flags[] = { NO_OPTIONS, USE_WIDE_MOVES };
+	long processors_count = sysconf(_SC_NPROCESSORS_ONLN);
+	double single_thread_rate;
+
+	/* single thread, every length and option */
+	for (size_t api = GENERATE_SCRAMBLE_R; api <= GENERATE_SCRAMBLE_INTO_R; api++)
+	{
+		for (size_t length = 0; length < sizeof(lengths) / sizeof(* lengths); length++)
+		{
+			for (size_t flag = 0; flag < sizeof(flags) / sizeof(* flags); flag++)
+				report(api, lengths[length], flags[flag], 1, 0);
+		}
+	}
+
+	/* scaling across threads, each one with its own context */
+	single_thread_rate = report(GENERATE_SCRAMBLE_INTO_R, SCALING_LENGTH, USE_WIDE_MOVES, 1, 0);
+	for (long threads_count = 2; threads_count <= 2 * processors_count; threads_count *= 2)
+	{
+		report(
+			GENERATE_SCRAMBLE_INTO_R,
+			SCALING_LENGTH,
+			USE_WIDE_MOVES,
+			threads_count,
+			single_thread_rate);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached
+ */
+#define MIN_DURATION 0.25
+
+
+/**
+ * The length of the longest simplified sequence
+ */
+#define MAX_SEQUENCE_LENGTH 8192
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the simplification of a sequence of random moves, any of them
+ * following any other, and prints the result as a JSON line
+ *
+ * @param length - the length of the sequence
+ *
+ * @param flags - the options to simplify the sequence with
+ */
+static void report(size_t length, enum rba_option flags)
+{
+	static rba_move_code moves[MAX_SEQUENCE_LENGTH];
+	static rba_move_code simplified[2 * MAX_SEQUENCE_LENGTH];
+	unsigned long iterations = 1;
+	size_t simplified_length = 0;
+	double elapsed;
+
+	for (size_t index = 0; index < length; index++)
+		moves[index] = rand() % MOVE_CODES_COUNT;
+
+	do
+	{
+		double start;
+
+		iterations *= 2;
+		start = now();
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+			simplified_length = rba_simplify_moves(moves, length, simplified, 2 * length, flags);
+
+		elapsed = now() - start;
+	}
+	while (elapsed < MIN_DURATION);
+
+	printf(
+		"{\"benchmark\": \"simplifier\", \"api\": \"rba_simplify_moves\", \"length\": %zu, "
+		"\"wide_moves\": %s, \"sequences_per_second\": %.1f, \"ns_per_move\": %.3f, "
+		"\"simplified_length\": %zu}\n",
+		length,
+		(flags & USE_WIDE_MOVES) ? "true" : "false",
+		iterations / elapsed,
+		elapsed * 1e9 / ((double) iterations * length),
+		simplified_length);
+	fflush(stdout);
+}
+
+
+
+
+int main(void)
+{
+	static size_t const lengths[] = { 20, 100, MAX_SEQUENCE_LENGTH };
+	static enum rba_option const flags[] = { NO_OPTIONS, USE_WIDE_MOVES };
+
+	srand(42);
+
+	for (size_t flag = 0; flag < sizeof(flags) / sizeof(* flags); flag++)
+	{
+		for (size_t length = 0; length < sizeof(lengths) / sizeof(* lengths); length++)
+			report(lengths[length], flags[flag]);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The minimum duration of a measure, in seconds, iterations are doubled until
+ * it is reached, solving times vary a lot from a state to another
+ */
+#define MIN_DURATION 1.
+
+
+/**
+ * The length of the longest random state scramble
+ */
+#define MAX_SCRAMBLE_LENGTH 30
+
+
+/**
+ * The maximum length of the solutions of the parallel solver, shorter than
+ * random state scrambles, so the slow searches show in the percentiles
+ */
+#define PARALLEL_SOLUTION_LENGTH 21
+
+
+/**
+ * The number of cubes solved in parallel to compute percentiles on
+ */
+#define PARALLEL_SOLVES_COUNT 200
+
+
+/**
+ * Long enough for a random walk to reach any state
+ */
+#define WALK_LENGTH 100
+
+
+
+
+/**
+ * Returns the current time of a monotonic clock
+ *
+ * @return double - the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, & time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Times the generation of random state scrambles and prints the result as a
+ * JSON line
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param length - the maximum length of the scrambles
+ */
+static void report(struct rba_context * context, size_t length)
+{
+	rba_move_code moves[MAX_SCRAMBLE_LENGTH];
+	unsigned long iterations = 1;
+	unsigned long scrambles = 0;
+	size_t total_length = 0;
+	size_t failures = 0;
+	double slowest = 0.;
+	double elapsed = 0.;
+
+	while (elapsed < MIN_DURATION)
+	{
+		iterations *= 2;
+
+		for (unsigned long iteration = 0; iteration < iterations; iteration++)
+		{
+			double start = now();
+			size_t count = rba_generate_scramble_moves_r(context, moves, length, RANDOM_STATE);
+			double duration = now() - start;
+
+			total_length += count;
+			failures += (count == 0);
+			elapsed += duration;
+			if (duration > slowest)
+				slowest = duration;
+		}
+
+		scrambles += iterations;
+	}
+
+	printf(
+		"{\"benchmark\": \"solver\", \"api\": \"rba_generate_scramble_moves_r\", "
+		"\"max_length\": %zu, \"ms_per_scramble\": %.3f, \"slowest_ms\": %.3f, "
+		"\"mean_length\": %.2f, \"failures\": %zu}\n",
+		length,
+		elapsed * 1e3 / scrambles,
+		slowest * 1e3,
+		(double) total_length / scrambles,
+		failures);
+	fflush(stdout);
+}
+
+
+/**
+ * Compares 2 durations, for qsort()
+ *
+ * @param first - the first duration
+ *
+ * @param second - the second duration
+ *
+ * @return int - negative, 0 or positive as the first is shorter, equal or
+ * 	longer
+ */
+static int compare_durations(void const * first, void const * second)
+{
+	double first_duration = * (double const *) first;
+	double second_duration = * (double const *) second;
+
+	return (first_duration > second_duration) - (first_duration < second_duration);
+}
+
+
+/**
+ * Times the parallel solves of randomly walked cubes, with a thread per
+ * processor, and prints the percentiles as a JSON line
+ *
+ * @param context - the random generator to draw from
+ */
+static void report_parallel(struct rba_context * context)
+{
+	static double durations[PARALLEL_SOLVES_COUNT];
+	rba_move_code moves[WALK_LENGTH];
+	size_t failures = 0;
+
+	for (size_t index = 0; index < PARALLEL_SOLVES_COUNT; index++)
+	{
+		struct rba_cube cube;
+		size_t count = rba_generate_scramble_moves_r(context, moves, WALK_LENGTH, NO_OPTIONS);
+
+		rba_init_cube(& cube);
+		rba_apply_moves(& cube, moves, count);
+
+		double start = now();
+		failures += (rba_solve_cube_parallel(& cube, moves, PARALLEL_SOLUTION_LENGTH, 0) == 0);
+		durations[index] = now() - start;
+	}
+
+	qsort(durations, PARALLEL_SOLVES_COUNT, sizeof(* durations), compare_durations);
+	printf(
+		"{\"benchmark\": \"solver\", \"api\": \"rba_solve_cube_parallel\", "
+		"\"max_length\": %d, \"p50_ms\": %.3f, \"p99_ms\": %.3f, \"slowest_ms\": %.3f, "
+		"\"failures\": %zu}\n",
+		PARALLEL_SOLUTION_LENGTH,
+		durations[PARALLEL_SOLVES_COUNT / 2] * 1e3,
+		durations[PARALLEL_SOLVES_COUNT * 99 / 100] * 1e3,
+		durations[PARALLEL_SOLVES_COUNT - 1] * 1e3,
+		failures);
+	fflush(stdout);
+}
+
+
+
+
+int main(void)
+{
+	static size_t const lengths[] = { 21, RANDOM_STATE_MIN_LENGTH, 25, MAX_SCRAMBLE_LENGTH };
+	struct rba_context * context = rba_create_context(0);
+	double start = now();
+
+	/* with a thread per processor */
+	if (rba_build_solver_tables(0) != TABLES_OK)
+	{
+		fprintf(stderr, "the tables couldn't be built\n");
+		return EXIT_FAILURE;
+	}
+	printf(
+		"{\"benchmark\": \"solver\", \"api\": \"rba_build_solver_tables\", \"build_seconds\": %.3f}\n",
+		now() - start);
+	fflush(stdout);
+
+	for (size_t length = 0; length < sizeof(lengths) / sizeof(* lengths); length++)
+		report(context, lengths[length]);
+	report_parallel(context);
+
+	rba_destroy_context(context);
+
+	return EXIT_SUCCESS;
+}
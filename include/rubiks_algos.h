@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 
 
 
@@ -30,12 +31,398 @@ enum rba_option
 	 * 	With singmaster notation, wide moves are lowercase layers,
 	 * 	eg., [r'] = right layers anticlockwise
 	 */
-	USE_WIDE_MOVES = 1
+	USE_WIDE_MOVES = 1,
+
+	/**
+	 * The scramble leads to a state drawn uniformly among every reachable
+	 * state but the solved one, as required in competitions, instead of
+	 * being a random walk
+	 * 	Scrambles are the reversed solution of the state found by a two-phase
+	 * 	solver, the requested length is their maximum length, at least
+	 * 	RANDOM_STATE_MIN_LENGTH is advised, USE_WIDE_MOVES is ignored
+	 * 	The tables of the solver are built on the first scramble
+	 */
+	RANDOM_STATE = 2,
+
+	/**
+	 * The scramble is for a 2x2x2 cube: only the U, R and F faces are
+	 * turned, they reach every state with the D-B-L corner in place
+	 * 	With RANDOM_STATE, scrambles are the reversed optimal solution of a
+	 * 	state drawn uniformly, found by descending a table of the distance of
+	 * 	every state, POCKET_MAX_LENGTH moves are always enough
+	 * 	USE_WIDE_MOVES is ignored
+	 */
+	POCKET_CUBE = 4
+};
+
+
+/**
+ * The length from which random state scrambles are found quickly, every
+ * state can be solved in 20 moves but finding such solutions is much slower
+ */
+#define RANDOM_STATE_MIN_LENGTH 22
+
+
+/**
+ * The number of moves solving any state of a 2x2x2 cube, turning the U, R
+ * and F faces
+ */
+#define POCKET_MAX_LENGTH 11
+
+
+
+
+/**
+ * A move encoded in a single byte, 3 * layer + modifier
+ * Layers are ordered L M R U E D F S B, then wide layers l r u d f b,
+ * modifiers are ordered none, ' and 2
+ * eg., 0 is [L], 4 is [M'], 44 is [b2]
+ */
+typedef uint8_t rba_move_code;
+
+
+/**
+ * The number of move codes without wide moves, they come first
+ */
+#define BASE_MOVE_CODES_COUNT 27
+
+
+/**
+ * The number of move codes, wide moves included
+ */
+#define MOVE_CODES_COUNT 45
+
+
+/**
+ * The sizes of the cubes NxN scrambles are generated for, see
+ * rba_generate_nxn_scramble_moves_r()
+ */
+#define MIN_NXN_SIZE 2
+#define MAX_NXN_SIZE 7
+
+
+/**
+ * The maximum number of outer layers turned by an NxN move, half of the
+ * largest cube
+ */
+#define MAX_NXN_DEPTH 3
+
+
+/**
+ * A move of an NxN cube encoded in a single byte,
+ * 3 * (MAX_NXN_DEPTH * face + depth - 1) + modifier
+ * Faces are ordered as rba_face, the depth is the number of outer layers
+ * turned, 1 to MAX_NXN_DEPTH, modifiers are ordered none, ' and 2
+ * eg., 0 is [U], 13 is [Rw'], 17 is [3Rw2]
+ */
+typedef uint8_t rba_nxn_move_code;
+
+
+/**
+ * The number of NxN move codes
+ */
+#define NXN_MOVE_CODES_COUNT 54
+
+
+/**
+ * The largest number of moves required between 2 slice moves, see
+ * rba_compile_scramble_rules()
+ */
+#define MAX_SLICE_SPACING 32
+
+
+
+
+/**
+ * The 6 faces of the cube, the color of a sticker is the face of the center
+ * it matches on a solved cube
+ */
+enum rba_face
+{
+	UP_FACE,
+	RIGHT_FACE,
+	FRONT_FACE,
+	DOWN_FACE,
+	LEFT_FACE,
+	BACK_FACE
+};
+
+
+/**
+ * The outcomes of saving and loading the tables of the solver
+ */
+enum rba_tables_status
+{
+	TABLES_OK = 0,
+
+	/**
+	 * The file couldn't be opened, read, written or mapped, see errno
+	 */
+	TABLES_IO_ERROR,
+
+	/**
+	 * The tables couldn't be allocated to be built
+	 */
+	TABLES_OUT_OF_MEMORY,
+
+	/**
+	 * The file is not a tables file, or it is truncated
+	 */
+	TABLES_INVALID_FILE,
+
+	/**
+	 * The file was made by a version of the library with other tables
+	 */
+	TABLES_VERSION_MISMATCH,
+
+	/**
+	 * The file was made on a machine with another byte order
+	 */
+	TABLES_ENDIANNESS_MISMATCH,
+
+	/**
+	 * The content of the file is corrupted
+	 */
+	TABLES_CHECKSUM_MISMATCH
+};
+
+
+/**
+ * The number of faces of a cube
+ */
+#define FACES_COUNT 6
+
+
+/**
+ * The number of stickers of a cube, 9 per face
+ */
+#define FACELETS_COUNT 54
+
+
+/**
+ * The size of a cube state, the stickers are padded to 64 bytes so moves can
+ * be applied with vector shuffles
+ */
+#define CUBE_SIZE 64
+
+
+/**
+ * The state of a cube, as the color of each of its stickers
+ * Faces are ordered U R F D L B, the 9 stickers of each face are read row by
+ * row: U with B on top, D with F on top, the 4 other faces with U on top
+ */
+struct rba_cube
+{
+	/**
+	 * The rba_face of each sticker, FACELETS_COUNT used entries
+	 */
+	uint8_t facelets[CUBE_SIZE];
+};
+
+
+/**
+ * A cube state packed in a 32 bits word per face, faces ordered as in
+ * rba_cube, so a whole cube fits in a vector register
+ * The 8 outer stickers of a face take 3 bits each, clockwise from the top
+ * left one, the center takes bits 24 to 26, the other bits are always 0 so
+ * cubes can be compared or hashed word by word
+ */
+struct rba_bitboard_cube
+{
+	/**
+	 * The stickers of each face
+	 */
+	uint32_t faces[FACES_COUNT];
+};
+
+
+/**
+ * The number of values of each coordinate of rba_coordinates
+ */
+#define TWIST_COUNT 2187
+#define FLIP_COUNT 2048
+#define SLICE_COUNT 495
+#define CORNER_PERMUTATION_COUNT 40320
+
+
+/**
+ * The coordinates of a cube used by table-driven searches, such as the first
+ * phase of the two-phase algorithm, each one being 0 on a solved cube
+ * The coordinates follow face moves through move tables, see
+ * rba_move_coordinates()
+ */
+struct rba_coordinates
+{
+	/**
+	 * The orientation of the corners, 0 to TWIST_COUNT - 1
+	 */
+	unsigned int twist;
+
+	/**
+	 * The orientation of the edges, 0 to FLIP_COUNT - 1
+	 */
+	unsigned int flip;
+
+	/**
+	 * The positions of the 4 edges of the UD slice, whatever their order, 0
+	 * to SLICE_COUNT - 1
+	 */
+	unsigned int slice;
+
+	/**
+	 * The permutation of the corners, 0 to CORNER_PERMUTATION_COUNT - 1
+	 */
+	unsigned int corner_permutation;
+};
+
+
+
+
+/**
+ * A random generator, holding its own state
+ * Functions taking a context (suffixed with _r) don't share any state, each
+ * thread can use its own context
+ */
+struct rba_context;
+
+
+/**
+ * An endless scramble sequence, generated move by move in constant memory
+ */
+struct rba_stream;
+
+
+/**
+ * The stickers of many cubes, stored sticker by sticker so a move is applied
+ * to all of them at once
+ */
+struct rba_cube_batch;
+
+
+/**
+ * A finite automaton generating scrambles which follow a set of rules, see
+ * rba_compile_scramble_rules()
+ */
+struct rba_scramble_automaton;
+
+
+/**
+ * Draws the sequences of an automaton with every sequence of a given length
+ * equally likely, see rba_create_uniform_sampler()
+ */
+struct rba_uniform_sampler;
+
+
+/**
+ * Several scrambles stored back to back in a single allocation, along with
+ * their positions
+ * The whole batch, strings and offsets included, is released with a single
+ * free() of the batch
+ */
+struct rba_scramble_batch
+{
+	/**
+	 * The number of scrambles in the batch
+	 */
+	size_t count;
+
+	/**
+	 * The position of each scramble in [strings], [count] + 1 entries, the
+	 * last one being the total size of [strings]
+	 */
+	size_t * offsets;
+
+	/**
+	 * The NULL-terminated scrambles, back to back, scramble i starts at
+	 * strings + offsets[i]
+	 */
+	char * strings;
+};
+
+
+/**
+ * The rules followed by constrained scrambles, see
+ * rba_compile_scramble_rules()
+ * { 1, 0, 0 } are the rules of regular scrambles
+ */
+struct rba_scramble_rules
+{
+	/**
+	 * The maximum number of consecutive moves on the same axis, 1 to 3, the
+	 * moves of a run always turn distinct layers, so [R L R] is never
+	 * generated
+	 */
+	unsigned int max_axis_run;
+
+	/**
+	 * Not 0 to only generate the moves of a run in the order of their layers
+	 * (L M R, U E D, F S B), so [L R] is generated but [R L] isn't
+	 */
+	int ordered_axis_runs;
+
+	/**
+	 * The minimum number of other moves between 2 slice moves ([M], [E],
+	 * [S]), 0 to MAX_SLICE_SPACING
+	 */
+	unsigned int slice_spacing;
 };
 
 
 
 
+/**
+ * Creates a random generator
+ * The caller is in charge of the memory, see rba_destroy_context()
+ *
+ * @param seed - the seed of the generator, the same seed always generates the
+ * 	same scrambles
+ *
+ * @return struct rba_context * - the created context, or NULL if the
+ * 	allocation failed
+ */
+IMPORTANT_RETURN struct rba_context * rba_create_context(uint64_t seed);
+
+
+/**
+ * Destroys a random generator
+ *
+ * @param context - the context to destroy, may be NULL
+ */
+void rba_destroy_context(struct rba_context * context);
+
+
+/**
+ * Reseeds a random generator, restarting its sequence
+ *
+ * @param context - the context to reseed
+ *
+ * @param seed - the new seed of the generator
+ */
+void rba_seed_context(struct rba_context * context, uint64_t seed);
+
+
+/**
+ * Reseeds a random generator at the start of the sequence of the given index,
+ * in constant time
+ * Sequences of different indexes are independent, so scramble i of a seed
+ * can be generated alone, or on another thread or machine, with the same
+ * result
+ *
+ * @param context - the context to reseed
+ *
+ * @param seed - the seed shared by all indexes
+ *
+ * @param index - the index of the sequence, index 0 is the sequence of
+ * 	rba_seed_context()
+ */
+void rba_seed_context_at(
+	struct rba_context * context,
+	uint64_t seed,
+	uint64_t index);
+
+
+
+
 /**
  * Generates a scramble sequence, guaranteed to contain no more than 1 move
  * per axis
@@ -50,6 +437,1064 @@ IMPORTANT_RETURN char * rba_generate_scramble(
 	enum rba_option flags);
 
 
+/**
+ * Computes the size of a buffer large enough to store any scramble of the
+ * given length, NULL-terminating byte included
+ *
+ * @param length - the length of the sequence to store
+ *
+ * @param flags - the options the sequence will be generated with
+ *
+ * @return size_t - the required buffer size, or 0 if length is 0
+ */
+size_t rba_compute_scramble_buffer_size(
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Generates a scramble sequence in the given buffer, guaranteed to contain no
+ * more than 1 move per axis
+ * No allocation is made, the caller owns the buffer
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_scramble_buffer_size()
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0 or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_scramble_into(
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Reentrant version of rba_generate_scramble(), drawing from the given
+ * context instead of rand()
+ *
+ * @param context - the random generator to draw from
+ *
+ * @return char * - the generated sequence, or NULL if any allocation failed
+ */
+IMPORTANT_RETURN char * rba_generate_scramble_r(
+	struct rba_context * context,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Reentrant version of rba_generate_scramble_into(), drawing from the given
+ * context instead of rand()
+ *
+ * @param context - the random generator to draw from
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0 or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_scramble_into_r(
+	struct rba_context * context,
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Generates a scramble sequence as move codes, guaranteed to contain no more
+ * than 1 move per axis
+ *
+ * @param moves - the buffer to write the codes to, at least [length] long
+ *
+ * @param length - the length of the sequence to generate, the maximum
+ * 	length with RANDOM_STATE
+ *
+ * @return size_t - the number of generated moves, 0 if length is 0, or with
+ * 	RANDOM_STATE if no scramble of at most length moves was found
+ */
+size_t rba_generate_scramble_moves(
+	rba_move_code * moves,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Reentrant version of rba_generate_scramble_moves(), drawing from the given
+ * context instead of rand()
+ *
+ * @param context - the random generator to draw from
+ *
+ * @return size_t - the number of generated moves, 0 if length is 0
+ */
+size_t rba_generate_scramble_moves_r(
+	struct rba_context * context,
+	rba_move_code * moves,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Writes move codes as a scramble sequence, using singmaster notation
+ *
+ * @param moves - the codes of the moves to write
+ *
+ * @param count - the number of moves to write
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_scramble_buffer_size()
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if count is 0, a code is invalid or the
+ * 	buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_write_move_codes(
+	rba_move_code const * moves,
+	size_t count,
+	char * buffer,
+	size_t capacity);
+
+
+/**
+ * Reads a scramble sequence in singmaster notation as move codes
+ *
+ * @param scramble - the NULL-terminated sequence to read, see
+ * 	rba_parse_scramble()
+ *
+ * @param moves - the buffer to write the codes to
+ *
+ * @param capacity - the number of codes the buffer can store
+ *
+ * @return size_t - the number of read moves, or 0 if the sequence is empty,
+ * 	contains an invalid move or doesn't fit in the buffer
+ */
+IMPORTANT_RETURN size_t rba_read_move_codes(
+	char const * scramble,
+	rba_move_code * moves,
+	size_t capacity);
+
+
+/**
+ * Parses a scramble sequence in singmaster notation as move codes, without
+ * modifying nor copying it
+ * Moves are separated by runs of whitespaces, base, slice and wide layers are
+ * accepted with the ' and 2 modifiers
+ *
+ * @param scramble - the sequence to parse, not necessarily NULL-terminated
+ *
+ * @param length - the number of bytes of the sequence
+ *
+ * @param moves - the buffer to write the codes to
+ *
+ * @param capacity - the number of codes the buffer can store
+ *
+ * @param error_offset - set to the position of the first invalid byte, or of
+ * 	the first move which doesn't fit in the buffer, set to length if the
+ * 	sequence is valid, may be NULL
+ *
+ * @return size_t - the number of parsed moves, or 0 if the sequence is empty
+ * 	or on error
+ */
+IMPORTANT_RETURN size_t rba_parse_scramble(
+	char const * scramble,
+	size_t length,
+	rba_move_code * moves,
+	size_t capacity,
+	size_t * error_offset);
+
+
+/**
+ * Simplifies a sequence of moves in a single pass: consecutive moves turning
+ * around the same axis commute, they are merged into the fewest moves doing
+ * the same, and dropped if they cancel out, eg. [R L R] becomes [L R2] and
+ * [R U U' R'] vanishes
+ *
+ * @param moves - the codes of the moves to simplify
+ *
+ * @param count - the number of moves
+ *
+ * @param simplified - the buffer to write the codes of the simplified moves
+ * 	to, it can be moves itself with USE_WIDE_MOVES
+ *
+ * @param capacity - the number of codes the buffer can store, count codes
+ * 	are always enough with USE_WIDE_MOVES, 2 * count without
+ *
+ * @param flags - USE_WIDE_MOVES to keep wide moves and use them when
+ * 	shorter, eg. [R M'] becomes [r], otherwise wide moves are turned into a
+ * 	face and a slice move, eg. [r] becomes [R M']
+ *
+ * @return size_t - the number of simplified moves, or 0 if the moves cancel
+ * 	out, a code is invalid or the simplified moves don't fit in the buffer
+ */
+IMPORTANT_RETURN size_t rba_simplify_moves(
+	rba_move_code const * moves,
+	size_t count,
+	rba_move_code * simplified,
+	size_t capacity,
+	enum rba_option flags);
+
+/**
+ * Generates several scramble sequences in a single allocation, each one
+ * guaranteed to contain no more than 1 move per axis
+ * The caller is in charge of the memory, the batch is released with free()
+ *
+ * @param count - the number of sequences to generate
+ *
+ * @param length - the length of each sequence
+ *
+ * @return struct rba_scramble_batch * - the generated sequences, or NULL if
+ * 	count or length is 0, or if the allocation failed
+ */
+IMPORTANT_RETURN struct rba_scramble_batch * rba_generate_scrambles(
+	size_t count,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Reentrant version of rba_generate_scrambles(), drawing from the given
+ * context instead of rand()
+ *
+ * @param context - the random generator to draw from
+ *
+ * @return struct rba_scramble_batch * - the generated sequences, or NULL if
+ * 	count or length is 0, or if the allocation failed
+ */
+IMPORTANT_RETURN struct rba_scramble_batch * rba_generate_scrambles_r(
+	struct rba_context * context,
+	size_t count,
+	size_t length,
+	enum rba_option flags);
+
+
+
+
+/**
+ * Generates the scramble sequence of the given index, guaranteed to contain
+ * no more than 1 move per axis
+ * It only depends on its arguments, in constant time whatever the index
+ * The caller is in charge of the memory
+ *
+ * @param seed - the seed shared by all indexes
+ *
+ * @param index - the index of the sequence to generate
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return char * - the generated sequence, or NULL if any allocation failed
+ */
+IMPORTANT_RETURN char * rba_generate_scramble_at(
+	uint64_t seed,
+	uint64_t index,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Generates the scramble sequence of the given index in the given buffer,
+ * see rba_generate_scramble_at() and rba_generate_scramble_into()
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0 or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_scramble_into_at(
+	uint64_t seed,
+	uint64_t index,
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Generates the scramble sequences of consecutive indexes in a single
+ * allocation, scramble i of the batch is the one of index [first_index] + i
+ * Batches of a seed can be split in any way, across threads or machines, and
+ * still match
+ * The caller is in charge of the memory, the batch is released with free()
+ *
+ * @param seed - the seed shared by all indexes
+ *
+ * @param first_index - the index of the first sequence of the batch
+ *
+ * @param count - the number of sequences to generate
+ *
+ * @param length - the length of each sequence
+ *
+ * @return struct rba_scramble_batch * - the generated sequences, or NULL if
+ * 	count or length is 0, or if the allocation failed
+ */
+IMPORTANT_RETURN struct rba_scramble_batch * rba_generate_scrambles_at(
+	uint64_t seed,
+	uint64_t first_index,
+	size_t count,
+	size_t length,
+	enum rba_option flags);
+
+
+/**
+ * Creates an endless scramble sequence, guaranteed to contain no more than 1
+ * move per axis
+ * The caller is in charge of the memory, see rba_destroy_stream()
+ *
+ * @param seed - the seed of the sequence, the same seed always generates the
+ * 	same sequence
+ *
+ * @param flags - USE_WIDE_MOVES to generate wide moves, POCKET_CUBE to only
+ * 	generate R, U and F moves, RANDOM_STATE is rejected as a state can't be
+ * 	drawn for an endless sequence
+ *
+ * @return struct rba_stream * - the created stream, or NULL if flags contain
+ * 	RANDOM_STATE or if the allocation failed
+ */
+IMPORTANT_RETURN struct rba_stream * rba_create_stream(
+	uint64_t seed,
+	enum rba_option flags);
+
+
+/**
+ * Destroys an endless scramble sequence
+ *
+ * @param stream - the stream to destroy, may be NULL
+ */
+void rba_destroy_stream(struct rba_stream * stream);
+
+
+/**
+ * Generates the next move of the sequence
+ *
+ * @param stream - the stream to generate from
+ *
+ * @return rba_move_code - the code of the next move
+ */
+rba_move_code rba_stream_next_move(struct rba_stream * stream);
+
+
+/**
+ * Writes the next moves of the sequence in the given buffer, using
+ * singmaster notation, each move is followed by a separating space so
+ * successive chunks can be concatenated
+ * The buffer is not NULL-terminated, at most 2 bytes are left unused
+ *
+ * @param stream - the stream to generate from
+ *
+ * @param buffer - the buffer to write the moves to
+ *
+ * @param capacity - the size of the buffer
+ *
+ * @return size_t - the number of writen bytes
+ */
+size_t rba_stream_fill(
+	struct rba_stream * stream,
+	char * buffer,
+	size_t capacity);
+
+
+
+
+/**
+ * Generates a scramble sequence of an NxN cube as move codes, guaranteed to
+ * contain no more than 1 move per axis
+ * Blocks of 1 to N / 2 outer layers are turned, the block of half an even
+ * cube only from U, R and F, every move costs a single random draw whatever
+ * the size
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param size - the number of layers of the cube, MIN_NXN_SIZE to
+ * 	MAX_NXN_SIZE
+ *
+ * @param moves - the buffer to write the codes to, at least [length] long
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return size_t - the number of generated moves, 0 if length is 0 or the
+ * 	size is not supported
+ */
+size_t rba_generate_nxn_scramble_moves_r(
+	struct rba_context * context,
+	size_t size,
+	rba_nxn_move_code * moves,
+	size_t length);
+
+
+/**
+ * Computes the size of a buffer large enough to store any NxN scramble of
+ * the given length, NULL-terminating byte included
+ *
+ * @param length - the length of the sequence to store
+ *
+ * @return size_t - the required buffer size, or 0 if length is 0
+ */
+size_t rba_compute_nxn_scramble_buffer_size(size_t length);
+
+
+/**
+ * Generates a scramble sequence of an NxN cube in the given buffer, using
+ * WCA notation, eg. [3Rw' U2 Fw], see rba_generate_nxn_scramble_moves_r()
+ * No allocation is made, the caller owns the buffer
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param size - the number of layers of the cube, MIN_NXN_SIZE to
+ * 	MAX_NXN_SIZE
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_nxn_scramble_buffer_size()
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0, the size is not supported
+ * 	or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_nxn_scramble_into_r(
+	struct rba_context * context,
+	size_t size,
+	char * buffer,
+	size_t capacity,
+	size_t length);
+
+
+/**
+ * Generates a scramble sequence of an NxN cube, using WCA notation, see
+ * rba_generate_nxn_scramble_into_r()
+ * The caller is in charge of the memory
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param size - the number of layers of the cube, MIN_NXN_SIZE to
+ * 	MAX_NXN_SIZE
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return char * - the generated sequence, or NULL if length is 0, the size
+ * 	is not supported or the allocation failed
+ */
+IMPORTANT_RETURN char * rba_generate_nxn_scramble_r(
+	struct rba_context * context,
+	size_t size,
+	size_t length);
+
+
+/**
+ * Writes NxN move codes as a scramble sequence, using WCA notation
+ *
+ * @param moves - the codes of the moves to write
+ *
+ * @param count - the number of moves to write
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_nxn_scramble_buffer_size()
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if count is 0, a code is invalid or the
+ * 	buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_write_nxn_move_codes(
+	rba_nxn_move_code const * moves,
+	size_t count,
+	char * buffer,
+	size_t capacity);
+
+
+
+
+/**
+ * Compiles scramble rules to a finite automaton, each state listing the moves
+ * which can follow and the state each of them leads to, so every move of a
+ * constrained scramble costs a single random draw whatever the rules
+ * The caller is in charge of the memory, see rba_destroy_scramble_automaton()
+ *
+ * @param rules - the rules to follow
+ *
+ * @param flags - USE_WIDE_MOVES to generate wide moves, POCKET_CUBE to only
+ * 	generate R, U and F moves
+ *
+ * @return struct rba_scramble_automaton * - the compiled automaton, or NULL
+ * 	if the rules are invalid or the allocation failed
+ */
+IMPORTANT_RETURN struct rba_scramble_automaton * rba_compile_scramble_rules(
+	struct rba_scramble_rules const * rules,
+	enum rba_option flags);
+
+
+/**
+ * Destroys a compiled automaton
+ *
+ * @param automaton - the automaton to destroy, may be NULL
+ */
+void rba_destroy_scramble_automaton(struct rba_scramble_automaton * automaton);
+
+
+/**
+ * Sets the weights of the moves of an automaton, eg. to favor half turns or
+ * avoid slice moves, each move being drawn in proportion to its weight among
+ * the legal ones
+ * The weights are compiled to an alias table per state, so a weighted move
+ * still costs a single random draw
+ *
+ * @param automaton - the automaton to weight
+ *
+ * @param weights - the weight of each move, indexed by code, MOVE_CODES_COUNT
+ * 	finite and positive or zero values, or NULL to draw every legal move
+ * 	with the same probability again
+ *
+ * @return int - 1 if the weights were set, 0 if a weight is invalid, some
+ * 	state has no legal move with a weight, or the allocation failed, the
+ * 	previous weights being kept
+ */
+IMPORTANT_RETURN int rba_weight_scramble_moves(
+	struct rba_scramble_automaton * automaton,
+	double const * weights);
+
+
+/**
+ * Generates a scramble sequence following the rules of an automaton, as move
+ * codes, each move being drawn according to the weights of the automaton if
+ * any, see rba_weight_scramble_moves()
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param automaton - the compiled rules to follow
+ *
+ * @param moves - the buffer to write the codes to, at least [length] long
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return size_t - the number of generated moves
+ */
+size_t rba_generate_constrained_moves_r(
+	struct rba_context * context,
+	struct rba_scramble_automaton const * automaton,
+	rba_move_code * moves,
+	size_t length);
+
+
+/**
+ * Generates a scramble sequence following the rules of an automaton in the
+ * given buffer, using singmaster notation
+ * No allocation is made, the caller owns the buffer
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param automaton - the compiled rules to follow
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_scramble_buffer_size() with the flags of the automaton
+ *
+ * @param length - the length of the sequence to generate
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0 or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_constrained_scramble_into_r(
+	struct rba_context * context,
+	struct rba_scramble_automaton const * automaton,
+	char * buffer,
+	size_t capacity,
+	size_t length);
+
+
+/**
+ * Prepares the uniform sampling of the sequences of an automaton: constrained
+ * scrambles pick each move among the legal ones, so moves leading to states
+ * with fewer legal moves start sequences more likely than others, the
+ * sampler draws each move in proportion to the number of sequences it starts
+ * instead, the weights of the automaton are ignored
+ * The number of sequences of each length starting at each state is computed
+ * once, normalized in floating point, up to the maximum length or until its
+ * ratios converge, and every move is then drawn from an alias table in
+ * constant time
+ * The caller is in charge of the memory, see rba_destroy_uniform_sampler()
+ *
+ * @param automaton - the automaton to sample, it must outlive the sampler
+ *
+ * @param max_length - the length of the longest sequences to draw, the
+ * 	tables of at most this many lengths are kept
+ *
+ * @return struct rba_uniform_sampler * - the created sampler, or NULL if
+ * 	max_length is 0 or the allocation failed
+ */
+IMPORTANT_RETURN struct rba_uniform_sampler * rba_create_uniform_sampler(
+	struct rba_scramble_automaton const * automaton,
+	size_t max_length);
+
+
+/**
+ * Destroys a uniform sampler
+ *
+ * @param sampler - the sampler to destroy, may be NULL
+ */
+void rba_destroy_uniform_sampler(struct rba_uniform_sampler * sampler);
+
+
+/**
+ * Generates a scramble sequence of an automaton as move codes, every
+ * sequence of the given length being equally likely
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param sampler - the sampler of the automaton
+ *
+ * @param moves - the buffer to write the codes to, at least [length] long
+ *
+ * @param length - the length of the sequence to generate, at most the
+ * 	maximum length of the sampler
+ *
+ * @return size_t - the number of generated moves, 0 if length exceeds the
+ * 	maximum length of the sampler
+ */
+size_t rba_generate_uniform_moves_r(
+	struct rba_context * context,
+	struct rba_uniform_sampler const * sampler,
+	rba_move_code * moves,
+	size_t length);
+
+
+/**
+ * Generates a scramble sequence of an automaton in the given buffer, using
+ * singmaster notation, see rba_generate_uniform_moves_r()
+ * No allocation is made, the caller owns the buffer
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param sampler - the sampler of the automaton
+ *
+ * @param buffer - the buffer to write the NULL-terminated sequence to
+ *
+ * @param capacity - the size of the buffer, see
+ * 	rba_compute_scramble_buffer_size() with the flags of the automaton
+ *
+ * @param length - the length of the sequence to generate, at most the
+ * 	maximum length of the sampler
+ *
+ * @return size_t - the length of the writen sequence, without
+ * 	NULL-terminating byte, or 0 if length is 0, exceeds the maximum length of
+ * 	the sampler or the buffer is too small
+ */
+IMPORTANT_RETURN size_t rba_generate_uniform_scramble_into_r(
+	struct rba_context * context,
+	struct rba_uniform_sampler const * sampler,
+	char * buffer,
+	size_t capacity,
+	size_t length);
+
+
+
+
+
+/**
+ * Puts a cube in its solved state
+ *
+ * @param cube - the cube to reset
+ */
+void rba_init_cube(struct rba_cube * cube);
+
+
+/**
+ * Applies a sequence of moves to a cube
+ *
+ * @param cube - the cube to turn
+ *
+ * @param moves - the codes of the moves to apply, in order
+ *
+ * @param count - the number of moves to apply
+ *
+ * @return size_t - the number of applied moves, or 0 if a code is invalid,
+ * 	the cube is then left untouched
+ */
+size_t rba_apply_moves(
+	struct rba_cube * cube,
+	rba_move_code const * moves,
+	size_t count);
+
+
+/**
+ * Tells whether each face of a cube has a single color
+ *
+ * @param cube - the cube to check
+ *
+ * @return int - 1 if the cube is solved, 0 otherwise
+ */
+int rba_is_cube_solved(struct rba_cube const * cube);
+
+
+/**
+ * Puts a bitboard cube in its solved state
+ *
+ * @param cube - the cube to reset
+ */
+void rba_init_bitboard_cube(struct rba_bitboard_cube * cube);
+
+
+/**
+ * Packs the stickers of a cube in a bitboard cube
+ *
+ * @param cube - the cube to pack, its colors must be rba_face values
+ *
+ * @param bitboard_cube - the packed cube, output
+ */
+void rba_pack_cube(struct rba_cube const * cube, struct rba_bitboard_cube * bitboard_cube);
+
+
+/**
+ * Unpacks the stickers of a bitboard cube
+ *
+ * @param bitboard_cube - the cube to unpack
+ *
+ * @param cube - the unpacked cube, output
+ */
+void rba_unpack_cube(struct rba_bitboard_cube const * bitboard_cube, struct rba_cube * cube);
+
+
+/**
+ * Applies a sequence of moves to a bitboard cube, the outer stickers of a
+ * turned face are rotated within its word and the strips of the adjacent
+ * faces are moved with masks and rotations, every face at once with AVX2
+ *
+ * @param cube - the cube to turn
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ *
+ * @return size_t - the number of applied moves, or 0 if a code is invalid,
+ * 	the cube is then left untouched
+ */
+size_t rba_apply_bitboard_moves(
+	struct rba_bitboard_cube * cube,
+	rba_move_code const * moves,
+	size_t count);
+
+
+/**
+ * Tells whether each face of a bitboard cube has a single color
+ *
+ * @param cube - the cube to check
+ *
+ * @return int - 1 if the cube is solved, 0 otherwise
+ */
+int rba_is_bitboard_cube_solved(struct rba_bitboard_cube const * cube);
+
+
+/**
+ * Tells whether 2 bitboard cubes have the same stickers
+ *
+ * @param cube - the first cube
+ *
+ * @param other_cube - the second cube
+ *
+ * @return int - 1 if the cubes are the same, 0 otherwise
+ */
+int rba_are_bitboard_cubes_equal(
+	struct rba_bitboard_cube const * cube,
+	struct rba_bitboard_cube const * other_cube);
+
+
+/**
+ * Hashes the stickers of a bitboard cube, for hash sets of states
+ *
+ * @param cube - the cube to hash
+ *
+ * @return uint64_t - the hash, the same for equal cubes
+ */
+uint64_t rba_hash_bitboard_cube(struct rba_bitboard_cube const * cube);
+
+
+/**
+ * Creates a batch of solved cubes, stored as structure of arrays: sticker i
+ * of every cube is contiguous
+ * The caller is in charge of the memory, see rba_destroy_cube_batch()
+ *
+ * @param count - the number of cubes of the batch
+ *
+ * @return struct rba_cube_batch * - the created batch, or NULL if the
+ * 	allocation failed
+ */
+IMPORTANT_RETURN struct rba_cube_batch * rba_create_cube_batch(size_t count);
+
+
+/**
+ * Destroys a batch of cubes
+ *
+ * @param batch - the batch to destroy, may be NULL
+ */
+void rba_destroy_cube_batch(struct rba_cube_batch * batch);
+
+
+/**
+ * Puts every cube of a batch in its solved state
+ *
+ * @param batch - the batch to reset
+ */
+void rba_init_cube_batch(struct rba_cube_batch * batch);
+
+
+/**
+ * Copies the stickers of a cube into a batch
+ *
+ * @param batch - the batch to write to
+ *
+ * @param index - the index of the cube in the batch
+ *
+ * @param cube - the cube to copy
+ */
+void rba_set_batch_cube(
+	struct rba_cube_batch * batch,
+	size_t index,
+	struct rba_cube const * cube);
+
+
+/**
+ * Copies the stickers of a cube out of a batch
+ *
+ * @param batch - the batch to read from
+ *
+ * @param index - the index of the cube in the batch
+ *
+ * @param cube - the copied cube, output
+ */
+void rba_get_batch_cube(
+	struct rba_cube_batch const * batch,
+	size_t index,
+	struct rba_cube * cube);
+
+
+/**
+ * Applies the same sequence of moves to every cube of a batch
+ * The sequence is composed into a single permutation first, so the stickers
+ * are moved once whatever its length
+ *
+ * @param batch - the cubes to turn
+ *
+ * @param moves - the codes of the moves to apply, in order
+ *
+ * @param count - the number of moves to apply
+ *
+ * @return size_t - the number of applied moves, or 0 if a code is invalid,
+ * 	the cubes are then left untouched
+ */
+size_t rba_apply_batch_moves(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count);
+
+
+/**
+ * Applies its own sequence of moves to each cube of a batch, the sequences
+ * all have the same length
+ * With AVX-512 the k-th moves of 64 cubes are applied together, the stickers
+ * of the layers each cube turns being moved under masks, otherwise the cubes
+ * are turned one at a time
+ *
+ * @param batch - the cubes to turn
+ *
+ * @param moves - the codes of the moves to apply, the sequence of cube i
+ * 	starting at moves + i * count
+ *
+ * @param count - the number of moves to apply to each cube
+ *
+ * @return size_t - the number of moves applied to each cube, or 0 if a code
+ * 	is invalid, the cubes are then left untouched
+ */
+size_t rba_apply_batch_lane_moves(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count);
+
+
+/**
+ * Counts the cubes of a batch whose faces each have a single color
+ *
+ * @param batch - the cubes to check
+ *
+ * @return size_t - the number of solved cubes
+ */
+size_t rba_count_solved_batch_cubes(struct rba_cube_batch const * batch);
+
+
+/**
+ * Finds a sequence of face moves solving a cube, with the two-phase
+ * algorithm, the solution isn't necessarily the shortest one
+ * The colors are read relative to the centers, so cubes turned with slice or
+ * wide moves are solved as well
+ * The tables of the solver are built on the first call
+ *
+ * @param cube - the cube to solve
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param max_length - the maximum number of moves of the solution, and the
+ * 	number of codes the buffer can store, solving is fast from
+ * 	RANDOM_STATE_MIN_LENGTH moves
+ *
+ * @return size_t - the number of moves of the solution, or 0 if the cube is
+ * 	solved, invalid, or has no solution of at most max_length moves
+ */
+size_t rba_solve_cube(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length);
+
+
+/**
+ * Finds the same solution as rba_solve_cube() with several threads, the
+ * first moves of the search being split between them, to bound the latency
+ * of slow solves
+ *
+ * @param cube - the cube to solve
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param max_length - the maximum number of moves of the solution, and the
+ * 	number of codes the buffer can store
+ *
+ * @param threads_count - the number of threads searching, 0 for 1 per
+ * 	processor
+ *
+ * @return size_t - the number of moves of the solution, or 0 if the cube is
+ * 	solved, invalid, or has no solution of at most max_length moves
+ */
+size_t rba_solve_cube_parallel(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length,
+	size_t threads_count);
+
+
+/**
+ * Finds a shortest sequence of U, R and F moves solving the corners of a
+ * cube, as a 2x2x2 cube, in a few table lookups per move
+ * A 2x2x2 cube has no centers, the colors are read relative to the D-B-L
+ * corner, so the corners are solved up to a rotation of the whole cube, the
+ * other stickers are ignored
+ * The tables of the solver are built on the first call
+ *
+ * @param cube - the cube whose corners to solve
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param max_length - the maximum number of moves of the solution, and the
+ * 	number of codes the buffer can store, POCKET_MAX_LENGTH is always enough
+ *
+ * @return size_t - the number of moves of the solution, or 0 if the corners
+ * 	are solved, invalid, or need more than max_length moves
+ */
+size_t rba_solve_pocket_cube(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length);
+
+
+/**
+ * Builds the tables of the solver, unless they were already built or loaded,
+ * instead of letting the first solve or random state scramble build them
+ * The pruning tables are filled by several threads, the tables are the same
+ * whatever their number
+ *
+ * @param threads_count - the number of threads, 0 for 1 per processor
+ *
+ * @return enum rba_tables_status - TABLES_OK, or TABLES_OUT_OF_MEMORY
+ */
+IMPORTANT_RETURN enum rba_tables_status rba_build_solver_tables(size_t threads_count);
+
+
+/**
+ * Builds the tables of the solver, unless they were already built or
+ * loaded, and writes them to a file, to be loaded by later processes instead
+ * of being built again
+ * The file is tagged with the version of its format and the byte order of
+ * the machine, and checksummed, it is written under a temporary name then
+ * renamed, so it is never seen partially written
+ *
+ * @param path - the path of the file to write
+ *
+ * @return enum rba_tables_status - TABLES_OK, TABLES_OUT_OF_MEMORY or
+ * 	TABLES_IO_ERROR
+ */
+IMPORTANT_RETURN enum rba_tables_status rba_save_solver_tables(char const * path);
+
+
+/**
+ * Maps a file written by rba_save_solver_tables() read-only in memory, the
+ * solver then uses it instead of building its tables, processes mapping the
+ * same file share its pages
+ * Must be called before the first solve or random state scramble, the file
+ * stays mapped until the process exits
+ *
+ * @param path - the path of the file to load
+ *
+ * @param verify_checksum - whether to check the content of the file, which
+ * 	reads all of it, otherwise only its header is checked and its pages are
+ * 	read on demand
+ *
+ * @return enum rba_tables_status - TABLES_OK if the solver uses tables,
+ * 	the loaded ones or the ones already built or loaded, an error otherwise
+ */
+IMPORTANT_RETURN enum rba_tables_status rba_load_solver_tables(char const * path, int verify_checksum);
+
+
+/**
+ * Computes the coordinates of a cube, with O(n) ranking of its permutations
+ * The colors are read relative to the centers, as the solver does
+ *
+ * @param cube - the cube to read
+ *
+ * @param coordinates - the coordinates, output
+ *
+ * @return int - 1 if the cube is a reachable state, 0 otherwise
+ */
+int rba_get_coordinates(struct rba_cube const * cube, struct rba_coordinates * coordinates);
+
+
+/**
+ * Builds a cube having the given coordinates, the edges outside of the UD
+ * slice are put in order, but 2 of them may be swapped so the state is
+ * reachable
+ *
+ * @param coordinates - the coordinates of the cube
+ *
+ * @param cube - the built cube, output
+ *
+ * @return int - 1 if the cube was built, 0 if a coordinate is out of range
+ */
+int rba_set_coordinates(struct rba_coordinates const * coordinates, struct rba_cube * cube);
+
+
+/**
+ * Applies a sequence of face moves to coordinates, a table lookup per
+ * coordinate and move, the state is never computed from scratch
+ * The move tables are those of the solver, built on the first call unless
+ * they were loaded, see rba_load_solver_tables()
+ *
+ * @param coordinates - the coordinates to move
+ *
+ * @param moves - the codes of the moves to apply, quarter, half or reverse
+ * 	turns of the 6 faces
+ *
+ * @param count - the number of moves to apply
+ *
+ * @return size_t - the number of applied moves, or 0 if a code isn't a face
+ * 	move or the tables couldn't be allocated, the coordinates are then left
+ * 	untouched
+ */
+size_t rba_move_coordinates(
+	struct rba_coordinates * coordinates,
+	rba_move_code const * moves,
+	size_t count);
 
 
 #ifdef __cplusplus
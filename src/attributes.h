@@ -4,8 +4,14 @@
 
 #if defined(__clang__) /* CLANG */
 #	define IMPORTANT_RETURN __attribute__ ((warn_unused_result))
+#	define INLINE __inline__
+#	define CONSTRUCTOR __attribute__ ((constructor))
+#	define TARGET(features) __attribute__ ((target(features)))
 #elif defined(__GNUC__) || defined(__GNUG__) /* GCC */
 #	define IMPORTANT_RETURN __attribute__ ((warn_unused_result))
+#	define INLINE __inline__
+#	define CONSTRUCTOR __attribute__ ((constructor))
+#	define TARGET(features) __attribute__ ((target(features)))
 #elif defined(_MSC_VER) /* MSVC */
 #	error "Visibility not implemented for MSVC"
 #elif defined(__MINGW32__) /* MinGW */
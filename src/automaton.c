@@ -0,0 +1,960 @@
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "random.h"
+#include "moves.h"
+#include "notation.h"
+#include "scramble.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of layers of an axis, and the masks of their layers: bit 0 for
+ * L, U and F, bit 1 for M, E and S, bit 2 for R, D and B
+ */
+#define AXIS_LAYERS_COUNT 3
+#define AXIS_LAYERS_MASKS_COUNT (1 << AXIS_LAYERS_COUNT)
+#define SLICE_LAYERS_MASK 0x2
+
+
+/**
+ * The number of rows the axis of the current run can take: none, then X, Y
+ * and Z
+ */
+#define AXIS_ROWS_COUNT 4
+
+
+/**
+ * The shift of the bits of the layers of the X axis in rba_move, those of Y
+ * and Z follow
+ */
+#define LAYERS_SHIFT 5
+
+
+/**
+ * The number of values the state of an automaton can take before being
+ * compiled: the axis of the current run, its layers, its length, and the
+ * number of moves since the last slice move
+ */
+#define STATE_KEYS_COUNT \
+	(AXIS_ROWS_COUNT * AXIS_LAYERS_MASKS_COUNT * (AXIS_LAYERS_COUNT + 1) * (MAX_SLICE_SPACING + 1))
+
+
+/**
+ * Marks a state key not reached yet
+ */
+#define NO_STATE 0xFFFF
+
+
+/**
+ * The number of remaining lengths the tables of a uniform sampler are first
+ * allocated for
+ */
+#define INITIAL_SAMPLED_LENGTHS 16
+
+
+/**
+ * The largest change of a normalized sequence count between 2 lengths for
+ * the counts to be considered converged, far below the resolution of the
+ * alias tables
+ */
+#define CONVERGENCE_TOLERANCE 1e-12
+
+
+/**
+ * 2^32, scales a probability to a 32 bits threshold
+ */
+#define THRESHOLD_SCALE 4294967296.0
+
+
+
+
+/**
+ * A state of a compiled automaton, the moves which can follow the moves
+ * leading to it, and where each of them leads
+ */
+struct rba_automaton_state
+{
+	/**
+	 * The number of legal moves
+	 */
+	uint32_t count;
+
+	/**
+	 * The codes of the legal moves, by increasing code
+	 */
+	rba_move_code moves[MOVE_CODES_COUNT];
+
+	/**
+	 * The state reached by each legal move
+	 */
+	uint16_t next_states[MOVE_CODES_COUNT];
+};
+
+
+/**
+ * The finite automaton accepting the sequences following a set of rules,
+ * the first state is the one before any move
+ */
+struct rba_scramble_automaton
+{
+	/**
+	 * The number of states
+	 */
+	size_t states_count;
+
+	/**
+	 * The states, in the allocation of the automaton
+	 */
+	struct rba_automaton_state * states;
+
+	/**
+	 * The alias tables of the weights of the legal moves of each state, NULL
+	 * when every legal move is equally likely
+	 */
+	struct rba_alias_table * weighted_tables;
+};
+
+
+/**
+ * An entry of Walker's alias table: a legal move, and the move taken instead
+ * when the coin is over its threshold, both resolved to their code and the
+ * state they lead to
+ */
+struct rba_alias_entry
+{
+	/**
+	 * The coin under which the move is kept, rather than its alias, scaled to
+	 * 2^32
+	 */
+	uint32_t threshold;
+
+	/**
+	 * The state reached by the move, then by its alias, on 32 bits so an
+	 * entry takes 16 bytes and is found with a shift
+	 */
+	uint32_t next_states[2];
+
+	/**
+	 * The code of the move, then of its alias
+	 */
+	rba_move_code moves[2];
+};
+
+
+/**
+ * Walker's alias table of the legal moves of a state, a move is drawn with an
+ * index and a coin whatever the distribution
+ */
+struct rba_alias_table
+{
+	/**
+	 * The number of legal moves
+	 */
+	uint32_t count;
+
+	/**
+	 * The entry of each legal move
+	 */
+	struct rba_alias_entry entries[MOVE_CODES_COUNT];
+};
+
+
+/**
+ * Draws sequences of an automaton with every sequence of a given length
+ * equally likely, each move being drawn in proportion to the number of
+ * sequences it starts
+ */
+struct rba_uniform_sampler
+{
+	/**
+	 * The states of the sampled automaton
+	 */
+	struct rba_automaton_state const * states;
+
+	/**
+	 * The number of states of the sampled automaton
+	 */
+	size_t states_count;
+
+	/**
+	 * The length of the longest sequences the sampler draws
+	 */
+	size_t max_length;
+
+	/**
+	 * The number of remaining lengths with their own tables, once the counts
+	 * have converged the last tables serve every longer length
+	 */
+	size_t lengths_count;
+
+	/**
+	 * The alias tables of each state, for each number of remaining moves, 1
+	 * move at tables[0 .. states_count[, in the allocation of the sampler
+	 */
+	struct rba_alias_table * tables;
+};
+
+
+/**
+ * A state of an automaton being compiled, as the facts the rules look at
+ */
+struct rba_state_key
+{
+	/**
+	 * The axis of the current run of moves, 0 before any move, 1 to 3 for X,
+	 * Y and Z
+	 */
+	size_t axis_row;
+
+	/**
+	 * The layers turned by the current run
+	 */
+	unsigned int layers;
+
+	/**
+	 * The number of moves of the current run
+	 */
+	unsigned int run_length;
+
+	/**
+	 * The number of moves since the last slice move, at most the spacing of
+	 * the rules
+	 */
+	unsigned int since_slice;
+};
+
+
+
+
+/**
+ * Encodes a state as an index in the state keys
+ *
+ * @param key - the state to encode
+ *
+ * @return - the index, less than STATE_KEYS_COUNT
+ */
+static size_t rba_encode_state_key(struct rba_state_key const * key)
+{
+	return ((key->axis_row * AXIS_LAYERS_MASKS_COUNT + key->layers) * (AXIS_LAYERS_COUNT + 1) + key->run_length)
+		* (MAX_SLICE_SPACING + 1) + key->since_slice;
+}
+
+
+/**
+ * Decodes a state from its index in the state keys
+ *
+ * @param index - the index to decode
+ *
+ * @param key - the state, output
+ */
+static void rba_decode_state_key(size_t index, struct rba_state_key * key)
+{
+	key->since_slice = (unsigned int) (index % (MAX_SLICE_SPACING + 1));
+	index /= MAX_SLICE_SPACING + 1;
+	key->run_length = (unsigned int) (index % (AXIS_LAYERS_COUNT + 1));
+	index /= AXIS_LAYERS_COUNT + 1;
+	key->layers = (unsigned int) (index % AXIS_LAYERS_MASKS_COUNT);
+	key->axis_row = index / AXIS_LAYERS_MASKS_COUNT;
+}
+
+
+/**
+ * Applies the rules to a move following a state
+ *
+ * @param rules - the rules to follow
+ *
+ * @param key - the state the move follows
+ *
+ * @param move - the code of the move
+ *
+ * @param next_key - the state the move leads to, output
+ *
+ * @return - 1 if the move is legal, 0 otherwise
+ */
+static int rba_follow_rules(
+	struct rba_scramble_rules const * rules,
+	struct rba_state_key const * key,
+	rba_move_code move,
+	struct rba_state_key * next_key)
+{
+	rba_move decoded_move = rba_moves_by_code[move];
+	enum rba_axis axis = decoded_move & AXIS_MASK;
+	/* 0x4, 0x8, 0x10 become 1, 2, 4, then Z_AXIS is moved to 3 */
+	size_t axis_row = (axis >> 2) - (axis >> 4);
+	unsigned int layers = (decoded_move >> (LAYERS_SHIFT + AXIS_LAYERS_COUNT * (axis_row - 1)))
+		& (AXIS_LAYERS_MASKS_COUNT - 1);
+
+	if (axis_row != key->axis_row)
+	{
+		next_key->layers = layers;
+		next_key->run_length = 1;
+	}
+	else
+	{
+		/* a layer turned again in a run is redundant, [R L R] is [R2 L] */
+		if ((key->run_length >= rules->max_axis_run) || (key->layers & layers))
+			return 0;
+		/* the moves of a run commute, a single order is kept */
+		if (rules->ordered_axis_runs && (layers < key->layers))
+			return 0;
+
+		next_key->layers = key->layers | layers;
+		next_key->run_length = key->run_length + 1;
+	}
+	next_key->axis_row = axis_row;
+
+	if (layers == SLICE_LAYERS_MASK)
+	{
+		if (key->since_slice < rules->slice_spacing)
+			return 0;
+
+		next_key->since_slice = 0;
+	}
+	else
+		next_key->since_slice = (key->since_slice < rules->slice_spacing) ? key->since_slice + 1 : key->since_slice;
+
+	return 1;
+}
+
+
+/**
+ * Lists the codes of the moves the automaton is built with
+ *
+ * @param flags - USE_WIDE_MOVES to include wide moves, POCKET_CUBE to only
+ * 	include R, U and F moves
+ *
+ * @param moves - the codes of the moves, by increasing code, output
+ *
+ * @return - the number of moves
+ */
+static size_t rba_list_automaton_moves(enum rba_option flags, rba_move_code moves[])
+{
+	rba_move_code const pocket_moves[] =
+	{
+		LAYER_CODES(RIGHT_LAYER_INDEX), LAYER_CODES(TOP_LAYER_INDEX), LAYER_CODES(FRONT_LAYER_INDEX)
+	};
+	size_t count = (flags & USE_WIDE_MOVES) ? MOVE_CODES_COUNT : BASE_MOVE_CODES_COUNT;
+	size_t index;
+
+	if (flags & POCKET_CUBE)
+	{
+		memcpy(moves, pocket_moves, sizeof(pocket_moves));
+		return sizeof(pocket_moves) / sizeof(* pocket_moves);
+	}
+
+	for (index = 0; index < count; index++)
+		moves[index] = (rba_move_code) index;
+
+	return count;
+}
+
+
+/**
+ * Builds Walker's alias table of the legal moves of a state, with Vose's
+ * method
+ *
+ * @param probabilities - the probability of each legal move, summing to 1,
+ * 	used as working memory
+ *
+ * @param legal_moves - the state the moves follow
+ *
+ * @param table - the table to fill
+ */
+static void rba_build_alias_table(
+	double probabilities[],
+	struct rba_automaton_state const * legal_moves,
+	struct rba_alias_table * table)
+{
+	uint32_t thresholds[MOVE_CODES_COUNT];
+	uint8_t aliases[MOVE_CODES_COUNT];
+	uint8_t small_indexes[MOVE_CODES_COUNT];
+	uint8_t large_indexes[MOVE_CODES_COUNT];
+	size_t count = legal_moves->count;
+	size_t small_count = 0;
+	size_t large_count = 0;
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		probabilities[index] *= (double) count;
+		if (probabilities[index] < 1.0)
+			small_indexes[small_count++] = (uint8_t) index;
+		else
+			large_indexes[large_count++] = (uint8_t) index;
+	}
+
+	/* each small index is topped up by a large one */
+	while ((small_count > 0) && (large_count > 0))
+	{
+		uint8_t small_index = small_indexes[--small_count];
+		uint8_t large_index = large_indexes[--large_count];
+
+		thresholds[small_index] = (uint32_t) (probabilities[small_index] * THRESHOLD_SCALE);
+		aliases[small_index] = large_index;
+
+		probabilities[large_index] -= 1.0 - probabilities[small_index];
+		if (probabilities[large_index] < 1.0)
+			small_indexes[small_count++] = large_index;
+		else
+			large_indexes[large_count++] = large_index;
+	}
+
+	/* the remaining ones are full, up to rounding errors */
+	while (large_count > 0)
+	{
+		uint8_t large_index = large_indexes[--large_count];
+
+		thresholds[large_index] = 0xFFFFFFFF;
+		aliases[large_index] = large_index;
+	}
+	while (small_count > 0)
+	{
+		uint8_t small_index = small_indexes[--small_count];
+
+		thresholds[small_index] = 0xFFFFFFFF;
+		aliases[small_index] = small_index;
+	}
+
+	/* the aliases are resolved, so a draw reads a single entry */
+	table->count = (uint32_t) count;
+	for (index = 0; index < count; index++)
+	{
+		struct rba_alias_entry * entry = table->entries + index;
+
+		entry->threshold = thresholds[index];
+		entry->moves[0] = legal_moves->moves[index];
+		entry->next_states[0] = legal_moves->next_states[index];
+		entry->moves[1] = legal_moves->moves[aliases[index]];
+		entry->next_states[1] = legal_moves->next_states[aliases[index]];
+	}
+}
+
+
+/**
+ * Draws a move from Walker's alias table, with a single random draw
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param table - the table to draw from
+ *
+ * @param move - the code of the drawn move, output
+ *
+ * @return - the state reached by the drawn move
+ */
+static size_t rba_draw_alias(
+	struct rba_context * context,
+	struct rba_alias_table const * table,
+	rba_move_code * move)
+{
+	uint64_t scaled = (uint64_t) rba_next_random(context) * table->count;
+	struct rba_alias_entry const * entry = table->entries + (scaled >> 32);
+	/* the low bits of the scaled draw are the coin, they cover 2^32 by steps
+	of count, far finer than any useful weight */
+	uint32_t alias_mask = 0u - (uint32_t) ((uint32_t) scaled >= entry->threshold);
+	uint32_t next_state = entry->next_states[0];
+	uint32_t drawn_move = entry->moves[0];
+
+	/* both sides are read before the coin is known, so it selects them with
+	a mask rather than a branch it would make unpredictable */
+	next_state ^= (next_state ^ entry->next_states[1]) & alias_mask;
+	drawn_move ^= (drawn_move ^ entry->moves[1]) & alias_mask;
+	* move = (rba_move_code) drawn_move;
+
+	return next_state;
+}
+
+
+/**
+ * Generates moves walking an automaton, a single random draw per move, from
+ * the alias tables of the weights of the moves if they are set
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param automaton - the automaton to walk
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param count - the number of moves to generate
+ *
+ * @param state - the state to start from, the state reached when done
+ */
+static void rba_walk_automaton(
+	struct rba_context * context,
+	struct rba_scramble_automaton const * automaton,
+	rba_move_code moves[],
+	size_t count,
+	size_t * state)
+{
+	struct rba_automaton_state const * states = automaton->states;
+	struct rba_alias_table const * tables = automaton->weighted_tables;
+	size_t current_state = * state;
+	size_t index;
+
+	if (tables != NULL)
+	{
+		for (index = 0; index < count; index++)
+			current_state = rba_draw_alias(context, tables + current_state, moves + index);
+	}
+	else
+	{
+		for (index = 0; index < count; index++)
+		{
+			struct rba_automaton_state const * legal_moves = states + current_state;
+			uint32_t move = rba_random_index(context, legal_moves->count);
+
+			moves[index] = legal_moves->moves[move];
+			current_state = legal_moves->next_states[move];
+		}
+	}
+
+	* state = current_state;
+}
+
+
+/**
+ * Fills the alias tables of the next remaining length of a uniform sampler
+ *
+ * @param sampler - the sampler to fill
+ *
+ * @param counts - the normalized number of sequences starting at each state,
+ * 	one move shorter
+ *
+ * @param next_counts - the normalized number of sequences of the filled
+ * 	length starting at each state, output
+ *
+ * @return - 1 if the counts have converged, 0 otherwise
+ */
+static int rba_fill_uniform_tables(
+	struct rba_uniform_sampler * sampler,
+	double const counts[],
+	double next_counts[])
+{
+	struct rba_alias_table * tables = sampler->tables + sampler->lengths_count * sampler->states_count;
+	double largest_count = 0.0;
+	int converged = 1;
+	size_t state;
+
+	for (state = 0; state < sampler->states_count; state++)
+	{
+		struct rba_automaton_state const * legal_moves = sampler->states + state;
+		double probabilities[MOVE_CODES_COUNT];
+		double sum = 0.0;
+		size_t move;
+
+		for (move = 0; move < legal_moves->count; move++)
+			sum += counts[legal_moves->next_states[move]];
+
+		/* a move is as likely as the sequences it starts */
+		for (move = 0; move < legal_moves->count; move++)
+			probabilities[move] = counts[legal_moves->next_states[move]] / sum;
+
+		rba_build_alias_table(probabilities, legal_moves, tables + state);
+
+		next_counts[state] = sum;
+		if (sum > largest_count)
+			largest_count = sum;
+	}
+
+	/* the counts grow exponentially, only their ratios matter */
+	for (state = 0; state < sampler->states_count; state++)
+	{
+		double change;
+
+		next_counts[state] /= largest_count;
+		change = next_counts[state] - counts[state];
+		if ((change > CONVERGENCE_TOLERANCE) || (change < -CONVERGENCE_TOLERANCE))
+			converged = 0;
+	}
+
+	sampler->lengths_count++;
+
+	return converged;
+}
+
+
+/**
+ * Generates moves of a uniform sampler, every sequence of the remaining
+ * length being equally likely
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param sampler - the sampler to draw from
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param count - the number of moves to generate
+ *
+ * @param remaining_length - the number of moves left in the sequence,
+ * 	[count] included
+ *
+ * @param state - the state to start from, the state reached when done
+ */
+static void rba_walk_uniformly(
+	struct rba_context * context,
+	struct rba_uniform_sampler const * sampler,
+	rba_move_code moves[],
+	size_t count,
+	size_t remaining_length,
+	size_t * state)
+{
+	size_t current_state = * state;
+	size_t index;
+
+	for (index = 0; index < count; index++, remaining_length--)
+	{
+		size_t length = remaining_length < sampler->lengths_count ? remaining_length : sampler->lengths_count;
+		struct rba_alias_table const * table = sampler->tables + (length - 1) * sampler->states_count + current_state;
+
+		current_state = rba_draw_alias(context, table, moves + index);
+	}
+
+	* state = current_state;
+}
+
+
+
+
+struct rba_scramble_automaton * rba_compile_scramble_rules(
+	struct rba_scramble_rules const * rules,
+	enum rba_option flags)
+{
+	rba_move_code moves[MOVE_CODES_COUNT];
+	uint16_t * key_states;
+	size_t * state_keys;
+	struct rba_scramble_automaton * automaton;
+	struct rba_scramble_automaton * shrunk_automaton;
+	struct rba_state_key start_key = { 0, 0, 0, 0 };
+	size_t moves_count = rba_list_automaton_moves(flags, moves);
+	size_t state;
+
+	if ((rules->max_axis_run < 1) || (rules->max_axis_run > AXIS_LAYERS_COUNT)
+		|| (rules->slice_spacing > MAX_SLICE_SPACING))
+		return NULL;
+
+	/* room for every state key, given back once the reached ones are known */
+	automaton = malloc(sizeof(* automaton) + STATE_KEYS_COUNT * sizeof(struct rba_automaton_state));
+	key_states = malloc(STATE_KEYS_COUNT * sizeof(* key_states));
+	state_keys = malloc(STATE_KEYS_COUNT * sizeof(* state_keys));
+	if ((automaton == NULL) || (key_states == NULL) || (state_keys == NULL))
+	{
+		free(automaton);
+		free(key_states);
+		free(state_keys);
+		return NULL;
+	}
+
+	automaton->states = (struct rba_automaton_state *) (automaton + 1);
+	automaton->weighted_tables = NULL;
+	memset(key_states, 0xFF, STATE_KEYS_COUNT * sizeof(* key_states));
+
+	/* a slice move can come first */
+	start_key.since_slice = rules->slice_spacing;
+	state_keys[0] = rba_encode_state_key(& start_key);
+	key_states[state_keys[0]] = 0;
+	automaton->states_count = 1;
+
+	/* the states are numbered as a breadth-first search reaches them */
+	for (state = 0; state < automaton->states_count; state++)
+	{
+		struct rba_automaton_state * automaton_state = automaton->states + state;
+		struct rba_state_key key;
+		size_t move;
+
+		rba_decode_state_key(state_keys[state], & key);
+		automaton_state->count = 0;
+
+		for (move = 0; move < moves_count; move++)
+		{
+			struct rba_state_key next_key;
+			size_t next_index;
+
+			if (! rba_follow_rules(rules, & key, moves[move], & next_key))
+				continue;
+
+			next_index = rba_encode_state_key(& next_key);
+			if (key_states[next_index] == NO_STATE)
+			{
+				key_states[next_index] = (uint16_t) automaton->states_count;
+				state_keys[automaton->states_count++] = next_index;
+			}
+
+			automaton_state->moves[automaton_state->count] = moves[move];
+			automaton_state->next_states[automaton_state->count++] = key_states[next_index];
+		}
+	}
+
+	free(key_states);
+	free(state_keys);
+
+	shrunk_automaton = realloc(automaton, sizeof(* automaton) + automaton->states_count * sizeof(struct rba_automaton_state));
+	if (shrunk_automaton != NULL)
+	{
+		automaton = shrunk_automaton;
+		automaton->states = (struct rba_automaton_state *) (automaton + 1);
+	}
+
+	return automaton;
+}
+
+
+void rba_destroy_scramble_automaton(struct rba_scramble_automaton * automaton)
+{
+	if (automaton != NULL)
+		free(automaton->weighted_tables);
+
+	free(automaton);
+}
+
+
+int rba_weight_scramble_moves(
+	struct rba_scramble_automaton * automaton,
+	double const * weights)
+{
+	struct rba_alias_table * tables;
+	size_t state;
+	size_t code;
+
+	if (weights == NULL)
+	{
+		free(automaton->weighted_tables);
+		automaton->weighted_tables = NULL;
+		return 1;
+	}
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		/* NaN fails the comparison as well */
+		if (! ((weights[code] >= 0.0) && (weights[code] <= DBL_MAX)))
+			return 0;
+	}
+
+	tables = malloc(automaton->states_count * sizeof(* tables));
+	if (tables == NULL)
+		return 0;
+
+	for (state = 0; state < automaton->states_count; state++)
+	{
+		struct rba_automaton_state const * legal_moves = automaton->states + state;
+		double probabilities[MOVE_CODES_COUNT];
+		double sum = 0.0;
+		size_t move;
+
+		for (move = 0; move < legal_moves->count; move++)
+			sum += weights[legal_moves->moves[move]];
+
+		/* the sequences reaching this state couldn't go on, or the weights
+		are too large to be summed */
+		if (! ((sum > 0.0) && (sum <= DBL_MAX)))
+		{
+			free(tables);
+			return 0;
+		}
+
+		for (move = 0; move < legal_moves->count; move++)
+			probabilities[move] = weights[legal_moves->moves[move]] / sum;
+
+		rba_build_alias_table(probabilities, legal_moves, tables + state);
+	}
+
+	free(automaton->weighted_tables);
+	automaton->weighted_tables = tables;
+
+	return 1;
+}
+
+
+size_t rba_generate_constrained_moves_r(
+	struct rba_context * context,
+	struct rba_scramble_automaton const * automaton,
+	rba_move_code * moves,
+	size_t length)
+{
+	size_t state = 0;
+
+	rba_walk_automaton(context, automaton, moves, length, & state);
+
+	return length;
+}
+
+
+size_t rba_generate_constrained_scramble_into_r(
+	struct rba_context * context,
+	struct rba_scramble_automaton const * automaton,
+	char * buffer,
+	size_t capacity,
+	size_t length)
+{
+	rba_move_code moves[MOVES_CHUNK_SIZE];
+	size_t writen_bytes = 0;
+	size_t state = 0;
+
+	if ((length == 0) || (capacity == 0))
+		return 0;
+
+	while (length > 0)
+	{
+		size_t count = length < MOVES_CHUNK_SIZE ? length : MOVES_CHUNK_SIZE;
+		size_t chunk_length;
+
+		rba_walk_automaton(context, automaton, moves, count, & state);
+
+		/* the moves and the separator following the last one */
+		chunk_length = rba_write_moves(moves, count, buffer + writen_bytes, capacity - writen_bytes);
+		if (chunk_length == 0)
+		{
+			* buffer = '\0';
+			return 0;
+		}
+
+		writen_bytes += chunk_length;
+		length -= count;
+	}
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
+}
+
+
+struct rba_uniform_sampler * rba_create_uniform_sampler(
+	struct rba_scramble_automaton const * automaton,
+	size_t max_length)
+{
+	size_t states_count = automaton->states_count;
+	size_t tables_size = states_count * sizeof(struct rba_alias_table);
+	size_t capacity = max_length < INITIAL_SAMPLED_LENGTHS ? max_length : INITIAL_SAMPLED_LENGTHS;
+	struct rba_uniform_sampler * sampler;
+	struct rba_uniform_sampler * resized_sampler;
+	double * counts;
+	double * next_counts;
+	size_t state;
+
+	if (max_length == 0)
+		return NULL;
+
+	sampler = malloc(sizeof(* sampler) + capacity * tables_size);
+	counts = malloc(states_count * sizeof(* counts));
+	next_counts = malloc(states_count * sizeof(* next_counts));
+	if ((sampler == NULL) || (counts == NULL) || (next_counts == NULL))
+	{
+		free(sampler);
+		free(counts);
+		free(next_counts);
+		return NULL;
+	}
+
+	sampler->states = automaton->states;
+	sampler->states_count = states_count;
+	sampler->max_length = max_length;
+	sampler->lengths_count = 0;
+	sampler->tables = (struct rba_alias_table *) (sampler + 1);
+
+	/* a single empty sequence starts at each state */
+	for (state = 0; state < states_count; state++)
+		counts[state] = 1.0;
+
+	while (! rba_fill_uniform_tables(sampler, counts, next_counts) && (sampler->lengths_count < max_length))
+	{
+		double * swapped_counts = counts;
+
+		counts = next_counts;
+		next_counts = swapped_counts;
+
+		if (sampler->lengths_count == capacity)
+		{
+			capacity = max_length / 2 < capacity ? max_length : 2 * capacity;
+			resized_sampler = realloc(sampler, sizeof(* sampler) + capacity * tables_size);
+			if (resized_sampler == NULL)
+			{
+				free(sampler);
+				free(counts);
+				free(next_counts);
+				return NULL;
+			}
+
+			sampler = resized_sampler;
+			sampler->tables = (struct rba_alias_table *) (sampler + 1);
+		}
+	}
+
+	free(counts);
+	free(next_counts);
+
+	resized_sampler = realloc(sampler, sizeof(* sampler) + sampler->lengths_count * tables_size);
+	if (resized_sampler != NULL)
+	{
+		sampler = resized_sampler;
+		sampler->tables = (struct rba_alias_table *) (sampler + 1);
+	}
+
+	return sampler;
+}
+
+
+void rba_destroy_uniform_sampler(struct rba_uniform_sampler * sampler)
+{
+	free(sampler);
+}
+
+
+size_t rba_generate_uniform_moves_r(
+	struct rba_context * context,
+	struct rba_uniform_sampler const * sampler,
+	rba_move_code * moves,
+	size_t length)
+{
+	size_t state = 0;
+
+	if (length > sampler->max_length)
+		return 0;
+
+	rba_walk_uniformly(context, sampler, moves, length, length, & state);
+
+	return length;
+}
+
+
+size_t rba_generate_uniform_scramble_into_r(
+	struct rba_context * context,
+	struct rba_uniform_sampler const * sampler,
+	char * buffer,
+	size_t capacity,
+	size_t length)
+{
+	rba_move_code moves[MOVES_CHUNK_SIZE];
+	size_t writen_bytes = 0;
+	size_t state = 0;
+
+	if ((length == 0) || (capacity == 0) || (length > sampler->max_length))
+		return 0;
+
+	while (length > 0)
+	{
+		size_t count = length < MOVES_CHUNK_SIZE ? length : MOVES_CHUNK_SIZE;
+		size_t chunk_length;
+
+		rba_walk_uniformly(context, sampler, moves, count, length, & state);
+
+		/* the moves and the separator following the last one */
+		chunk_length = rba_write_moves(moves, count, buffer + writen_bytes, capacity - writen_bytes);
+		if (chunk_length == 0)
+		{
+			* buffer = '\0';
+			return 0;
+		}
+
+		writen_bytes += chunk_length;
+		length -= count;
+	}
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
+}
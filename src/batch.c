@@ -0,0 +1,577 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "attributes.h"
+#include "cube.h"
+
+#include "../include/rubiks_algos.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#	include <immintrin.h>
+#	define X86_INTRINSICS
+#endif
+
+
+
+
+/**
+ * The number of cubes a row of stickers is padded to, so the rows can be
+ * walked by whole vectors
+ */
+#define BATCH_LANES 64
+
+
+/**
+ * The number of cubes turned together, their stickers and the positions they
+ * come from stay in the L1 cache
+ */
+#define TILE_LANES 256
+
+
+/**
+ * The number of cubes of an AVX-512 register of stickers, turned together by
+ * each move
+ */
+#define VECTOR_LANES 64
+
+
+/**
+ * The number of moves whose turns are transposed at once, so the turns of a
+ * move are read from a single row
+ */
+#define TURNS_CHUNK_SIZE 32
+
+
+/**
+ * The number of layers turned by single layer moves, L M R U E D F S B, the
+ * move codes of layer i being 3 * i to 3 * i + 2
+ */
+#define BASE_LAYERS_COUNT 9
+
+
+/**
+ * The number of layers of an axis
+ */
+#define AXIS_LAYERS_COUNT 3
+
+
+/**
+ * The position of the axis in the turns of a move, see move_turns
+ */
+#define TURNS_AXIS_SHIFT 6
+
+
+/**
+ * The most cycles of 4 stickers a quarter turn of a layer moves: 2 on the
+ * face and 3 on the sides of a face layer
+ */
+#define MAX_LAYER_CYCLES 5
+
+
+
+
+/**
+ * The stickers of several cubes, laid out as structure of arrays: row i
+ * holds sticker i of every cube, so a move applied to every cube only moves
+ * whole rows
+ */
+struct rba_cube_batch
+{
+	/**
+	 * The number of cubes of the batch
+	 */
+	size_t count;
+
+	/**
+	 * The size of a row, the number of cubes padded to BATCH_LANES, the
+	 * padding cubes are turned as well and never read
+	 */
+	size_t stride;
+
+	/**
+	 * The FACELETS_COUNT rows of stickers, in the allocation of the batch
+	 */
+	uint8_t * stickers;
+};
+
+
+/**
+ * The function applying its own sequence of moves to each cube of a batch,
+ * the codes being valid
+ */
+typedef void (* rba_lane_moves_function)(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count);
+
+
+
+
+/**
+ * Computes where the stickers of a cube come from after a sequence of moves,
+ * by applying the moves to the positions of the stickers
+ *
+ * @param moves - the codes of the moves, all valid
+ *
+ * @param count - the number of moves
+ *
+ * @param sources - the position each sticker comes from, output
+ */
+static void rba_compose_moves(rba_move_code const * moves, size_t count, struct rba_cube * sources)
+{
+	size_t position;
+
+	for (position = 0; position < CUBE_SIZE; position++)
+		sources->facelets[position] = (uint8_t) position;
+
+	rba_apply_moves(sources, moves, count);
+}
+
+
+/**
+ * Writes the moved stickers of a tile back to the batch
+ *
+ * @param batch - the batch the tile belongs to
+ *
+ * @param start - the first cube of the tile
+ *
+ * @param width - the number of cubes of the tile
+ *
+ * @param gathered - the moved stickers
+ */
+static void rba_write_tile(
+	struct rba_cube_batch * batch,
+	size_t start,
+	size_t width,
+	uint8_t const gathered[][TILE_LANES])
+{
+	size_t facelet;
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		memcpy(batch->stickers + facelet * batch->stride + start, gathered[facelet], width);
+}
+
+
+/**
+ * Applies its own sequence of moves to each cube of a batch, one cube at a
+ * time: composing the sequences then gathering the stickers of every cube is
+ * slower than turning each cube
+ *
+ * @param batch - the cubes to turn
+ *
+ * @param moves - the codes of the moves, all valid, the sequence of cube i
+ * 	starting at moves + i * count
+ *
+ * @param count - the number of moves to apply to each cube
+ */
+static void rba_apply_lane_moves_scalar(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count)
+{
+	struct rba_cube cube;
+	size_t index;
+
+	for (index = 0; index < batch->count; index++)
+	{
+		rba_get_batch_cube(batch, index, & cube);
+		rba_apply_moves(& cube, moves + index * count, count);
+		rba_set_batch_cube(batch, index, & cube);
+	}
+}
+
+
+#ifdef X86_INTRINSICS
+
+/**
+ * The stickers a quarter turn of each single layer moves, in cycles where the
+ * sticker at position i + 1 goes to position i, the face stickers of the face
+ * layers last
+ */
+static uint8_t const layer_cycles[BASE_LAYERS_COUNT][MAX_LAYER_CYCLES][4] =
+{
+	{ { 0, 53, 27, 18 }, { 3, 50, 30, 21 }, { 6, 47, 33, 24 }, { 36, 42, 44, 38 }, { 37, 39, 43, 41 } },
+	{ { 1, 52, 28, 19 }, { 4, 49, 31, 22 }, { 7, 46, 34, 25 } },
+	{ { 2, 20, 29, 51 }, { 5, 23, 32, 48 }, { 8, 26, 35, 45 }, { 9, 15, 17, 11 }, { 10, 12, 16, 14 } },
+	{ { 9, 45, 36, 18 }, { 10, 46, 37, 19 }, { 11, 47, 38, 20 }, { 0, 6, 8, 2 }, { 1, 3, 7, 5 } },
+	{ { 12, 21, 39, 48 }, { 13, 22, 40, 49 }, { 14, 23, 41, 50 } },
+	{ { 15, 24, 42, 51 }, { 16, 25, 43, 52 }, { 17, 26, 44, 53 }, { 27, 33, 35, 29 }, { 28, 30, 34, 32 } },
+	{ { 6, 44, 29, 9 }, { 7, 41, 28, 12 }, { 8, 38, 27, 15 }, { 18, 24, 26, 20 }, { 19, 21, 25, 23 } },
+	{ { 3, 43, 32, 10 }, { 4, 40, 31, 13 }, { 5, 37, 30, 16 } },
+	{ { 0, 11, 35, 42 }, { 1, 14, 34, 39 }, { 2, 17, 33, 36 }, { 45, 51, 53, 47 }, { 46, 48, 52, 50 } }
+};
+
+
+/**
+ * The number of cycles of each single layer, 3 for slices
+ */
+static size_t const layer_cycles_counts[BASE_LAYERS_COUNT] = { 5, 3, 5, 5, 3, 5, 5, 3, 5 };
+
+
+/**
+ * The layers each move turns: the axis in the 2 high bits, then for each
+ * layer of the axis, from its 2 * position bit, 1 if it is turned by 1 or 3
+ * quarter turns and 2 if it is turned by 2 or 3 quarter turns, in the
+ * direction of its cycles
+ * 0 turns no layer
+ */
+static uint8_t move_turns[MOVE_CODES_COUNT];
+
+
+/**
+ * Computes the turns each move gives to each single layer, from the
+ * permutations of the moves
+ */
+static void rba_build_move_turns(void)
+{
+	size_t layer;
+	size_t code;
+
+	memset(move_turns, 0, sizeof(move_turns));
+
+	/* a move turning a layer brings the first sticker of its first cycle
+	 * from 1, 2 or 3 positions further */
+	for (layer = 0; layer < BASE_LAYERS_COUNT; layer++)
+	{
+		uint8_t const * cycle = layer_cycles[layer][0];
+
+		for (code = 0; code < MOVE_CODES_COUNT; code++)
+		{
+			uint8_t source = rba_move_permutations[code][cycle[0]];
+			unsigned int turns = 3;
+
+			while ((turns > 0) && (cycle[turns] != source))
+				turns--;
+
+			if (turns > 0)
+			{
+				move_turns[code] |= (uint8_t) ((layer / AXIS_LAYERS_COUNT) << TURNS_AXIS_SHIFT);
+				move_turns[code] |= (uint8_t) (turns << (2 * (layer % AXIS_LAYERS_COUNT)));
+			}
+		}
+	}
+}
+
+
+/**
+ * Turns a layer of the cubes of a register of stickers with AVX-512, each
+ * cycle of stickers is moved by 1 for odd quarter turns, then by 2 for half
+ * turns, under the masks of the cubes
+ *
+ * @param rows - the stickers of the cubes
+ *
+ * @param layer - the single layer to turn
+ *
+ * @param odd_turns - the cubes turning it by 1 or 3 quarter turns
+ *
+ * @param half_turns - the cubes turning it by 2 or 3 quarter turns
+ */
+TARGET("avx512bw") static INLINE void rba_turn_layer_avx512(
+	__m512i rows[],
+	size_t layer,
+	__mmask64 odd_turns,
+	__mmask64 half_turns)
+{
+	size_t cycle;
+	size_t position;
+
+	/* unrolled, the rows of the cycles are registers or fixed offsets */
+	#pragma GCC unroll 5
+	for (cycle = 0; cycle < layer_cycles_counts[layer]; cycle++)
+	{
+		uint8_t const * facelets = layer_cycles[layer][cycle];
+		__m512i turned[4];
+
+		for (position = 0; position < 4; position++)
+		{
+			turned[position] = _mm512_mask_mov_epi8(
+				rows[facelets[position]],
+				odd_turns,
+				rows[facelets[(position + 1) % 4]]);
+		}
+
+		for (position = 0; position < 4; position++)
+		{
+			rows[facelets[position]] = _mm512_mask_mov_epi8(
+				turned[position],
+				half_turns,
+				turned[(position + 2) % 4]);
+		}
+	}
+}
+
+
+/**
+ * Applies its own sequence of moves to each cube of a batch with AVX-512,
+ * move by move, VECTOR_LANES cubes at a time
+ * A move turns a single axis, so each layer is turned in turn by the cubes
+ * whose move turns it: each cycle of stickers is moved by 1 for odd quarter
+ * turns, then by 2 for half turns, under the masks of these cubes
+ *
+ * @param batch - the cubes to turn
+ *
+ * @param moves - the codes of the moves, all valid, the sequence of cube i
+ * 	starting at moves + i * count
+ *
+ * @param count - the number of moves to apply to each cube
+ */
+TARGET("avx512bw") static void rba_apply_lane_moves_avx512(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count)
+{
+	__m512i const axis_bits = _mm512_set1_epi8((char) (3 << TURNS_AXIS_SHIFT));
+	__m512i rows[FACELETS_COUNT];
+	uint8_t turns[TURNS_CHUNK_SIZE][VECTOR_LANES];
+	size_t start;
+	size_t chunk;
+	size_t index;
+	size_t lane;
+	size_t facelet;
+	size_t axis;
+	size_t layer;
+
+	for (start = 0; start < batch->stride; start += VECTOR_LANES)
+	{
+		size_t width = (batch->count - start < VECTOR_LANES) ? batch->count - start : VECTOR_LANES;
+
+		/* the padding cubes stay in place */
+		memset(turns, 0, sizeof(turns));
+
+		for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+			rows[facelet] = _mm512_loadu_si512(batch->stickers + facelet * batch->stride + start);
+
+		for (chunk = 0; chunk < count; chunk += TURNS_CHUNK_SIZE)
+		{
+			size_t chunk_size = (count - chunk < TURNS_CHUNK_SIZE) ? count - chunk : TURNS_CHUNK_SIZE;
+
+			for (lane = 0; lane < width; lane++)
+			{
+				for (index = 0; index < chunk_size; index++)
+					turns[index][lane] = move_turns[moves[(start + lane) * count + chunk + index]];
+			}
+
+			for (index = 0; index < chunk_size; index++)
+			{
+				__m512i lane_turns = _mm512_loadu_si512(turns[index]);
+
+				#pragma GCC unroll 3
+				for (axis = 0; axis < BASE_LAYERS_COUNT / AXIS_LAYERS_COUNT; axis++)
+				{
+					__mmask64 axis_lanes = _mm512_cmpeq_epi8_mask(
+						_mm512_and_si512(lane_turns, axis_bits),
+						_mm512_set1_epi8((char) (axis << TURNS_AXIS_SHIFT)));
+
+					#pragma GCC unroll 3
+					for (layer = 0; layer < AXIS_LAYERS_COUNT; layer++)
+					{
+						__mmask64 odd_turns = _mm512_mask_test_epi8_mask(
+							axis_lanes,
+							lane_turns,
+							_mm512_set1_epi8((char) (1 << (2 * layer))));
+						__mmask64 half_turns = _mm512_mask_test_epi8_mask(
+							axis_lanes,
+							lane_turns,
+							_mm512_set1_epi8((char) (2 << (2 * layer))));
+
+						if ((odd_turns | half_turns) != 0)
+							rba_turn_layer_avx512(rows, AXIS_LAYERS_COUNT * axis + layer, odd_turns, half_turns);
+					}
+				}
+			}
+		}
+
+		for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+			_mm512_storeu_si512(batch->stickers + facelet * batch->stride + start, rows[facelet]);
+	}
+}
+
+#endif
+
+
+/**
+ * The fastest way to apply per-cube sequences on this CPU, chosen at load
+ * time
+ */
+static rba_lane_moves_function rba_apply_lane_moves = rba_apply_lane_moves_scalar;
+
+
+/**
+ * Picks the fastest way to apply per-cube sequences, at load time
+ */
+CONSTRUCTOR static void rba_init_batch_lanes(void)
+{
+#ifdef X86_INTRINSICS
+	rba_build_move_permutations();
+	rba_build_move_turns();
+
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512bw"))
+		rba_apply_lane_moves = rba_apply_lane_moves_avx512;
+#endif
+}
+
+
+/**
+ * Tells whether the codes of a sequence of moves are valid
+ *
+ * @param moves - the codes to check
+ *
+ * @param count - the number of codes
+ *
+ * @return - 1 if every code is valid, 0 otherwise
+ */
+static int rba_are_move_codes_valid(rba_move_code const * moves, size_t count)
+{
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	return 1;
+}
+
+
+
+
+struct rba_cube_batch * rba_create_cube_batch(size_t count)
+{
+	size_t stride = (count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+	struct rba_cube_batch * batch;
+
+	if (stride > ((size_t) -1 - sizeof(* batch)) / FACELETS_COUNT)
+		return NULL;
+
+	batch = malloc(sizeof(* batch) + FACELETS_COUNT * stride);
+	if (batch == NULL)
+		return NULL;
+
+	batch->count = count;
+	batch->stride = stride;
+	batch->stickers = (uint8_t *) (batch + 1);
+
+	rba_init_cube_batch(batch);
+
+	return batch;
+}
+
+
+void rba_destroy_cube_batch(struct rba_cube_batch * batch)
+{
+	free(batch);
+}
+
+
+void rba_init_cube_batch(struct rba_cube_batch * batch)
+{
+	size_t facelet;
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		memset(batch->stickers + facelet * batch->stride, (int) (facelet / FACE_FACELETS_COUNT), batch->stride);
+}
+
+
+void rba_set_batch_cube(
+	struct rba_cube_batch * batch,
+	size_t index,
+	struct rba_cube const * cube)
+{
+	size_t facelet;
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		batch->stickers[facelet * batch->stride + index] = cube->facelets[facelet];
+}
+
+
+void rba_get_batch_cube(
+	struct rba_cube_batch const * batch,
+	size_t index,
+	struct rba_cube * cube)
+{
+	size_t facelet;
+
+	memset(cube->facelets, 0, CUBE_SIZE);
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		cube->facelets[facelet] = batch->stickers[facelet * batch->stride + index];
+}
+
+
+size_t rba_apply_batch_moves(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count)
+{
+	uint8_t gathered[FACELETS_COUNT][TILE_LANES];
+	struct rba_cube sources;
+	size_t start;
+	size_t facelet;
+
+	if (! rba_are_move_codes_valid(moves, count))
+		return 0;
+
+	/* the whole sequence is a single permutation of the rows */
+	rba_compose_moves(moves, count, & sources);
+
+	for (start = 0; start < batch->stride; start += TILE_LANES)
+	{
+		size_t width = (batch->stride - start < TILE_LANES) ? batch->stride - start : TILE_LANES;
+
+		for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+			memcpy(gathered[facelet], batch->stickers + sources.facelets[facelet] * batch->stride + start, width);
+
+		rba_write_tile(batch, start, width, (uint8_t const (*)[TILE_LANES]) gathered);
+	}
+
+	return count;
+}
+
+
+size_t rba_apply_batch_lane_moves(
+	struct rba_cube_batch * batch,
+	rba_move_code const * moves,
+	size_t count)
+{
+	if (! rba_are_move_codes_valid(moves, count * batch->count))
+		return 0;
+
+	rba_apply_lane_moves(batch, moves, count);
+
+	return count;
+}
+
+
+size_t rba_count_solved_batch_cubes(struct rba_cube_batch const * batch)
+{
+	uint8_t solved[TILE_LANES];
+	size_t solved_count = 0;
+	size_t start;
+	size_t lane;
+	size_t facelet;
+
+	for (start = 0; start < batch->count; start += TILE_LANES)
+	{
+		size_t width = (batch->count - start < TILE_LANES) ? batch->count - start : TILE_LANES;
+
+		memset(solved, 1, width);
+
+		for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		{
+			size_t center = facelet - facelet % FACE_FACELETS_COUNT + FACE_FACELETS_COUNT / 2;
+			uint8_t const * row = batch->stickers + facelet * batch->stride + start;
+			uint8_t const * center_row = batch->stickers + center * batch->stride + start;
+
+			for (lane = 0; lane < width; lane++)
+				solved[lane] &= (row[lane] == center_row[lane]);
+		}
+
+		for (lane = 0; lane < width; lane++)
+			solved_count += solved[lane];
+	}
+
+	return solved_count;
+}
@@ -0,0 +1,438 @@
+#include <string.h>
+
+#include "attributes.h"
+#include "cube.h"
+#include "random.h"
+
+#include "../include/rubiks_algos.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#	include <immintrin.h>
+#	define X86_VECTORS
+#endif
+
+
+
+
+/**
+ * The number of bits of a sticker color
+ */
+#define STICKER_BITS 3
+
+
+/**
+ * The mask of the color of a sticker
+ */
+#define STICKER_MASK 0x7
+
+
+/**
+ * The number of outer stickers of a face, which rotate when it turns
+ */
+#define RING_FACELETS_COUNT 8
+
+
+/**
+ * The bits of the outer stickers of a face, the center comes above them
+ */
+#define RING_BITS (STICKER_BITS * RING_FACELETS_COUNT)
+#define RING_MASK 0xFFFFFFUL
+
+
+/**
+ * The outer stickers of a solved face of color 1, multiplied by a color
+ */
+#define SOLVED_RING 0x249249UL
+
+
+/**
+ * The number of groups of stickers a face receives from other positions in
+ * a move, the most the moves need with the sticker layout of rba_cube,
+ * other faces have empty strips so every move is applied without branches
+ */
+#define FACE_STRIPS_COUNT 2
+
+
+/**
+ * The number of 32 bits lanes of an AVX2 register, the faces take the first
+ * ones
+ */
+#define BITBOARD_LANES 8
+
+
+/**
+ * The multipliers of the hash of bitboard cubes
+ */
+#define HASH_MULTIPLIER UINT64_CONSTANT(0x9E3779B9, 0x7F4A7C15)
+#define HASH_MIXER UINT64_CONSTANT(0xBF58476D, 0x1CE4E5B9)
+
+
+
+
+/**
+ * A group of stickers moving together to each face, from another face, their
+ * outer positions rotated by the same number of places
+ */
+struct rba_bitboard_strips
+{
+	/**
+	 * The face the stickers come from
+	 */
+	uint32_t sources[BITBOARD_LANES];
+
+	/**
+	 * The bits of the stickers on the source face
+	 */
+	uint32_t masks[BITBOARD_LANES];
+
+	/**
+	 * The number of bits the outer stickers are rotated by, and the number
+	 * of bits they are shifted back by once past the last outer sticker, the
+	 * center stays in place
+	 */
+	uint32_t left_shifts[BITBOARD_LANES];
+	uint32_t right_shifts[BITBOARD_LANES];
+};
+
+
+/**
+ * The way a move turns a bitboard cube, as vectors of a lane per face
+ */
+struct rba_bitboard_move
+{
+	/**
+	 * The bits of each face staying in place
+	 */
+	uint32_t kept_masks[BITBOARD_LANES];
+
+	/**
+	 * The stickers each face receives from other positions
+	 */
+	struct rba_bitboard_strips strips[FACE_STRIPS_COUNT];
+};
+
+
+/**
+ * The function applying a sequence of moves to the faces of a bitboard cube
+ */
+typedef void (* rba_bitboard_function)(
+	uint32_t faces[],
+	rba_move_code const moves[],
+	size_t count);
+
+
+
+
+/**
+ * The position of each sticker of a face of rba_cube in its word: the outer
+ * stickers clockwise from the top left one, then the center
+ */
+static unsigned int const ring_positions[FACE_FACELETS_COUNT] = { 0, 1, 2, 7, 8, 3, 6, 5, 4 };
+
+
+/**
+ * The strips of each move, indexed by move code, filled at load time
+ */
+static struct rba_bitboard_move bitboard_moves[MOVE_CODES_COUNT];
+
+
+
+
+/**
+ * Derives the strips of each move from the sticker permutations
+ */
+static void rba_build_bitboard_moves(void)
+{
+	rba_move_code code;
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		struct rba_bitboard_move * move = bitboard_moves + code;
+		size_t strips_counts[FACES_COUNT] = { 0 };
+		size_t destination;
+		size_t strip;
+
+		/* empty strips take the stickers of their own face, with no mask */
+		memset(move, 0, sizeof(* move));
+		for (strip = 0; strip < FACE_STRIPS_COUNT; strip++)
+		{
+			for (destination = 0; destination < BITBOARD_LANES; destination++)
+			{
+				move->strips[strip].sources[destination] = (uint32_t) destination;
+				move->strips[strip].right_shifts[destination] = RING_BITS;
+			}
+		}
+
+		for (destination = 0; destination < FACELETS_COUNT; destination++)
+		{
+			size_t source = rba_move_permutations[code][destination];
+			unsigned int destination_position = ring_positions[destination % FACE_FACELETS_COUNT];
+			unsigned int source_position = ring_positions[source % FACE_FACELETS_COUNT];
+			size_t destination_face = destination / FACE_FACELETS_COUNT;
+			uint32_t source_face = (uint32_t) (source / FACE_FACELETS_COUNT);
+			uint32_t sticker_mask = (uint32_t) STICKER_MASK << (STICKER_BITS * source_position);
+			uint32_t shift = 0;
+
+			/* centers only go to centers */
+			if (source_position < RING_FACELETS_COUNT)
+			{
+				shift = STICKER_BITS
+					* ((destination_position + RING_FACELETS_COUNT - source_position) % RING_FACELETS_COUNT);
+			}
+
+			if ((source_face == destination_face) && (shift == 0))
+			{
+				move->kept_masks[destination_face] |= sticker_mask;
+				continue;
+			}
+
+			for (strip = 0; strip < strips_counts[destination_face]; strip++)
+			{
+				if ((move->strips[strip].sources[destination_face] == source_face)
+					&& (move->strips[strip].left_shifts[destination_face] == shift))
+					break;
+			}
+
+			if (strip == strips_counts[destination_face])
+			{
+				move->strips[strip].sources[destination_face] = source_face;
+				move->strips[strip].left_shifts[destination_face] = shift;
+				move->strips[strip].right_shifts[destination_face] = RING_BITS - shift;
+				strips_counts[destination_face]++;
+			}
+			move->strips[strip].masks[destination_face] |= sticker_mask;
+		}
+	}
+}
+
+
+/**
+ * Applies moves one face at a time, when AVX2 isn't available
+ *
+ * @param faces - the faces of the cube
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ */
+static void rba_turn_faces_scalar(
+	uint32_t faces[],
+	rba_move_code const moves[],
+	size_t count)
+{
+	uint32_t turned_faces[FACES_COUNT];
+	size_t index;
+	size_t face;
+	size_t strip;
+
+	for (index = 0; index < count; index++)
+	{
+		struct rba_bitboard_move const * move = bitboard_moves + moves[index];
+
+		for (face = 0; face < FACES_COUNT; face++)
+		{
+			uint32_t turned_face = faces[face] & move->kept_masks[face];
+
+			for (strip = 0; strip < FACE_STRIPS_COUNT; strip++)
+			{
+				struct rba_bitboard_strips const * strips = move->strips + strip;
+				uint32_t stickers = faces[strips->sources[face]] & strips->masks[face];
+				uint64_t ring = (uint64_t) (stickers & RING_MASK) << strips->left_shifts[face];
+
+				/* the bits shifted past the ring come back at its start */
+				turned_face |= (stickers & ~(uint32_t) RING_MASK)
+					| (uint32_t) ((ring | (ring >> RING_BITS)) & RING_MASK);
+			}
+
+			turned_faces[face] = turned_face;
+		}
+
+		memcpy(faces, turned_faces, sizeof(turned_faces));
+	}
+}
+
+
+#ifdef X86_VECTORS
+
+/**
+ * Applies moves with AVX2, the faces stay in the lanes of a register, each
+ * strip is gathered with a lane permutation and rotated with variable shifts
+ *
+ * @param faces - the faces of the cube
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ */
+TARGET("avx2") static void rba_turn_faces_avx2(
+	uint32_t faces[],
+	rba_move_code const moves[],
+	size_t count)
+{
+	__m256i const lanes_mask = _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+	__m256i const ring_mask = _mm256_set1_epi32(RING_MASK);
+	__m256i cube = _mm256_maskload_epi32((int const *) faces, lanes_mask);
+	size_t index;
+	size_t strip;
+
+	for (index = 0; index < count; index++)
+	{
+		struct rba_bitboard_move const * move = bitboard_moves + moves[index];
+		__m256i turned_cube = _mm256_and_si256(cube, _mm256_loadu_si256((__m256i const *) move->kept_masks));
+
+		for (strip = 0; strip < FACE_STRIPS_COUNT; strip++)
+		{
+			struct rba_bitboard_strips const * strips = move->strips + strip;
+			__m256i stickers = _mm256_and_si256(
+				_mm256_permutevar8x32_epi32(cube, _mm256_loadu_si256((__m256i const *) strips->sources)),
+				_mm256_loadu_si256((__m256i const *) strips->masks));
+			__m256i ring = _mm256_and_si256(stickers, ring_mask);
+			__m256i rotated_ring = _mm256_or_si256(
+				_mm256_sllv_epi32(ring, _mm256_loadu_si256((__m256i const *) strips->left_shifts)),
+				_mm256_srlv_epi32(ring, _mm256_loadu_si256((__m256i const *) strips->right_shifts)));
+
+			turned_cube = _mm256_or_si256(
+				turned_cube,
+				_mm256_or_si256(
+					_mm256_andnot_si256(ring_mask, stickers),
+					_mm256_and_si256(rotated_ring, ring_mask)));
+		}
+
+		cube = turned_cube;
+	}
+
+	_mm256_maskstore_epi32((int *) faces, lanes_mask, cube);
+}
+
+#endif
+
+
+/**
+ * The fastest way to apply moves on this CPU, chosen at load time
+ */
+static rba_bitboard_function rba_turn_faces = rba_turn_faces_scalar;
+
+
+/**
+ * Builds the move tables and picks the fastest way to apply moves, at load
+ * time
+ */
+CONSTRUCTOR static void rba_init_bitboard_tables(void)
+{
+	rba_build_move_permutations();
+	rba_build_bitboard_moves();
+
+#ifdef X86_VECTORS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		rba_turn_faces = rba_turn_faces_avx2;
+#endif
+}
+
+
+
+
+void rba_init_bitboard_cube(struct rba_bitboard_cube * cube)
+{
+	struct rba_cube unpacked_cube;
+
+	rba_init_cube(& unpacked_cube);
+	rba_pack_cube(& unpacked_cube, cube);
+}
+
+
+void rba_pack_cube(struct rba_cube const * cube, struct rba_bitboard_cube * bitboard_cube)
+{
+	size_t facelet;
+
+	memset(bitboard_cube, 0, sizeof(* bitboard_cube));
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+	{
+		uint32_t color = cube->facelets[facelet] & STICKER_MASK;
+
+		bitboard_cube->faces[facelet / FACE_FACELETS_COUNT] |=
+			color << (STICKER_BITS * ring_positions[facelet % FACE_FACELETS_COUNT]);
+	}
+}
+
+
+void rba_unpack_cube(struct rba_bitboard_cube const * bitboard_cube, struct rba_cube * cube)
+{
+	size_t facelet;
+
+	memset(cube->facelets, 0, CUBE_SIZE);
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+	{
+		uint32_t face = bitboard_cube->faces[facelet / FACE_FACELETS_COUNT];
+
+		cube->facelets[facelet] = (uint8_t)
+			((face >> (STICKER_BITS * ring_positions[facelet % FACE_FACELETS_COUNT])) & STICKER_MASK);
+	}
+}
+
+
+size_t rba_apply_bitboard_moves(
+	struct rba_bitboard_cube * cube,
+	rba_move_code const * moves,
+	size_t count)
+{
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	rba_turn_faces(cube->faces, moves, count);
+
+	return count;
+}
+
+
+int rba_is_bitboard_cube_solved(struct rba_bitboard_cube const * cube)
+{
+	size_t face;
+
+	for (face = 0; face < FACES_COUNT; face++)
+	{
+		uint32_t center = cube->faces[face] >> RING_BITS;
+
+		if ((cube->faces[face] & RING_MASK) != center * SOLVED_RING)
+			return 0;
+	}
+
+	return 1;
+}
+
+
+int rba_are_bitboard_cubes_equal(
+	struct rba_bitboard_cube const * cube,
+	struct rba_bitboard_cube const * other_cube)
+{
+	uint32_t differences = 0;
+	size_t face;
+
+	for (face = 0; face < FACES_COUNT; face++)
+		differences |= cube->faces[face] ^ other_cube->faces[face];
+
+	return differences == 0;
+}
+
+
+uint64_t rba_hash_bitboard_cube(struct rba_bitboard_cube const * cube)
+{
+	uint64_t hash = 0;
+	size_t face;
+
+	/* faces are hashed 2 by 2, as 64 bits words */
+	for (face = 0; face < FACES_COUNT; face += 2)
+		hash = (hash ^ (cube->faces[face] | ((uint64_t) cube->faces[face + 1] << 32))) * HASH_MULTIPLIER;
+
+	hash ^= hash >> 31;
+	hash *= HASH_MIXER;
+
+	return hash ^ (hash >> 29);
+}
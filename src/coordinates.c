@@ -0,0 +1,158 @@
+#include <string.h>
+
+#include "attributes.h"
+#include "cubie.h"
+#include "solver.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * Marks a move code which isn't a face move
+ */
+#define NO_FACE_MOVE 0xFF
+
+
+
+
+/**
+ * The face move of each move code, NO_FACE_MOVE for the other codes, filled
+ * at load time
+ */
+static uint8_t face_moves[MOVE_CODES_COUNT];
+
+
+
+
+/**
+ * Fills the face move of each move code, at load time
+ */
+CONSTRUCTOR static void rba_init_face_moves(void)
+{
+	size_t move;
+
+	memset(face_moves, NO_FACE_MOVE, sizeof(face_moves));
+
+	for (move = 0; move < FACE_MOVES_COUNT; move++)
+		face_moves[rba_face_move_codes[move]] = (uint8_t) move;
+}
+
+
+/**
+ * Tells whether coordinates are in range
+ *
+ * @param coordinates - the coordinates to check
+ *
+ * @return - 1 if every coordinate is in range, 0 otherwise
+ */
+static int rba_are_coordinates_valid(struct rba_coordinates const * coordinates)
+{
+	return (coordinates->twist < TWIST_COUNT)
+		&& (coordinates->flip < FLIP_COUNT)
+		&& (coordinates->slice < SLICE_COUNT)
+		&& (coordinates->corner_permutation < CORNER_PERMUTATION_COUNT);
+}
+
+
+
+
+int rba_get_coordinates(struct rba_cube const * cube, struct rba_coordinates * coordinates)
+{
+	struct rba_cubie_cube cubie_cube;
+
+	if (! rba_read_cube(cube, & cubie_cube))
+		return 0;
+
+	coordinates->twist = rba_get_twist(& cubie_cube);
+	coordinates->flip = rba_get_flip(& cubie_cube);
+	coordinates->slice = rba_get_slice_sorted(& cubie_cube) / SLICE_PERMUTATION_COUNT;
+	coordinates->corner_permutation = rba_get_corner_permutation(& cubie_cube);
+
+	return 1;
+}
+
+
+int rba_set_coordinates(struct rba_coordinates const * coordinates, struct rba_cube * cube)
+{
+	struct rba_cubie_cube cubie_cube;
+	size_t first = 0;
+	size_t second;
+
+	if (! rba_are_coordinates_valid(coordinates))
+		return 0;
+
+	rba_init_cubie_cube(& cubie_cube);
+	rba_set_twist(& cubie_cube, coordinates->twist);
+	rba_set_flip(& cubie_cube, coordinates->flip);
+	rba_set_slice_sorted(& cubie_cube, coordinates->slice * SLICE_PERMUTATION_COUNT);
+	rba_set_corner_permutation(& cubie_cube, coordinates->corner_permutation);
+
+	/* 2 edges outside of the slice are swapped, no coordinate changes */
+	if (rba_permutation_parity(cubie_cube.corner_permutation, CORNERS_COUNT)
+		!= rba_permutation_parity(cubie_cube.edge_permutation, EDGES_COUNT))
+	{
+		uint8_t edge;
+
+		while (cubie_cube.edge_permutation[first] >= FR_EDGE)
+			first++;
+		second = first + 1;
+		while (cubie_cube.edge_permutation[second] >= FR_EDGE)
+			second++;
+
+		edge = cubie_cube.edge_permutation[first];
+		cubie_cube.edge_permutation[first] = cubie_cube.edge_permutation[second];
+		cubie_cube.edge_permutation[second] = edge;
+	}
+
+	memset(cube->facelets, 0, CUBE_SIZE);
+	rba_write_cubie_cube(& cubie_cube, cube->facelets);
+
+	return 1;
+}
+
+
+size_t rba_move_coordinates(
+	struct rba_coordinates * coordinates,
+	rba_move_code const * moves,
+	size_t count)
+{
+	struct rba_solver_tables const * tables;
+	unsigned int twist = coordinates->twist;
+	unsigned int flip = coordinates->flip;
+	unsigned int slice = coordinates->slice;
+	unsigned int corner_permutation = coordinates->corner_permutation;
+	size_t index;
+
+	if (! rba_are_coordinates_valid(coordinates))
+		return 0;
+
+	for (index = 0; index < count; index++)
+	{
+		if ((moves[index] >= MOVE_CODES_COUNT) || (face_moves[moves[index]] == NO_FACE_MOVE))
+			return 0;
+	}
+
+	tables = rba_get_solver_tables();
+	if (tables == NULL)
+		return 0;
+
+	for (index = 0; index < count; index++)
+	{
+		unsigned int move = face_moves[moves[index]];
+
+		twist = tables->twist_moves[twist][move];
+		flip = tables->flip_moves[flip][move];
+		/* any order of the slice edges gives the same positions */
+		slice = tables->slice_sorted_moves[slice * SLICE_PERMUTATION_COUNT][move] / SLICE_PERMUTATION_COUNT;
+		corner_permutation = tables->corner_permutation_moves[corner_permutation][move];
+	}
+
+	coordinates->twist = twist;
+	coordinates->flip = flip;
+	coordinates->slice = slice;
+	coordinates->corner_permutation = corner_permutation;
+
+	return count;
+}
@@ -0,0 +1,459 @@
+
+#include <string.h>
+
+#include "attributes.h"
+#include "moves.h"
+#include "cube.h"
+
+#include "../include/rubiks_algos.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#	include <immintrin.h>
+#	define X86_SHUFFLES
+#endif
+
+
+
+
+/**
+ * The number of 16 bytes blocks of a cube, each one held by a SSE register
+ */
+#define CUBE_BLOCKS_COUNT 4
+
+
+/**
+ * The number of 32 bytes halves of a cube, each one held by an AVX register
+ */
+#define CUBE_HALVES_COUNT 2
+
+
+/**
+ * A shuffle index setting the destination byte to 0
+ */
+#define ZEROING_INDEX 0x80
+
+
+
+
+/**
+ * The function applying a sequence of moves to the stickers of a cube
+ */
+typedef void (* rba_shuffle_function)(
+	uint8_t facelets[],
+	rba_move_code const moves[],
+	size_t count);
+
+
+
+
+uint8_t rba_move_permutations[MOVE_CODES_COUNT][CUBE_SIZE];
+
+
+#ifdef X86_SHUFFLES
+
+/**
+ * The SSSE3 shuffle indexes of each move, for each destination block and
+ * each source block, bytes coming from another block are zeroed
+ */
+static uint8_t ssse3_shuffles[MOVE_CODES_COUNT][CUBE_BLOCKS_COUNT][CUBE_BLOCKS_COUNT][16];
+
+
+/**
+ * The AVX2 shuffle indexes of each move, for each destination half and each
+ * source: first half, first half with swapped lanes, second half, second
+ * half with swapped lanes, bytes coming from another source are zeroed
+ */
+static uint8_t avx2_shuffles[MOVE_CODES_COUNT][CUBE_HALVES_COUNT][CUBE_BLOCKS_COUNT][32];
+
+#endif
+
+
+
+
+/**
+ * Computes the position of a sticker, the coordinates of its cubie are
+ * doubled and the sticker lies at 3 on the axis its face is normal to
+ *
+ * @param facelet - the position of the sticker in rba_cube
+ *
+ * @param point - the x, y and z coordinates of the sticker, output
+ */
+static void rba_facelet_point(size_t facelet, int point[3])
+{
+	int row = 2 * ((int) (facelet % FACE_FACELETS_COUNT / 3) - 1);
+	int column = 2 * ((int) (facelet % 3) - 1);
+
+	switch (facelet / FACE_FACELETS_COUNT)
+	{
+		case UP_FACE:
+			point[0] = column, point[1] = 3, point[2] = row;
+			break;
+
+		case RIGHT_FACE:
+			point[0] = 3, point[1] = -row, point[2] = -column;
+			break;
+
+		case FRONT_FACE:
+			point[0] = column, point[1] = -row, point[2] = 3;
+			break;
+
+		case DOWN_FACE:
+			point[0] = column, point[1] = -3, point[2] = -row;
+			break;
+
+		case LEFT_FACE:
+			point[0] = -3, point[1] = -row, point[2] = column;
+			break;
+
+		default:
+			point[0] = -column, point[1] = -row, point[2] = -3;
+			break;
+	}
+}
+
+
+/**
+ * Finds the sticker lying at a position
+ *
+ * @param point - the x, y and z coordinates of the sticker
+ *
+ * @return size_t - the position of the sticker in rba_cube
+ */
+static size_t rba_point_facelet(int const point[3])
+{
+	int facelet_point[3];
+	size_t facelet;
+
+	for (facelet = 0; facelet < FACELETS_COUNT - 1; facelet++)
+	{
+		rba_facelet_point(facelet, facelet_point);
+		if (memcmp(point, facelet_point, sizeof(facelet_point)) == 0)
+			break;
+	}
+
+	return facelet;
+}
+
+
+/**
+ * Rotates a position by a clockwise quarter turn, as seen from the positive
+ * side of the axis
+ *
+ * @param point - the x, y and z coordinates to rotate
+ *
+ * @param axis - the axis to rotate around, 0 for x, 1 for y, 2 for z
+ */
+static void rba_rotate_point(int point[3], int axis)
+{
+	int first = (axis + 1) % 3;
+	int second = (axis + 2) % 3;
+	int previous_first = point[first];
+
+	point[first] = point[second];
+	point[second] = -previous_first;
+}
+
+
+void rba_build_move_permutations(void)
+{
+	static int built = 0;
+	rba_move_code code;
+
+	if (built)
+		return;
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		struct rba_layer_rotation const * rotation = rba_layer_rotations + code / 3;
+		int turns = rotation->quarter_turns * rba_modifier_turns[code % 3] % 4;
+		uint8_t * permutation = rba_move_permutations[code];
+		size_t position;
+
+		for (position = 0; position < CUBE_SIZE; position++)
+			permutation[position] = (uint8_t) position;
+
+		for (position = 0; position < FACELETS_COUNT; position++)
+		{
+			int point[3];
+			int layer;
+			int turn;
+
+			rba_facelet_point(position, point);
+			layer = (point[rotation->axis] > 0) - (point[rotation->axis] < 0) + 1;
+			if ((rotation->layers & (1 << layer)) == 0)
+				continue;
+
+			for (turn = 0; turn < turns; turn++)
+				rba_rotate_point(point, rotation->axis);
+
+			permutation[rba_point_facelet(point)] = (uint8_t) position;
+		}
+	}
+
+	built = 1;
+}
+
+
+/**
+ * Applies moves one sticker at a time, when no vector shuffle is available
+ *
+ * @param facelets - the stickers of the cube
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ */
+static void rba_shuffle_scalar(
+	uint8_t facelets[],
+	rba_move_code const moves[],
+	size_t count)
+{
+	uint8_t shuffled[FACELETS_COUNT];
+	size_t index;
+	size_t facelet;
+
+	for (index = 0; index < count; index++)
+	{
+		uint8_t const * permutation = rba_move_permutations[moves[index]];
+
+		for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+			shuffled[facelet] = facelets[permutation[facelet]];
+
+		memcpy(facelets, shuffled, FACELETS_COUNT);
+	}
+}
+
+
+#ifdef X86_SHUFFLES
+
+/**
+ * Computes the SSSE3 and AVX2 shuffle indexes of each move from its
+ * permutation
+ */
+static void rba_build_move_shuffles(void)
+{
+	rba_move_code code;
+	size_t destination;
+	size_t source;
+	size_t byte;
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		uint8_t const * permutation = rba_move_permutations[code];
+
+		for (destination = 0; destination < CUBE_BLOCKS_COUNT; destination++)
+		{
+			for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+			{
+				for (byte = 0; byte < 16; byte++)
+				{
+					uint8_t position = permutation[16 * destination + byte];
+
+					ssse3_shuffles[code][destination][source][byte] = (position / 16 == source)
+						? position % 16
+						: ZEROING_INDEX;
+				}
+			}
+		}
+
+		for (destination = 0; destination < CUBE_HALVES_COUNT; destination++)
+		{
+			for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+			{
+				for (byte = 0; byte < 32; byte++)
+				{
+					uint8_t position = permutation[32 * destination + byte];
+					/* the block held by the lane of the byte in this source */
+					size_t block = 2 * (source / 2) + ((byte / 16) ^ (source % 2));
+
+					avx2_shuffles[code][destination][source][byte] = (position / 16 == block)
+						? position % 16
+						: ZEROING_INDEX;
+				}
+			}
+		}
+	}
+}
+
+
+/**
+ * Applies moves with SSSE3 shuffles, the cube stays in 4 registers, each
+ * destination block gathers its bytes from the 4 source blocks
+ *
+ * @param facelets - the stickers of the cube
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ */
+TARGET("ssse3") static void rba_shuffle_ssse3(
+	uint8_t facelets[],
+	rba_move_code const moves[],
+	size_t count)
+{
+	__m128i blocks[CUBE_BLOCKS_COUNT];
+	__m128i shuffled[CUBE_BLOCKS_COUNT];
+	size_t index;
+	size_t destination;
+	size_t source;
+
+	for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+		blocks[source] = _mm_loadu_si128((__m128i const *) facelets + source);
+
+	for (index = 0; index < count; index++)
+	{
+		uint8_t const (* shuffles)[CUBE_BLOCKS_COUNT][16] =
+			(uint8_t const (*)[CUBE_BLOCKS_COUNT][16]) ssse3_shuffles[moves[index]];
+
+		for (destination = 0; destination < CUBE_BLOCKS_COUNT; destination++)
+		{
+			shuffled[destination] = _mm_setzero_si128();
+			for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+			{
+				shuffled[destination] = _mm_or_si128(
+					shuffled[destination],
+					_mm_shuffle_epi8(
+						blocks[source],
+						_mm_loadu_si128((__m128i const *) shuffles[destination][source])));
+			}
+		}
+
+		for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+			blocks[source] = shuffled[source];
+	}
+
+	for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+		_mm_storeu_si128((__m128i *) facelets + source, blocks[source]);
+}
+
+
+/**
+ * Applies moves with AVX2 shuffles, the cube stays in 2 registers
+ * Shuffles don't cross 128 bits lanes, so each half is also used with its
+ * lanes swapped to reach every block
+ *
+ * @param facelets - the stickers of the cube
+ *
+ * @param moves - the codes of the moves to apply
+ *
+ * @param count - the number of moves to apply
+ */
+TARGET("avx2") static void rba_shuffle_avx2(
+	uint8_t facelets[],
+	rba_move_code const moves[],
+	size_t count)
+{
+	__m256i halves[CUBE_HALVES_COUNT];
+	__m256i sources[CUBE_BLOCKS_COUNT];
+	__m256i shuffled[CUBE_HALVES_COUNT];
+	size_t index;
+	size_t destination;
+	size_t source;
+
+	for (destination = 0; destination < CUBE_HALVES_COUNT; destination++)
+		halves[destination] = _mm256_loadu_si256((__m256i const *) facelets + destination);
+
+	for (index = 0; index < count; index++)
+	{
+		uint8_t const (* shuffles)[CUBE_BLOCKS_COUNT][32] =
+			(uint8_t const (*)[CUBE_BLOCKS_COUNT][32]) avx2_shuffles[moves[index]];
+
+		sources[0] = halves[0];
+		sources[1] = _mm256_permute2x128_si256(halves[0], halves[0], 0x01);
+		sources[2] = halves[1];
+		sources[3] = _mm256_permute2x128_si256(halves[1], halves[1], 0x01);
+
+		for (destination = 0; destination < CUBE_HALVES_COUNT; destination++)
+		{
+			shuffled[destination] = _mm256_setzero_si256();
+			for (source = 0; source < CUBE_BLOCKS_COUNT; source++)
+			{
+				shuffled[destination] = _mm256_or_si256(
+					shuffled[destination],
+					_mm256_shuffle_epi8(
+						sources[source],
+						_mm256_loadu_si256((__m256i const *) shuffles[destination][source])));
+			}
+		}
+
+		halves[0] = shuffled[0];
+		halves[1] = shuffled[1];
+	}
+
+	for (destination = 0; destination < CUBE_HALVES_COUNT; destination++)
+		_mm256_storeu_si256((__m256i *) facelets + destination, halves[destination]);
+}
+
+#endif
+
+
+/**
+ * The fastest way to apply moves on this CPU, chosen at load time
+ */
+static rba_shuffle_function rba_shuffle_facelets = rba_shuffle_scalar;
+
+
+/**
+ * Builds the move tables and picks the fastest way to apply moves, at load
+ * time
+ */
+CONSTRUCTOR static void rba_init_cube_tables(void)
+{
+	rba_build_move_permutations();
+
+#ifdef X86_SHUFFLES
+	rba_build_move_shuffles();
+
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		rba_shuffle_facelets = rba_shuffle_avx2;
+	else if (__builtin_cpu_supports("ssse3"))
+		rba_shuffle_facelets = rba_shuffle_ssse3;
+#endif
+}
+
+
+void rba_init_cube(struct rba_cube * cube)
+{
+	size_t facelet;
+
+	memset(cube->facelets, 0, CUBE_SIZE);
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+		cube->facelets[facelet] = (uint8_t) (facelet / FACE_FACELETS_COUNT);
+}
+
+
+size_t rba_apply_moves(
+	struct rba_cube * cube,
+	rba_move_code const * moves,
+	size_t count)
+{
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	rba_shuffle_facelets(cube->facelets, moves, count);
+
+	return count;
+}
+
+
+int rba_is_cube_solved(struct rba_cube const * cube)
+{
+	size_t facelet;
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+	{
+		size_t center = facelet - facelet % FACE_FACELETS_COUNT + FACE_FACELETS_COUNT / 2;
+
+		if (cube->facelets[facelet] != cube->facelets[center])
+			return 0;
+	}
+
+	return 1;
+}
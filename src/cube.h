@@ -0,0 +1,39 @@
+#ifndef RUBIKS_ALGOS_CUBE_HEADER
+#define RUBIKS_ALGOS_CUBE_HEADER
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of stickers on each face
+ */
+#define FACE_FACELETS_COUNT 9
+
+
+
+
+/**
+ * The sticker permutation of each move, indexed by move code
+ * After a move, the sticker at position i comes from position
+ * rba_move_permutations[move][i], padding positions are left in place
+ * Filled at load time, see rba_build_move_permutations()
+ */
+extern uint8_t rba_move_permutations[MOVE_CODES_COUNT][CUBE_SIZE];
+
+
+
+
+/**
+ * Computes the sticker permutation of each move from the geometry of the
+ * cube, does nothing once they are computed
+ * Called at load time, tables derived from the permutations call it before
+ * reading them
+ */
+void rba_build_move_permutations(void);
+
+
+
+
+#endif /* RUBIKS_ALGOS_CUBE_HEADER */
@@ -0,0 +1,883 @@
+#include <string.h>
+
+#include "attributes.h"
+#include "random.h"
+#include "moves.h"
+#include "cube.h"
+#include "cubie.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of stickers of a corner and of an edge
+ */
+#define CORNER_FACELETS_COUNT 3
+#define EDGE_FACELETS_COUNT 2
+
+
+/**
+ * The number of edges in the equator slice, and in each group of edges whose
+ * positions and order make a coordinate
+ */
+#define SLICE_EDGES_COUNT 4
+
+
+/**
+ * The number of elements of the longest ranked permutation, the bits of its
+ * elements index the tables of the ranking
+ */
+#define MAX_RANKED_COUNT 8
+#define RANKED_MASKS_COUNT (1 << MAX_RANKED_COUNT)
+
+
+/**
+ * Marks an edge position not filled yet
+ */
+#define NO_EDGE 0xFF
+
+
+
+
+/**
+ * The stickers of each corner position, starting with the U or D one, then
+ * clockwise
+ */
+static uint8_t const corner_facelets[CORNERS_COUNT][CORNER_FACELETS_COUNT] =
+{
+	{ 8, 9, 20 }, { 6, 18, 38 }, { 0, 36, 47 }, { 2, 45, 11 },
+	{ 29, 26, 15 }, { 27, 44, 24 }, { 33, 53, 42 }, { 35, 17, 51 }
+};
+
+
+/**
+ * The stickers of each edge position, starting with the U or D one, or the F
+ * or B one for the equator slice
+ */
+static uint8_t const edge_facelets[EDGES_COUNT][EDGE_FACELETS_COUNT] =
+{
+	{ 5, 10 }, { 7, 19 }, { 3, 37 }, { 1, 46 },
+	{ 32, 16 }, { 28, 25 }, { 30, 43 }, { 34, 52 },
+	{ 23, 12 }, { 21, 41 }, { 50, 39 }, { 48, 14 }
+};
+
+
+/**
+ * The number of bits set in each mask of elements, filled at load time
+ */
+static uint8_t set_bits_counts[RANKED_MASKS_COUNT];
+
+
+/**
+ * The bits set in each mask of elements, by increasing position, filled at
+ * load time
+ */
+static uint8_t set_bits[RANKED_MASKS_COUNT][MAX_RANKED_COUNT];
+
+
+struct rba_cubie_cube rba_face_move_cubies[FACE_MOVES_COUNT];
+
+
+rba_move_code const rba_face_move_codes[FACE_MOVES_COUNT] =
+{
+	MOVE_CODE(TOP_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(TOP_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(TOP_LAYER_INDEX, REVERSE_MODIFIER),
+	MOVE_CODE(RIGHT_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(RIGHT_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(RIGHT_LAYER_INDEX, REVERSE_MODIFIER),
+	MOVE_CODE(FRONT_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(FRONT_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(FRONT_LAYER_INDEX, REVERSE_MODIFIER),
+	MOVE_CODE(BOTTOM_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(BOTTOM_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(BOTTOM_LAYER_INDEX, REVERSE_MODIFIER),
+	MOVE_CODE(LEFT_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(LEFT_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(LEFT_LAYER_INDEX, REVERSE_MODIFIER),
+	MOVE_CODE(BACK_LAYER_INDEX, NO_MODIFIER),
+	MOVE_CODE(BACK_LAYER_INDEX, DOUBLE_MODIFIER),
+	MOVE_CODE(BACK_LAYER_INDEX, REVERSE_MODIFIER)
+};
+
+
+
+
+/**
+ * Computes the number of ways to choose k elements among n
+ *
+ * @param n - the number of elements
+ *
+ * @param k - the number of chosen elements
+ *
+ * @return - the binomial coefficient, 0 if k > n
+ */
+static unsigned int rba_binomial(unsigned int n, unsigned int k)
+{
+	unsigned int coefficient = 1;
+	unsigned int index;
+
+	if (k > n)
+		return 0;
+
+	for (index = 1; index <= k; index++)
+		coefficient = coefficient * (n - k + index) / index;
+
+	return coefficient;
+}
+
+
+/**
+ * Computes the rank of a permutation of 0 to count - 1, from its Lehmer code:
+ * the number of smaller elements placed after each element, counted from
+ * the bits of the elements placed before it
+ *
+ * @param elements - the permutation
+ *
+ * @param count - the number of elements, at most MAX_RANKED_COUNT
+ *
+ * @return - the rank of the permutation, 0 for the identity
+ */
+static unsigned int rba_rank_permutation(uint8_t const elements[], size_t count)
+{
+	unsigned int placed = 0;
+	unsigned int rank = 0;
+	size_t position;
+
+	for (position = 0; position < count; position++)
+	{
+		unsigned int element = elements[position];
+		unsigned int smaller_placed = set_bits_counts[placed & ((1u << element) - 1)];
+
+		rank = (unsigned int) (count - position) * rank + element - smaller_placed;
+		placed |= 1u << element;
+	}
+
+	return rank;
+}
+
+
+/**
+ * Builds the permutation of 0 to count - 1 with the given rank, each element
+ * being picked among the bits of the elements left
+ *
+ * @param elements - the permutation, output
+ *
+ * @param count - the number of elements, at most MAX_RANKED_COUNT
+ *
+ * @param rank - the rank of the permutation
+ */
+static void rba_unrank_permutation(uint8_t elements[], size_t count, unsigned int rank)
+{
+	uint8_t smaller_counts[MAX_RANKED_COUNT];
+	unsigned int left = (1u << count) - 1;
+	size_t position;
+
+	for (position = count; position-- > 0;)
+	{
+		smaller_counts[position] = (uint8_t) (rank % (count - position));
+		rank /= (unsigned int) (count - position);
+	}
+
+	for (position = 0; position < count; position++)
+	{
+		elements[position] = set_bits[left][smaller_counts[position]];
+		left &= ~(1u << elements[position]);
+	}
+}
+
+
+/**
+ * Shuffles elements uniformly
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param elements - the elements to shuffle
+ *
+ * @param count - the number of elements
+ *
+ * @return - the parity of the applied permutation, 1 if odd
+ */
+static int rba_shuffle(struct rba_context * context, uint8_t elements[], size_t count)
+{
+	int parity = 0;
+	size_t last;
+
+	for (last = count - 1; last > 0; last--)
+	{
+		size_t picked = rba_random_index(context, (uint32_t) last + 1);
+		uint8_t element = elements[picked];
+
+		if (picked == last)
+			continue;
+
+		elements[picked] = elements[last];
+		elements[last] = element;
+		parity ^= 1;
+	}
+
+	return parity;
+}
+
+
+/**
+ * Composes 2 cube states, the product is the first one followed by the
+ * second one
+ *
+ * @param first - the state to start from
+ *
+ * @param second - the state to apply
+ *
+ * @param product - the composed state, output
+ */
+static void rba_multiply_cubie_cubes(
+	struct rba_cubie_cube const * first,
+	struct rba_cubie_cube const * second,
+	struct rba_cubie_cube * product)
+{
+	size_t position;
+
+	for (position = 0; position < CORNERS_COUNT; position++)
+	{
+		uint8_t origin = second->corner_permutation[position];
+
+		product->corner_permutation[position] = first->corner_permutation[origin];
+		product->corner_orientation[position] = (uint8_t)
+			((first->corner_orientation[origin] + second->corner_orientation[position]) % 3);
+	}
+
+	for (position = 0; position < EDGES_COUNT; position++)
+	{
+		uint8_t origin = second->edge_permutation[position];
+
+		product->edge_permutation[position] = first->edge_permutation[origin];
+		product->edge_orientation[position] = (uint8_t)
+			(first->edge_orientation[origin] ^ second->edge_orientation[position]);
+	}
+}
+
+
+/**
+ * Reads the cubies of each face move from the stickers they move, at load
+ * time
+ */
+CONSTRUCTOR static void rba_init_face_move_cubies(void)
+{
+	size_t move;
+
+	rba_build_move_permutations();
+
+	for (move = 0; move < FACE_MOVES_COUNT; move++)
+	{
+		struct rba_cube cube;
+
+		rba_init_cube(& cube);
+		rba_apply_moves(& cube, rba_face_move_codes + move, 1);
+		rba_read_cubie_cube(cube.facelets, rba_face_move_cubies + move);
+	}
+}
+
+
+/**
+ * Fills the tables of the ranking of permutations, at load time
+ */
+CONSTRUCTOR static void rba_init_ranking_tables(void)
+{
+	unsigned int mask;
+	unsigned int element;
+
+	for (mask = 0; mask < RANKED_MASKS_COUNT; mask++)
+	{
+		set_bits_counts[mask] = 0;
+		for (element = 0; element < MAX_RANKED_COUNT; element++)
+		{
+			if (mask & (1u << element))
+				set_bits[mask][set_bits_counts[mask]++] = (uint8_t) element;
+		}
+	}
+}
+
+
+/**
+ * Computes the coordinate of the positions and order of a group of edges
+ *
+ * @param cube - the cube to read
+ *
+ * @param first_edge - the first edge of the group, the group being made of
+ * 	SLICE_EDGES_COUNT consecutive edges
+ *
+ * @return - the coordinate, 0 to SLICE_SORTED_COUNT - 1, divided by
+ * 	SLICE_PERMUTATION_COUNT it gives the positions only, 0 when they are the
+ * 	last positions
+ */
+static unsigned int rba_get_edges_sorted(struct rba_cubie_cube const * cube, unsigned int first_edge)
+{
+	uint8_t group_edges[SLICE_EDGES_COUNT];
+	unsigned int combination = 0;
+	unsigned int found = 0;
+	size_t position;
+
+	/* the positions of the edges, from the last position */
+	for (position = EDGES_COUNT; position-- > 0;)
+	{
+		unsigned int edge = cube->edge_permutation[position] - first_edge;
+
+		if (edge < SLICE_EDGES_COUNT)
+		{
+			combination += rba_binomial(EDGES_COUNT - 1 - position, found + 1);
+			group_edges[SLICE_EDGES_COUNT - 1 - found++] = (uint8_t) edge;
+		}
+	}
+
+	return SLICE_PERMUTATION_COUNT * combination + rba_rank_permutation(group_edges, SLICE_EDGES_COUNT);
+}
+
+
+/**
+ * Puts the edges of a group at the positions given by their coordinate, the
+ * other positions are left as is
+ *
+ * @param edges - the edge at each position
+ *
+ * @param sorted - the coordinate of the positions and order of the group, see
+ * 	rba_get_edges_sorted()
+ *
+ * @param first_edge - the first edge of the group
+ */
+static void rba_place_edges(uint8_t edges[], unsigned int sorted, unsigned int first_edge)
+{
+	uint8_t group_edges[SLICE_EDGES_COUNT];
+	unsigned int combination = sorted / SLICE_PERMUTATION_COUNT;
+	int remaining = SLICE_EDGES_COUNT - 1;
+	size_t position;
+
+	rba_unrank_permutation(group_edges, SLICE_EDGES_COUNT, sorted % SLICE_PERMUTATION_COUNT);
+
+	for (position = 0; (position < EDGES_COUNT) && (remaining >= 0); position++)
+	{
+		unsigned int skipped = rba_binomial(EDGES_COUNT - 1 - position, remaining + 1);
+
+		if (combination >= skipped)
+		{
+			edges[position] = (uint8_t) (group_edges[SLICE_EDGES_COUNT - 1 - remaining] + first_edge);
+			combination -= skipped;
+			remaining--;
+		}
+	}
+}
+
+
+/**
+ * Sets the coordinate of the positions and order of a group of edges, the
+ * other edges are put in order at the other positions
+ *
+ * @param cube - the cube to change
+ *
+ * @param sorted - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ *
+ * @param first_edge - the first edge of the group
+ */
+static void rba_set_edges_sorted(struct rba_cubie_cube * cube, unsigned int sorted, unsigned int first_edge)
+{
+	unsigned int other_edge = 0;
+	size_t position;
+
+	memset(cube->edge_permutation, NO_EDGE, EDGES_COUNT);
+	rba_place_edges(cube->edge_permutation, sorted, first_edge);
+
+	for (position = 0; position < EDGES_COUNT; position++)
+	{
+		if (cube->edge_permutation[position] != NO_EDGE)
+			continue;
+
+		if (other_edge == first_edge)
+			other_edge += SLICE_EDGES_COUNT;
+		cube->edge_permutation[position] = (uint8_t) other_edge++;
+	}
+}
+
+
+/**
+ * Reads the corners from the stickers of a cube, the color of a sticker being
+ * the face of its center
+ *
+ * @param facelets - the stickers to read, see rba_cube, only those of the
+ * 	corners are read
+ *
+ * @param cube - the cube whose corners to fill, output
+ *
+ * @return - 1 if every corner is found and their twists add up, 0 otherwise
+ */
+static int rba_read_corners(uint8_t const facelets[], struct rba_cubie_cube * cube)
+{
+	unsigned int found_corners = 0;
+	unsigned int twist = 0;
+	size_t position;
+
+	for (position = 0; position < CORNERS_COUNT; position++)
+	{
+		uint8_t const * stickers = corner_facelets[position];
+		size_t orientation;
+		size_t corner;
+
+		/* the U or D sticker tells the twist */
+		for (orientation = 0; orientation < CORNER_FACELETS_COUNT; orientation++)
+		{
+			uint8_t color = facelets[stickers[orientation]];
+
+			if ((color == UP_FACE) || (color == DOWN_FACE))
+				break;
+		}
+		if (orientation == CORNER_FACELETS_COUNT)
+			return 0;
+
+		for (corner = 0; corner < CORNERS_COUNT; corner++)
+		{
+			if ((facelets[stickers[(orientation + 1) % 3]] == corner_facelets[corner][1] / FACE_FACELETS_COUNT)
+				&& (facelets[stickers[(orientation + 2) % 3]] == corner_facelets[corner][2] / FACE_FACELETS_COUNT))
+				break;
+		}
+		if (corner == CORNERS_COUNT)
+			return 0;
+
+		cube->corner_permutation[position] = (uint8_t) corner;
+		cube->corner_orientation[position] = (uint8_t) orientation;
+		found_corners |= 1u << corner;
+		twist += orientation;
+	}
+
+	return (found_corners == (1u << CORNERS_COUNT) - 1) && (twist % 3 == 0);
+}
+
+
+void rba_init_cubie_cube(struct rba_cubie_cube * cube)
+{
+	size_t position;
+
+	for (position = 0; position < CORNERS_COUNT; position++)
+	{
+		cube->corner_permutation[position] = (uint8_t) position;
+		cube->corner_orientation[position] = 0;
+	}
+
+	for (position = 0; position < EDGES_COUNT; position++)
+	{
+		cube->edge_permutation[position] = (uint8_t) position;
+		cube->edge_orientation[position] = 0;
+	}
+}
+
+
+void rba_apply_face_move(struct rba_cubie_cube * cube, unsigned int move)
+{
+	struct rba_cubie_cube product;
+
+	rba_multiply_cubie_cubes(cube, rba_face_move_cubies + move, & product);
+	* cube = product;
+}
+
+
+void rba_write_cubie_cube(struct rba_cubie_cube const * cube, uint8_t facelets[])
+{
+	size_t position;
+	size_t sticker;
+
+	for (position = 0; position < FACES_COUNT; position++)
+		facelets[FACE_FACELETS_COUNT * position + FACE_FACELETS_COUNT / 2] = (uint8_t) position;
+
+	for (position = 0; position < CORNERS_COUNT; position++)
+	{
+		uint8_t const * corner_stickers = corner_facelets[cube->corner_permutation[position]];
+
+		for (sticker = 0; sticker < CORNER_FACELETS_COUNT; sticker++)
+		{
+			size_t rotated = (sticker + cube->corner_orientation[position]) % CORNER_FACELETS_COUNT;
+
+			facelets[corner_facelets[position][rotated]] = corner_stickers[sticker] / FACE_FACELETS_COUNT;
+		}
+	}
+
+	for (position = 0; position < EDGES_COUNT; position++)
+	{
+		uint8_t const * edge_stickers = edge_facelets[cube->edge_permutation[position]];
+
+		for (sticker = 0; sticker < EDGE_FACELETS_COUNT; sticker++)
+		{
+			size_t flipped = (sticker + cube->edge_orientation[position]) % EDGE_FACELETS_COUNT;
+
+			facelets[edge_facelets[position][flipped]] = edge_stickers[sticker] / FACE_FACELETS_COUNT;
+		}
+	}
+}
+
+
+int rba_read_cube(struct rba_cube const * cube, struct rba_cubie_cube * cubie_cube)
+{
+	uint8_t center_faces[FACES_COUNT];
+	uint8_t facelets[FACELETS_COUNT];
+	unsigned int found_centers = 0;
+	size_t facelet;
+	size_t face;
+
+	/* slice moves move the centers, colors are read relative to them */
+	memset(center_faces, FACES_COUNT, sizeof(center_faces));
+	for (face = 0; face < FACES_COUNT; face++)
+	{
+		uint8_t color = cube->facelets[FACE_FACELETS_COUNT * face + FACE_FACELETS_COUNT / 2];
+
+		if (color >= FACES_COUNT)
+			return 0;
+
+		center_faces[color] = (uint8_t) face;
+		found_centers |= 1u << color;
+	}
+	if (found_centers != (1u << FACES_COUNT) - 1)
+		return 0;
+
+	for (facelet = 0; facelet < FACELETS_COUNT; facelet++)
+	{
+		if (cube->facelets[facelet] >= FACES_COUNT)
+			return 0;
+
+		facelets[facelet] = center_faces[cube->facelets[facelet]];
+	}
+
+	return rba_read_cubie_cube(facelets, cubie_cube);
+}
+
+
+int rba_read_pocket_cube(struct rba_cube const * cube, struct rba_cubie_cube * cubie_cube)
+{
+	uint8_t color_faces[FACES_COUNT];
+	uint8_t facelets[FACELETS_COUNT];
+	unsigned int found_colors = 0;
+	size_t position;
+	size_t sticker;
+
+	/* the D-B-L corner gives 3 faces, the opposite colors give the others */
+	for (sticker = 0; sticker < CORNER_FACELETS_COUNT; sticker++)
+	{
+		uint8_t color = cube->facelets[corner_facelets[DBL_CORNER][sticker]];
+		uint8_t face = corner_facelets[DBL_CORNER][sticker] / FACE_FACELETS_COUNT;
+
+		if (color >= FACES_COUNT)
+			return 0;
+
+		color_faces[color] = face;
+		color_faces[(color + FACES_COUNT / 2) % FACES_COUNT] = (uint8_t) ((face + FACES_COUNT / 2) % FACES_COUNT);
+		found_colors |= (1u << color) | (1u << ((color + FACES_COUNT / 2) % FACES_COUNT));
+	}
+	if (found_colors != (1u << FACES_COUNT) - 1)
+		return 0;
+
+	memset(facelets, 0, sizeof(facelets));
+	for (position = 0; position < CORNERS_COUNT; position++)
+	{
+		for (sticker = 0; sticker < CORNER_FACELETS_COUNT; sticker++)
+		{
+			uint8_t color = cube->facelets[corner_facelets[position][sticker]];
+
+			if (color >= FACES_COUNT)
+				return 0;
+
+			facelets[corner_facelets[position][sticker]] = color_faces[color];
+		}
+	}
+
+	rba_init_cubie_cube(cubie_cube);
+
+	return rba_read_corners(facelets, cubie_cube);
+}
+
+
+int rba_read_cubie_cube(uint8_t const facelets[], struct rba_cubie_cube * cube)
+{
+	unsigned int found_edges = 0;
+	unsigned int flip = 0;
+	size_t position;
+
+	if (! rba_read_corners(facelets, cube))
+		return 0;
+
+	for (position = 0; position < EDGES_COUNT; position++)
+	{
+		uint8_t first_color = facelets[edge_facelets[position][0]];
+		uint8_t second_color = facelets[edge_facelets[position][1]];
+		size_t edge;
+
+		for (edge = 0; edge < EDGES_COUNT; edge++)
+		{
+			uint8_t edge_first_color = edge_facelets[edge][0] / FACE_FACELETS_COUNT;
+			uint8_t edge_second_color = edge_facelets[edge][1] / FACE_FACELETS_COUNT;
+
+			if ((first_color == edge_first_color) && (second_color == edge_second_color))
+			{
+				cube->edge_orientation[position] = 0;
+				break;
+			}
+			if ((first_color == edge_second_color) && (second_color == edge_first_color))
+			{
+				cube->edge_orientation[position] = 1;
+				break;
+			}
+		}
+		if (edge == EDGES_COUNT)
+			return 0;
+
+		cube->edge_permutation[position] = (uint8_t) edge;
+		found_edges |= 1u << edge;
+		flip += cube->edge_orientation[position];
+	}
+
+	return (found_edges == (1u << EDGES_COUNT) - 1)
+		&& (flip % 2 == 0)
+		&& (rba_permutation_parity(cube->corner_permutation, CORNERS_COUNT)
+			== rba_permutation_parity(cube->edge_permutation, EDGES_COUNT));
+}
+
+
+void rba_random_cubie_cube(struct rba_context * context, struct rba_cubie_cube * cube)
+{
+	unsigned int twist = 0;
+	unsigned int flip = 0;
+	int corners_parity;
+	int edges_parity;
+	size_t position;
+
+	rba_init_cubie_cube(cube);
+	corners_parity = rba_shuffle(context, cube->corner_permutation, CORNERS_COUNT);
+	edges_parity = rba_shuffle(context, cube->edge_permutation, EDGES_COUNT);
+
+	/* odd permutations of the edges are swapped with even ones, and the
+	 * other way around, so the parities match without bias */
+	if (corners_parity != edges_parity)
+	{
+		uint8_t edge = cube->edge_permutation[EDGES_COUNT - 1];
+
+		cube->edge_permutation[EDGES_COUNT - 1] = cube->edge_permutation[EDGES_COUNT - 2];
+		cube->edge_permutation[EDGES_COUNT - 2] = edge;
+	}
+
+	/* the last orientations are set by the others */
+	for (position = 0; position < CORNERS_COUNT - 1; position++)
+	{
+		cube->corner_orientation[position] = (uint8_t) rba_random_index(context, 3);
+		twist += cube->corner_orientation[position];
+	}
+	cube->corner_orientation[CORNERS_COUNT - 1] = (uint8_t) ((3 - twist % 3) % 3);
+
+	for (position = 0; position < EDGES_COUNT - 1; position++)
+	{
+		cube->edge_orientation[position] = (uint8_t) rba_random_index(context, 2);
+		flip += cube->edge_orientation[position];
+	}
+	cube->edge_orientation[EDGES_COUNT - 1] = (uint8_t) (flip % 2);
+}
+
+
+unsigned int rba_get_twist(struct rba_cubie_cube const * cube)
+{
+	unsigned int twist = 0;
+	size_t position;
+
+	for (position = 0; position < CORNERS_COUNT - 1; position++)
+		twist = 3 * twist + cube->corner_orientation[position];
+
+	return twist;
+}
+
+
+void rba_set_twist(struct rba_cubie_cube * cube, unsigned int twist)
+{
+	unsigned int twist_sum = 0;
+	size_t position;
+
+	for (position = CORNERS_COUNT - 1; position-- > 0;)
+	{
+		cube->corner_orientation[position] = (uint8_t) (twist % 3);
+		twist_sum += twist % 3;
+		twist /= 3;
+	}
+
+	cube->corner_orientation[CORNERS_COUNT - 1] = (uint8_t) ((3 - twist_sum % 3) % 3);
+}
+
+
+unsigned int rba_get_flip(struct rba_cubie_cube const * cube)
+{
+	unsigned int flip = 0;
+	size_t position;
+
+	for (position = 0; position < EDGES_COUNT - 1; position++)
+		flip = 2 * flip + cube->edge_orientation[position];
+
+	return flip;
+}
+
+
+void rba_set_flip(struct rba_cubie_cube * cube, unsigned int flip)
+{
+	unsigned int flip_sum = 0;
+	size_t position;
+
+	for (position = EDGES_COUNT - 1; position-- > 0;)
+	{
+		cube->edge_orientation[position] = (uint8_t) (flip % 2);
+		flip_sum += flip % 2;
+		flip /= 2;
+	}
+
+	cube->edge_orientation[EDGES_COUNT - 1] = (uint8_t) (flip_sum % 2);
+}
+
+
+unsigned int rba_get_slice_sorted(struct rba_cubie_cube const * cube)
+{
+	return rba_get_edges_sorted(cube, FR_EDGE);
+}
+
+
+void rba_set_slice_sorted(struct rba_cubie_cube * cube, unsigned int slice_sorted)
+{
+	rba_set_edges_sorted(cube, slice_sorted, FR_EDGE);
+}
+
+
+unsigned int rba_get_up_edges_sorted(struct rba_cubie_cube const * cube)
+{
+	return rba_get_edges_sorted(cube, UR_EDGE);
+}
+
+
+void rba_set_up_edges_sorted(struct rba_cubie_cube * cube, unsigned int up_edges_sorted)
+{
+	rba_set_edges_sorted(cube, up_edges_sorted, UR_EDGE);
+}
+
+
+unsigned int rba_get_down_edges_sorted(struct rba_cubie_cube const * cube)
+{
+	return rba_get_edges_sorted(cube, DR_EDGE);
+}
+
+
+void rba_set_down_edges_sorted(struct rba_cubie_cube * cube, unsigned int down_edges_sorted)
+{
+	rba_set_edges_sorted(cube, down_edges_sorted, DR_EDGE);
+}
+
+
+unsigned int rba_get_corner_permutation(struct rba_cubie_cube const * cube)
+{
+	return rba_rank_permutation(cube->corner_permutation, CORNERS_COUNT);
+}
+
+
+void rba_set_corner_permutation(struct rba_cubie_cube * cube, unsigned int permutation)
+{
+	rba_unrank_permutation(cube->corner_permutation, CORNERS_COUNT, permutation);
+}
+
+
+unsigned int rba_get_pocket_permutation(struct rba_cubie_cube const * cube)
+{
+	uint8_t corners[CORNERS_COUNT - 1];
+	size_t position;
+
+	/* DRB takes the position and the number of the fixed DBL corner */
+	for (position = 0; position < CORNERS_COUNT - 1; position++)
+	{
+		uint8_t corner = cube->corner_permutation[(position == DBL_CORNER) ? DRB_CORNER : position];
+
+		corners[position] = (uint8_t) ((corner == DRB_CORNER) ? DBL_CORNER : corner);
+	}
+
+	return rba_rank_permutation(corners, CORNERS_COUNT - 1);
+}
+
+
+void rba_set_pocket_permutation(struct rba_cubie_cube * cube, unsigned int permutation)
+{
+	uint8_t corners[CORNERS_COUNT - 1];
+	size_t position;
+
+	rba_unrank_permutation(corners, CORNERS_COUNT - 1, permutation);
+
+	for (position = 0; position < CORNERS_COUNT - 1; position++)
+	{
+		cube->corner_permutation[(position == DBL_CORNER) ? DRB_CORNER : position] =
+			(uint8_t) ((corners[position] == DBL_CORNER) ? DRB_CORNER : corners[position]);
+	}
+	cube->corner_permutation[DBL_CORNER] = DBL_CORNER;
+}
+
+
+unsigned int rba_get_pocket_twist(struct rba_cubie_cube const * cube)
+{
+	unsigned int twist = 0;
+	size_t position;
+
+	for (position = 0; position < DBL_CORNER; position++)
+		twist = 3 * twist + cube->corner_orientation[position];
+
+	return twist;
+}
+
+
+void rba_set_pocket_twist(struct rba_cubie_cube * cube, unsigned int twist)
+{
+	unsigned int twist_sum = 0;
+	size_t position;
+
+	for (position = DBL_CORNER; position-- > 0;)
+	{
+		cube->corner_orientation[position] = (uint8_t) (twist % 3);
+		twist_sum += twist % 3;
+		twist /= 3;
+	}
+
+	cube->corner_orientation[DBL_CORNER] = 0;
+	cube->corner_orientation[DRB_CORNER] = (uint8_t) ((3 - twist_sum % 3) % 3);
+}
+
+
+unsigned int rba_get_edge_permutation(struct rba_cubie_cube const * cube)
+{
+	return rba_rank_permutation(cube->edge_permutation, FR_EDGE);
+}
+
+
+void rba_set_edge_permutation(struct rba_cubie_cube * cube, unsigned int permutation)
+{
+	rba_unrank_permutation(cube->edge_permutation, FR_EDGE, permutation);
+}
+
+
+unsigned int rba_merge_edge_permutation(unsigned int up_edges_sorted, unsigned int down_edges_sorted)
+{
+	uint8_t edges[EDGES_COUNT];
+
+	memset(edges, NO_EDGE, EDGES_COUNT);
+	rba_place_edges(edges, up_edges_sorted, UR_EDGE);
+	rba_place_edges(edges, down_edges_sorted, DR_EDGE);
+
+	return rba_rank_permutation(edges, FR_EDGE);
+}
+
+
+int rba_permutation_parity(uint8_t const elements[], size_t count)
+{
+	int parity = 0;
+	size_t first;
+	size_t second;
+
+	for (first = 0; first < count; first++)
+	{
+		for (second = first + 1; second < count; second++)
+			parity ^= elements[first] > elements[second];
+	}
+
+	return parity;
+}
@@ -0,0 +1,428 @@
+#ifndef RUBIKS_ALGOS_CUBIE_HEADER
+#define RUBIKS_ALGOS_CUBIE_HEADER
+
+#include "random.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of corner and edge cubies
+ */
+#define CORNERS_COUNT 8
+#define EDGES_COUNT 12
+
+
+/**
+ * The number of face moves, the quarter, half and reverse quarter turns of
+ * the 6 faces, the only moves the solver makes
+ */
+#define FACE_MOVES_COUNT 18
+
+
+/**
+ * The number of values of each coordinate, see rba_coordinates for the
+ * others
+ */
+#define SLICE_PERMUTATION_COUNT 24
+#define SLICE_SORTED_COUNT (SLICE_COUNT * SLICE_PERMUTATION_COUNT)
+#define EDGE_PERMUTATION_COUNT 40320
+
+
+/**
+ * The number of values of the coordinates of a 2x2x2 cube, whose D-B-L
+ * corner stays in place: the permutation of the 7 other corners, and the
+ * twists of the 6 first ones
+ */
+#define POCKET_PERMUTATION_COUNT 5040
+#define POCKET_TWIST_COUNT 729
+
+
+/**
+ * The face a face move turns, face moves are ordered by face, U R F D L B,
+ * then by power: quarter turn, half turn, reverse quarter turn
+ */
+#define FACE_MOVE_FACE(move) ((move) / 3)
+
+
+
+
+/**
+ * The corner cubies, named after their position on a solved cube
+ */
+enum rba_corner
+{
+	URF_CORNER, UFL_CORNER, ULB_CORNER, UBR_CORNER,
+	DFR_CORNER, DLF_CORNER, DBL_CORNER, DRB_CORNER
+};
+
+
+/**
+ * The edge cubies, named after their position on a solved cube, the 4 edges
+ * of the equator slice come last
+ */
+enum rba_edge
+{
+	UR_EDGE, UF_EDGE, UL_EDGE, UB_EDGE,
+	DR_EDGE, DF_EDGE, DL_EDGE, DB_EDGE,
+	FR_EDGE, FL_EDGE, BL_EDGE, BR_EDGE
+};
+
+
+
+
+/**
+ * The state of a cube as the position and orientation of its cubies, the
+ * centers are fixed
+ */
+struct rba_cubie_cube
+{
+	/**
+	 * The corner at each corner position
+	 */
+	uint8_t corner_permutation[CORNERS_COUNT];
+
+	/**
+	 * The twist of the corner at each position, 0 to 2
+	 */
+	uint8_t corner_orientation[CORNERS_COUNT];
+
+	/**
+	 * The edge at each edge position
+	 */
+	uint8_t edge_permutation[EDGES_COUNT];
+
+	/**
+	 * The flip of the edge at each position, 0 or 1
+	 */
+	uint8_t edge_orientation[EDGES_COUNT];
+};
+
+
+
+
+/**
+ * The state of a solved cube after each face move, filled at load time
+ */
+extern struct rba_cubie_cube rba_face_move_cubies[FACE_MOVES_COUNT];
+
+
+/**
+ * The code of each face move
+ */
+extern rba_move_code const rba_face_move_codes[FACE_MOVES_COUNT];
+
+
+
+
+/**
+ * Puts a cube in its solved state
+ *
+ * @param cube - the cube to reset
+ */
+void rba_init_cubie_cube(struct rba_cubie_cube * cube);
+
+
+/**
+ * Applies a face move to a cube
+ *
+ * @param cube - the cube to turn
+ *
+ * @param move - the face move to apply
+ */
+void rba_apply_face_move(struct rba_cubie_cube * cube, unsigned int move);
+
+
+/**
+ * Writes the stickers of a cube from its cubies, the centers are put in
+ * their solved places
+ *
+ * @param cube - the cube to write
+ *
+ * @param facelets - the stickers, see rba_cube, output
+ */
+void rba_write_cubie_cube(struct rba_cubie_cube const * cube, uint8_t facelets[]);
+
+
+/**
+ * Reads the cubies of a cube, its colors being read relative to its centers,
+ * so cubes turned with slice or wide moves are read as well
+ *
+ * @param cube - the cube to read
+ *
+ * @param cubie_cube - the cubies, output
+ *
+ * @return - 1 if the cube is a reachable state, 0 otherwise
+ */
+int rba_read_cube(struct rba_cube const * cube, struct rba_cubie_cube * cubie_cube);
+
+
+/**
+ * Reads the corners of a cube as a 2x2x2 cube, its colors being read
+ * relative to its D-B-L corner, as a 2x2x2 cube has no centers, the edges
+ * are left solved
+ *
+ * @param cube - the cube to read
+ *
+ * @param cubie_cube - the cubies, output, the D-B-L corner in place
+ *
+ * @return - 1 if the corners are a reachable state, 0 otherwise
+ */
+int rba_read_pocket_cube(struct rba_cube const * cube, struct rba_cubie_cube * cubie_cube);
+
+
+/**
+ * Reads the cubies from the stickers of a cube, the color of a sticker being
+ * the face of its center
+ *
+ * @param facelets - the stickers to read, see rba_cube
+ *
+ * @param cube - the cube to fill, output
+ *
+ * @return - 1 if the stickers describe a reachable state, 0 otherwise
+ */
+int rba_read_cubie_cube(uint8_t const facelets[], struct rba_cubie_cube * cube);
+
+
+/**
+ * Computes the parity of a permutation
+ *
+ * @param elements - the permutation
+ *
+ * @param count - the number of elements
+ *
+ * @return - 1 if the permutation is odd, 0 otherwise
+ */
+int rba_permutation_parity(uint8_t const elements[], size_t count);
+
+
+/**
+ * Draws a state uniformly among the reachable ones
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param cube - the cube to fill, output
+ */
+void rba_random_cubie_cube(struct rba_context * context, struct rba_cubie_cube * cube);
+
+
+/**
+ * Computes the orientation coordinate of the corners
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to TWIST_COUNT - 1
+ */
+unsigned int rba_get_twist(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the orientation coordinate of the corners
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param twist - the coordinate, 0 to TWIST_COUNT - 1
+ */
+void rba_set_twist(struct rba_cubie_cube * cube, unsigned int twist);
+
+
+/**
+ * Computes the orientation coordinate of the edges
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to FLIP_COUNT - 1
+ */
+unsigned int rba_get_flip(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the orientation coordinate of the edges
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param flip - the coordinate, 0 to FLIP_COUNT - 1
+ */
+void rba_set_flip(struct rba_cubie_cube * cube, unsigned int flip);
+
+
+/**
+ * Computes the coordinate of the positions and order of the 4 equator slice
+ * edges
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to SLICE_SORTED_COUNT - 1, divided by
+ * 	SLICE_PERMUTATION_COUNT it gives the positions only, 0 when they are in
+ * 	the slice
+ */
+unsigned int rba_get_slice_sorted(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the coordinate of the positions and order of the 4 equator slice
+ * edges
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param slice_sorted - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ */
+void rba_set_slice_sorted(struct rba_cubie_cube * cube, unsigned int slice_sorted);
+
+
+/**
+ * Computes the coordinate of the positions and order of the 4 edges of the U
+ * face
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ */
+unsigned int rba_get_up_edges_sorted(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the coordinate of the positions and order of the 4 edges of the U face
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param up_edges_sorted - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ */
+void rba_set_up_edges_sorted(struct rba_cubie_cube * cube, unsigned int up_edges_sorted);
+
+
+/**
+ * Computes the coordinate of the positions and order of the 4 edges of the D
+ * face
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ */
+unsigned int rba_get_down_edges_sorted(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the coordinate of the positions and order of the 4 edges of the D face
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param down_edges_sorted - the coordinate, 0 to SLICE_SORTED_COUNT - 1
+ */
+void rba_set_down_edges_sorted(struct rba_cubie_cube * cube, unsigned int down_edges_sorted);
+
+
+/**
+ * Computes the permutation coordinate of the corners
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to CORNER_PERMUTATION_COUNT - 1
+ */
+unsigned int rba_get_corner_permutation(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the permutation coordinate of the corners
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param permutation - the coordinate, 0 to CORNER_PERMUTATION_COUNT - 1
+ */
+void rba_set_corner_permutation(struct rba_cubie_cube * cube, unsigned int permutation);
+
+
+/**
+ * Computes the permutation coordinate of the corners of a 2x2x2 cube, the
+ * D-B-L corner being in place
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to POCKET_PERMUTATION_COUNT - 1
+ */
+unsigned int rba_get_pocket_permutation(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the permutation coordinate of the corners of a 2x2x2 cube, the D-B-L
+ * corner being put in place
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param permutation - the coordinate, 0 to POCKET_PERMUTATION_COUNT - 1
+ */
+void rba_set_pocket_permutation(struct rba_cubie_cube * cube, unsigned int permutation);
+
+
+/**
+ * Computes the orientation coordinate of the corners of a 2x2x2 cube, the
+ * D-B-L corner being in place
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to POCKET_TWIST_COUNT - 1
+ */
+unsigned int rba_get_pocket_twist(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the orientation coordinate of the corners of a 2x2x2 cube, the D-B-L
+ * corner being untwisted
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param twist - the coordinate, 0 to POCKET_TWIST_COUNT - 1
+ */
+void rba_set_pocket_twist(struct rba_cubie_cube * cube, unsigned int twist);
+
+
+/**
+ * Computes the permutation coordinate of the 8 edges of the U and D faces
+ *
+ * @param cube - the cube to read
+ *
+ * @return - the coordinate, 0 to EDGE_PERMUTATION_COUNT - 1, only
+ * 	meaningful when these edges are all on the U and D faces
+ */
+unsigned int rba_get_edge_permutation(struct rba_cubie_cube const * cube);
+
+
+/**
+ * Sets the permutation coordinate of the 8 edges of the U and D faces
+ * Other cubies are left as is
+ *
+ * @param cube - the cube to change
+ *
+ * @param permutation - the coordinate, 0 to EDGE_PERMUTATION_COUNT - 1
+ */
+void rba_set_edge_permutation(struct rba_cubie_cube * cube, unsigned int permutation);
+
+
+/**
+ * Computes the permutation coordinate of the 8 edges of the U and D faces
+ * from the coordinates of the edges of each face, so it can be followed
+ * with move tables while these edges are not all on the U and D faces yet
+ *
+ * @param up_edges_sorted - the coordinate of the edges of the U face
+ *
+ * @param down_edges_sorted - the coordinate of the edges of the D face
+ *
+ * @return - the coordinate, 0 to EDGE_PERMUTATION_COUNT - 1, the 8 edges
+ * 	must be on the U and D faces
+ */
+unsigned int rba_merge_edge_permutation(unsigned int up_edges_sorted, unsigned int down_edges_sorted);
+
+
+
+
+#endif /* RUBIKS_ALGOS_CUBIE_HEADER */
@@ -0,0 +1,69 @@
+#include "moves.h"
+
+
+
+
+rba_move const rba_moves_by_code[MOVE_CODES_COUNT] =
+{
+	LAYER_MOVES(LEFT_LAYER), LAYER_MOVES(MIDDLE_LAYER), LAYER_MOVES(RIGHT_LAYER),
+	LAYER_MOVES(TOP_LAYER), LAYER_MOVES(EQUATOR_LAYER), LAYER_MOVES(BOTTOM_LAYER),
+	LAYER_MOVES(FRONT_LAYER), LAYER_MOVES(STANDING_LAYER), LAYER_MOVES(BACK_LAYER),
+
+	LAYER_MOVES(LEFT_LAYERS), LAYER_MOVES(RIGHT_LAYERS),
+	LAYER_MOVES(TOP_LAYERS), LAYER_MOVES(BOTTOM_LAYERS),
+	LAYER_MOVES(FRONT_LAYERS), LAYER_MOVES(BACK_LAYERS)
+};
+
+
+struct rba_layer_rotation const rba_layer_rotations[LAYERS_COUNT] =
+{
+	/* L */ { 0, 0x1, 3 }, /* M */ { 0, 0x2, 3 }, /* R */ { 0, 0x4, 1 },
+	/* U */ { 1, 0x4, 1 }, /* E */ { 1, 0x2, 3 }, /* D */ { 1, 0x1, 3 },
+	/* F */ { 2, 0x4, 1 }, /* S */ { 2, 0x2, 1 }, /* B */ { 2, 0x1, 3 },
+	/* l */ { 0, 0x3, 3 }, /* r */ { 0, 0x6, 1 },
+	/* u */ { 1, 0x6, 1 }, /* d */ { 1, 0x3, 3 },
+	/* f */ { 2, 0x6, 1 }, /* b */ { 2, 0x3, 3 }
+};
+
+
+int const rba_modifier_turns[3] = { 1, 3, 2 };
+
+
+/**
+ * Computes the code of the move turning a layer the other way
+ *
+ * @param move - the code of the move to revert
+ *
+ * @return - the code of the reverting move
+ */
+static rba_move_code rba_reverse_move(rba_move_code move)
+{
+	switch (move % 3)
+	{
+		case NO_MODIFIER:
+			return (rba_move_code) (move + 1);
+
+		case REVERSE_MODIFIER:
+			return (rba_move_code) (move - 1);
+
+		default:
+			return move;
+	}
+}
+
+
+void rba_reverse_moves(rba_move_code moves[], size_t count)
+{
+	size_t index;
+
+	for (index = 0; index < count / 2; index++)
+	{
+		rba_move_code move = moves[index];
+
+		moves[index] = rba_reverse_move(moves[count - 1 - index]);
+		moves[count - 1 - index] = rba_reverse_move(move);
+	}
+
+	if (count % 2 == 1)
+		moves[count / 2] = rba_reverse_move(moves[count / 2]);
+}
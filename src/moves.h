@@ -0,0 +1,204 @@
+#ifndef RUBIKS_ALGOS_MOVES_HEADER
+#define RUBIKS_ALGOS_MOVES_HEADER
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The modifiers which can be applied to a move
+ */
+enum rba_modifier
+{
+	/**
+	 * Plain layer rotation
+	 */
+	NO_MODIFIER = 0x0,
+
+	/**
+	 * Rotate the layer in opposite direction
+	 */
+	REVERSE_MODIFIER = 0x1,
+
+	/**
+	 * Rotate the layer twice
+	 */
+	DOUBLE_MODIFIER = 0x2,
+
+	/**
+	 * Bit-mask to extract the modifier from a move
+	 */
+	MODIFIER_MASK = 0x3
+};
+
+
+/**
+ * The 3 orthogonal axes the layers can rotate around
+ */
+enum rba_axis
+{
+	/**
+	 * No axis yet, eg. before the first move of a scramble
+	 */
+	NO_AXIS = 0x0,
+
+	X_AXIS = 0x4,
+	Y_AXIS = 0x8,
+	Z_AXIS = 0x10,
+
+	/**
+	 * Bit-mask to extract the axis from a move
+	 */
+	AXIS_MASK = 0x1C
+};
+
+
+/**
+ * The 9 layers composing the cube, the corresponding axis in embedded inside
+ */
+enum rba_layer
+{
+	LEFT_LAYER = 0x20 | X_AXIS,
+	MIDDLE_LAYER = 0x40 | X_AXIS,
+	RIGHT_LAYER = 0x80 | X_AXIS,
+
+	TOP_LAYER = 0x100 | Y_AXIS,
+	EQUATOR_LAYER = 0x200 | Y_AXIS,
+	BOTTOM_LAYER = 0x400 | Y_AXIS,
+
+	FRONT_LAYER = 0x800 | Z_AXIS,
+	STANDING_LAYER = 0x1000 | Z_AXIS,
+	BACK_LAYER = 0x2000 | Z_AXIS,
+
+	/* If USE_WIDE_MOVES option is enabled */
+	LEFT_LAYERS = LEFT_LAYER | MIDDLE_LAYER,
+	BUT_MIDDLE_LAYER = LEFT_LAYER | RIGHT_LAYER,
+	RIGHT_LAYERS = RIGHT_LAYER | MIDDLE_LAYER,
+	TOP_LAYERS = TOP_LAYER | EQUATOR_LAYER,
+	BUT_EQUATOR_LAYER = TOP_LAYER | BOTTOM_LAYER,
+	BOTTOM_LAYERS = BOTTOM_LAYER | EQUATOR_LAYER,
+	FRONT_LAYERS = FRONT_LAYER | STANDING_LAYER,
+	BUT_STANDING_LAYER = FRONT_LAYER | BACK_LAYER,
+	BACK_LAYERS = BACK_LAYER | STANDING_LAYER,
+
+	LAYER_MASK = 0x3FE0 | AXIS_MASK
+};
+
+
+/**
+ * At least 16 bits
+ */
+typedef unsigned int rba_move;
+
+
+
+/**
+ * The position of each layer in move codes, see rba_move_code
+ */
+enum rba_layer_index
+{
+	LEFT_LAYER_INDEX, MIDDLE_LAYER_INDEX, RIGHT_LAYER_INDEX,
+	TOP_LAYER_INDEX, EQUATOR_LAYER_INDEX, BOTTOM_LAYER_INDEX,
+	FRONT_LAYER_INDEX, STANDING_LAYER_INDEX, BACK_LAYER_INDEX,
+
+	/* If USE_WIDE_MOVES option is enabled */
+	LEFT_LAYERS_INDEX, RIGHT_LAYERS_INDEX,
+	TOP_LAYERS_INDEX, BOTTOM_LAYERS_INDEX,
+	FRONT_LAYERS_INDEX, BACK_LAYERS_INDEX
+};
+
+
+/**
+ * How the layers of a move rotate
+ */
+struct rba_layer_rotation
+{
+	/**
+	 * The axis the layers rotate around, 0 for x, 1 for y, 2 for z
+	 */
+	int axis;
+
+	/**
+	 * The rotated layers along the axis, bit 0 for the negative side, bit 1
+	 * for the middle and bit 2 for the positive side
+	 */
+	int layers;
+
+	/**
+	 * The number of clockwise quarter turns, as seen from the positive side
+	 * of the axis
+	 */
+	int quarter_turns;
+};
+
+
+
+
+/**
+ * The number of layers of move codes, wide layers included
+ */
+#define LAYERS_COUNT (MOVE_CODES_COUNT / 3)
+
+
+/**
+ * Encodes a move from the index of its layer and its modifier
+ */
+#define MOVE_CODE(layer_index, modifier) ((rba_move_code) (3 * (layer_index) + (modifier)))
+
+
+/**
+ * The 3 moves which can be made with a layer
+ */
+#define LAYER_MOVES(layer) \
+	(layer), \
+	(layer) | REVERSE_MODIFIER, \
+	(layer) | DOUBLE_MODIFIER
+
+
+/**
+ * The codes of the 3 moves which can be made with a layer
+ */
+#define LAYER_CODES(layer_index) \
+	MOVE_CODE(layer_index, NO_MODIFIER), \
+	MOVE_CODE(layer_index, REVERSE_MODIFIER), \
+	MOVE_CODE(layer_index, DOUBLE_MODIFIER)
+
+
+
+
+/**
+ * Decodes each move code, indexed by code
+ */
+extern rba_move const rba_moves_by_code[MOVE_CODES_COUNT];
+
+
+/**
+ * The rotation of each layer, indexed by rba_layer_index
+ * x points to R, y to U and z to F, M follows L, E follows D and S follows F
+ */
+extern struct rba_layer_rotation const rba_layer_rotations[LAYERS_COUNT];
+
+
+/**
+ * The number of quarter turns made by each modifier, indexed by rba_modifier
+ */
+extern int const rba_modifier_turns[3];
+
+
+
+
+/**
+ * Turns a sequence of moves into the sequence reverting it: the moves are
+ * put in reverse order and turned the other way
+ *
+ * @param moves - the codes of the moves to revert, reverted in place
+ *
+ * @param count - the number of moves
+ */
+void rba_reverse_moves(rba_move_code moves[], size_t count);
+
+
+
+
+#endif /* RUBIKS_ALGOS_MOVES_HEADER */
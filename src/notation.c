@@ -0,0 +1,399 @@
+#include <string.h>
+
+#include "attributes.h"
+#include "notation.h"
+
+#include "../include/rubiks_algos.h"
+
+#ifdef __SSE2__
+#	include <emmintrin.h>
+#endif
+
+
+
+
+/**
+ * The number of bytes copied at once for each move, the longest move and its
+ * separator fit in it
+ */
+#define TOKEN_SIZE 4
+
+
+/**
+ * The number of bytes scanned at once for separators
+ */
+#define BLOCK_SIZE 64
+
+
+/**
+ * The number of bytes read past a block, for the modifier and the separator
+ * of a move starting on its last byte
+ */
+#define BLOCK_OVERREAD 2
+
+
+/**
+ * The symbols allowed between moves
+ */
+#define SEPARATORS " \t\n\v\f\r"
+
+
+/**
+ * The number of entries of the symbol tables, 1 per byte value
+ */
+#define SYMBOLS_COUNT 256
+
+
+/**
+ * Marks a symbol with no meaning at its position in the symbol tables
+ */
+#define INVALID_SYMBOL 0x80
+
+
+/**
+ * The 3 tokens of a layer, followed by their separator
+ */
+#define LAYER_TOKENS(symbol) \
+	{ symbol " ", 2 }, \
+	{ symbol "' ", 3 }, \
+	{ symbol "2 ", 3 }
+
+
+
+
+/**
+ * A move pre-rendered in singmaster notation, followed by a separator
+ */
+struct rba_move_token
+{
+	/**
+	 * The symbols of the move and the separator, padded to a fixed size
+	 */
+	char symbols[TOKEN_SIZE];
+
+	/**
+	 * The number of meaningful symbols, separator included
+	 */
+	size_t length;
+};
+
+
+
+
+/**
+ * The token of each move, indexed by code
+ */
+static struct rba_move_token const tokens[MOVE_CODES_COUNT] =
+{
+	LAYER_TOKENS("L"), LAYER_TOKENS("M"), LAYER_TOKENS("R"),
+	LAYER_TOKENS("U"), LAYER_TOKENS("E"), LAYER_TOKENS("D"),
+	LAYER_TOKENS("F"), LAYER_TOKENS("S"), LAYER_TOKENS("B"),
+
+	LAYER_TOKENS("l"), LAYER_TOKENS("r"),
+	LAYER_TOKENS("u"), LAYER_TOKENS("d"),
+	LAYER_TOKENS("f"), LAYER_TOKENS("b")
+};
+
+
+
+/**
+ * The layer code of each symbol, or INVALID_SYMBOL, filled at load time
+ */
+static uint8_t layer_codes[SYMBOLS_COUNT];
+
+
+/**
+ * The modifier of each symbol following a layer, NO_MODIFIER for separators,
+ * or INVALID_SYMBOL, filled at load time
+ */
+static uint8_t modifier_codes[SYMBOLS_COUNT];
+
+
+
+
+/**
+ * Fills the symbol tables of the parser from the tokens of the writer, at
+ * load time
+ */
+CONSTRUCTOR static void rba_init_symbol_tables(void)
+{
+	char const * separator;
+	rba_move_code code;
+
+	memset(layer_codes, INVALID_SYMBOL, sizeof(layer_codes));
+	memset(modifier_codes, INVALID_SYMBOL, sizeof(modifier_codes));
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		char const * symbols = tokens[code].symbols;
+
+		if (code % 3 == NO_MODIFIER)
+			layer_codes[(unsigned char) symbols[0]] = code;
+		else
+			modifier_codes[(unsigned char) symbols[1]] = code % 3;
+	}
+
+	for (separator = SEPARATORS; * separator != '\0'; separator++)
+		modifier_codes[(unsigned char) * separator] = NO_MODIFIER;
+}
+
+
+/**
+ * Flags the separators among 64 bytes
+ *
+ * @param block - the bytes to scan
+ *
+ * @return - a bit-mask, bit i is set if byte i is a separator
+ */
+static uint64_t rba_find_separators(unsigned char const * block)
+{
+	uint64_t separators = 0;
+	size_t offset;
+
+#ifdef __SSE2__
+	__m128i space = _mm_set1_epi8(' ');
+	__m128i below_tab = _mm_set1_epi8('\t' - 1);
+	__m128i above_carriage_return = _mm_set1_epi8('\r' + 1);
+
+	/* ' ' and the 5 control characters from '\t' to '\r' */
+	for (offset = 0; offset < BLOCK_SIZE; offset += 16)
+	{
+		__m128i symbols = _mm_loadu_si128((__m128i const *) (block + offset));
+		__m128i matches = _mm_or_si128(
+			_mm_cmpeq_epi8(symbols, space),
+			_mm_and_si128(
+				_mm_cmpgt_epi8(symbols, below_tab),
+				_mm_cmplt_epi8(symbols, above_carriage_return)));
+
+		separators |= (uint64_t) (unsigned int) _mm_movemask_epi8(matches) << offset;
+	}
+#else
+	for (offset = 0; offset < BLOCK_SIZE; offset++)
+		separators |= (uint64_t) (modifier_codes[block[offset]] == NO_MODIFIER) << offset;
+#endif
+
+	return separators;
+}
+
+
+/**
+ * Locates the first invalid symbol of a move
+ *
+ * @param move - the symbols of the move, followed by a separator if valid
+ *
+ * @return - the position of the invalid symbol in the move, 0 if the move is
+ * 	valid
+ */
+static size_t rba_find_invalid_symbol(unsigned char const * move)
+{
+	if (layer_codes[move[0]] == INVALID_SYMBOL)
+		return 0;
+
+	switch (modifier_codes[move[1]])
+	{
+		case NO_MODIFIER:
+			return 0;
+
+		case INVALID_SYMBOL:
+			return 1;
+
+		default:
+			return (modifier_codes[move[2]] == NO_MODIFIER) ? 0 : 2;
+	}
+}
+
+
+/**
+ * Parses the moves starting in a block of 64 bytes, a move starting on the
+ * last byte of the block is read from the 2 following ones
+ *
+ * @param block - the bytes to parse
+ *
+ * @param block_offset - the position of the block in the sequence
+ *
+ * @param previous_separator - 1 if the byte before the block is a separator,
+ * 	updated for the next block
+ *
+ * @param moves - the buffer to write the codes to
+ *
+ * @param capacity - the number of codes the buffer can store
+ *
+ * @param count - the number of codes already in the buffer, updated
+ *
+ * @param error_offset - the position of the error in the sequence, set on
+ * 	failure
+ *
+ * @return - 1 if the moves are valid and fit in the buffer, 0 otherwise
+ */
+static int rba_parse_block(
+	unsigned char const * block,
+	size_t block_offset,
+	uint64_t * previous_separator,
+	rba_move_code * moves,
+	size_t capacity,
+	size_t * count,
+	size_t * error_offset)
+{
+	uint64_t separators = rba_find_separators(block);
+	/* a move starts on each symbol following a separator */
+	uint64_t starts = ~separators & ((separators << 1) | * previous_separator);
+	/* kept local, the codes written below may alias it */
+	size_t parsed_count = * count;
+
+	* previous_separator = separators >> (BLOCK_SIZE - 1);
+
+	while (starts != 0)
+	{
+		size_t start = __builtin_ctzll(starts);
+		unsigned char const * move = block + start;
+		unsigned int layer = layer_codes[move[0]];
+		unsigned int modifier = modifier_codes[move[1]];
+		unsigned int end = modifier_codes[move[1 + (modifier != NO_MODIFIER)]];
+
+		if (((layer | modifier) & INVALID_SYMBOL) || (end != NO_MODIFIER) || (parsed_count == capacity))
+		{
+			* error_offset = block_offset + start + rba_find_invalid_symbol(move);
+			return 0;
+		}
+
+		moves[parsed_count++] = (rba_move_code) (layer + modifier);
+		starts &= starts - 1;
+	}
+
+	* count = parsed_count;
+
+	return 1;
+}
+
+
+size_t rba_compute_max_scramble_string_length(size_t count)
+{
+	return count * MAX_MOVE_LENGTH + count - 1;
+}
+
+
+size_t rba_write_moves(
+	rba_move_code const moves[],
+	size_t count,
+	char * scramble,
+	size_t capacity)
+{
+	char * cursor = scramble;
+	char * end = scramble + capacity;
+	size_t index = 0;
+
+	/* whole tokens are stored while they can't overflow the buffer */
+	for (; (index < count) && (end - cursor >= TOKEN_SIZE); index++)
+	{
+		struct rba_move_token const * token = tokens + moves[index];
+
+		memcpy(cursor, token->symbols, TOKEN_SIZE);
+		cursor += token->length;
+	}
+
+	/* then only their meaningful symbols, near the end of the buffer */
+	for (; index < count; index++)
+	{
+		struct rba_move_token const * token = tokens + moves[index];
+
+		if ((size_t) (end - cursor) < token->length)
+			return 0;
+
+		memcpy(cursor, token->symbols, token->length);
+		cursor += token->length;
+	}
+
+	return cursor - scramble;
+}
+
+
+size_t rba_write_move_codes(
+	rba_move_code const * moves,
+	size_t count,
+	char * buffer,
+	size_t capacity)
+{
+	size_t writen_bytes;
+	size_t index;
+
+	if (count == 0)
+		return 0;
+
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	writen_bytes = rba_write_moves(moves, count, buffer, capacity);
+	if (writen_bytes == 0)
+		return 0;
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
+}
+
+
+size_t rba_parse_scramble(
+	char const * scramble,
+	size_t length,
+	rba_move_code * moves,
+	size_t capacity,
+	size_t * error_offset)
+{
+	unsigned char const * symbols = (unsigned char const *) scramble;
+	unsigned char tail[2 * BLOCK_SIZE + BLOCK_OVERREAD];
+	uint64_t previous_separator = 1;
+	size_t ignored_error_offset;
+	size_t count = 0;
+	size_t offset;
+	size_t tail_offset;
+
+	if (error_offset == NULL)
+		error_offset = & ignored_error_offset;
+	* error_offset = length;
+
+	/* blocks followed by enough bytes to read a move starting on their last byte */
+	for (offset = 0; length - offset >= BLOCK_SIZE + BLOCK_OVERREAD; offset += BLOCK_SIZE)
+	{
+		if (! rba_parse_block(
+			symbols + offset,
+			offset,
+			& previous_separator,
+			moves,
+			capacity,
+			& count,
+			error_offset))
+			return 0;
+	}
+
+	/* the last bytes, copied and padded with separators */
+	memset(tail, ' ', sizeof(tail));
+	memcpy(tail, symbols + offset, length - offset);
+
+	for (tail_offset = 0; offset + tail_offset < length; tail_offset += BLOCK_SIZE)
+	{
+		if (! rba_parse_block(
+			tail + tail_offset,
+			offset + tail_offset,
+			& previous_separator,
+			moves,
+			capacity,
+			& count,
+			error_offset))
+			return 0;
+	}
+
+	return count;
+}
+
+
+size_t rba_read_move_codes(
+	char const * scramble,
+	rba_move_code * moves,
+	size_t capacity)
+{
+	return rba_parse_scramble(scramble, strlen(scramble), moves, capacity, NULL);
+}
@@ -0,0 +1,53 @@
+#ifndef RUBIKS_ALGOS_NOTATION_HEADER
+#define RUBIKS_ALGOS_NOTATION_HEADER
+
+#include "moves.h"
+
+
+
+
+/**
+ * The maximum number of bytes a move takes using singmaster notation, 1 for
+ * the layer and 1 for the modifier
+ */
+#define MAX_MOVE_LENGTH 2
+
+
+
+
+/**
+ * Computes the length of the longest string a scramble of the given length
+ * may require, using singmaster notation
+ *
+ * @param count - the number of moves in the scramble
+ *
+ * @return - the maximum length of the string, without NULL-terminating byte
+ */
+size_t rba_compute_max_scramble_string_length(size_t count);
+
+
+/**
+ * Writes the moves in the given string in a single pass, using singmaster
+ * notation, each move is followed by a separating space
+ *
+ * @param moves - the codes of the moves to write
+ *
+ * @param count - the number of moves to write
+ *
+ * @param scramble - the string to write to
+ *
+ * @param capacity - the number of bytes available in the string
+ *
+ * @return - the number of writen bytes, separators included, or 0 if the
+ * 	moves don't fit
+ */
+size_t rba_write_moves(
+	rba_move_code const moves[],
+	size_t count,
+	char * scramble,
+	size_t capacity);
+
+
+
+
+#endif /* RUBIKS_ALGOS_NOTATION_HEADER */
@@ -0,0 +1,369 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "attributes.h"
+#include "random.h"
+#include "scramble.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of bytes copied at once for each move, the longest move and its
+ * separator fit in it
+ */
+#define NXN_TOKEN_SIZE 8
+
+
+/**
+ * The maximum number of bytes a move takes, eg. [3Rw']
+ */
+#define MAX_NXN_MOVE_LENGTH 4
+
+
+/**
+ * The number of sizes of cubes scrambles are generated for
+ */
+#define NXN_SIZES_COUNT (MAX_NXN_SIZE - MIN_NXN_SIZE + 1)
+
+
+/**
+ * The number of rows of the moves tables, 1 per axis which can be excluded:
+ * none, then the axis of U and D, of R and L, of F and B
+ */
+#define EXCLUDED_AXES_COUNT 4
+
+
+/**
+ * The number of codes of the moves of a face
+ */
+#define FACE_CODES_COUNT (3 * MAX_NXN_DEPTH)
+
+
+/**
+ * The 9 tokens of a face, 1 to 3 outer layers deep, followed by their
+ * separator
+ */
+#define FACE_TOKENS(symbol) \
+	{ symbol " ", 2 }, \
+	{ symbol "' ", 3 }, \
+	{ symbol "2 ", 3 }, \
+	{ symbol "w ", 3 }, \
+	{ symbol "w' ", 4 }, \
+	{ symbol "w2 ", 4 }, \
+	{ "3" symbol "w ", 4 }, \
+	{ "3" symbol "w' ", 5 }, \
+	{ "3" symbol "w2 ", 5 }
+
+
+
+
+/**
+ * A move pre-rendered in WCA notation, followed by a separator
+ */
+struct rba_nxn_move_token
+{
+	/**
+	 * The symbols of the move and the separator, padded to a fixed size
+	 */
+	char symbols[NXN_TOKEN_SIZE];
+
+	/**
+	 * The number of meaningful symbols, separator included
+	 */
+	size_t length;
+};
+
+
+/**
+ * The moves which can follow a move on a given axis, so the next move is
+ * picked with a single random draw
+ */
+struct rba_nxn_moves_set
+{
+	/**
+	 * The number of legal moves
+	 */
+	uint32_t count;
+
+	/**
+	 * The codes of the legal moves, in any order
+	 */
+	rba_nxn_move_code moves[NXN_MOVE_CODES_COUNT];
+};
+
+
+
+
+/**
+ * The token of each move, indexed by code
+ */
+static struct rba_nxn_move_token const nxn_tokens[NXN_MOVE_CODES_COUNT] =
+{
+	FACE_TOKENS("U"), FACE_TOKENS("R"), FACE_TOKENS("F"),
+	FACE_TOKENS("D"), FACE_TOKENS("L"), FACE_TOKENS("B")
+};
+
+
+/**
+ * Legal moves after a move on each axis, for each size of cube, filled at
+ * load time
+ */
+static struct rba_nxn_moves_set nxn_moves_after_axis[NXN_SIZES_COUNT][EXCLUDED_AXES_COUNT];
+
+
+/**
+ * The row of the moves tables excluding the axis of each move, filled at load
+ * time
+ */
+static uint8_t excluded_axis_rows[NXN_MOVE_CODES_COUNT];
+
+
+
+
+/**
+ * Fills the moves tables of every size of cube, at load time
+ * A cube of size N is turned by blocks of 1 to N / 2 outer layers, the block
+ * of half an even cube is only turned from U, R and F, the same block turned
+ * from the opposite face being a rotation away
+ */
+CONSTRUCTOR static void rba_init_nxn_moves(void)
+{
+	size_t size;
+	size_t code;
+
+	for (code = 0; code < NXN_MOVE_CODES_COUNT; code++)
+		excluded_axis_rows[code] = (uint8_t) (1 + code / FACE_CODES_COUNT % (FACES_COUNT / 2));
+
+	for (size = MIN_NXN_SIZE; size <= MAX_NXN_SIZE; size++)
+	{
+		struct rba_nxn_moves_set * moves_after_axis = nxn_moves_after_axis[size - MIN_NXN_SIZE];
+		size_t row;
+
+		for (code = 0; code < NXN_MOVE_CODES_COUNT; code++)
+		{
+			size_t face = code / FACE_CODES_COUNT;
+			size_t depth = code % FACE_CODES_COUNT / 3 + 1;
+
+			if ((depth > size / 2) || ((size % 2 == 0) && (depth == size / 2) && (face >= FACES_COUNT / 2)))
+				continue;
+
+			for (row = 0; row < EXCLUDED_AXES_COUNT; row++)
+			{
+				struct rba_nxn_moves_set * legal_moves = moves_after_axis + row;
+
+				if (row != excluded_axis_rows[code])
+					legal_moves->moves[legal_moves->count++] = (rba_nxn_move_code) code;
+			}
+		}
+	}
+}
+
+
+/**
+ * Generates moves of a scramble, continuing after the given row
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param moves_after_axis - the moves tables of the size of the cube
+ *
+ * @param moves - the buffer to write the codes of the moves to
+ *
+ * @param count - the number of moves to generate
+ *
+ * @param row - the row excluding the axis of the move preceding the first
+ * 	generated one, 0 if there is none
+ *
+ * @return - the row excluding the axis of the last generated move
+ */
+static size_t rba_generate_nxn_moves(
+	struct rba_context * context,
+	struct rba_nxn_moves_set const moves_after_axis[],
+	rba_nxn_move_code moves[],
+	size_t count,
+	size_t row)
+{
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		struct rba_nxn_moves_set const * legal_moves = moves_after_axis + row;
+
+		moves[index] = legal_moves->moves[rba_random_index(context, legal_moves->count)];
+		row = excluded_axis_rows[moves[index]];
+	}
+
+	return row;
+}
+
+
+/**
+ * Writes moves in the given string in a single pass, using WCA notation,
+ * each move is followed by a separating space
+ *
+ * @param moves - the codes of the moves to write, all valid
+ *
+ * @param count - the number of moves to write
+ *
+ * @param scramble - the string to write to
+ *
+ * @param capacity - the number of bytes available in the string
+ *
+ * @return - the number of writen bytes, separators included, or 0 if the
+ * 	moves don't fit
+ */
+static size_t rba_write_nxn_moves(
+	rba_nxn_move_code const moves[],
+	size_t count,
+	char * scramble,
+	size_t capacity)
+{
+	char * cursor = scramble;
+	char * end = scramble + capacity;
+	size_t index = 0;
+
+	/* whole tokens are stored while they can't overflow the buffer */
+	for (; (index < count) && (end - cursor >= NXN_TOKEN_SIZE); index++)
+	{
+		struct rba_nxn_move_token const * token = nxn_tokens + moves[index];
+
+		memcpy(cursor, token->symbols, NXN_TOKEN_SIZE);
+		cursor += token->length;
+	}
+
+	/* then only their meaningful symbols, near the end of the buffer */
+	for (; index < count; index++)
+	{
+		struct rba_nxn_move_token const * token = nxn_tokens + moves[index];
+
+		if ((size_t) (end - cursor) < token->length)
+			return 0;
+
+		memcpy(cursor, token->symbols, token->length);
+		cursor += token->length;
+	}
+
+	return cursor - scramble;
+}
+
+
+
+
+size_t rba_compute_nxn_scramble_buffer_size(size_t length)
+{
+	if (length == 0)
+		return 0;
+
+	return length * MAX_NXN_MOVE_LENGTH + length;
+}
+
+
+size_t rba_generate_nxn_scramble_moves_r(
+	struct rba_context * context,
+	size_t size,
+	rba_nxn_move_code * moves,
+	size_t length)
+{
+	if ((size < MIN_NXN_SIZE) || (size > MAX_NXN_SIZE))
+		return 0;
+
+	rba_generate_nxn_moves(context, nxn_moves_after_axis[size - MIN_NXN_SIZE], moves, length, 0);
+
+	return length;
+}
+
+
+size_t rba_generate_nxn_scramble_into_r(
+	struct rba_context * context,
+	size_t size,
+	char * buffer,
+	size_t capacity,
+	size_t length)
+{
+	rba_nxn_move_code moves[MOVES_CHUNK_SIZE];
+	size_t writen_bytes = 0;
+	size_t row = 0;
+
+	if ((length == 0) || (capacity == 0) || (size < MIN_NXN_SIZE) || (size > MAX_NXN_SIZE))
+		return 0;
+
+	while (length > 0)
+	{
+		size_t count = length < MOVES_CHUNK_SIZE ? length : MOVES_CHUNK_SIZE;
+		size_t chunk_length;
+
+		row = rba_generate_nxn_moves(context, nxn_moves_after_axis[size - MIN_NXN_SIZE], moves, count, row);
+
+		/* the moves and the separator following the last one */
+		chunk_length = rba_write_nxn_moves(moves, count, buffer + writen_bytes, capacity - writen_bytes);
+		if (chunk_length == 0)
+		{
+			* buffer = '\0';
+			return 0;
+		}
+
+		writen_bytes += chunk_length;
+		length -= count;
+	}
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
+}
+
+
+char * rba_generate_nxn_scramble_r(
+	struct rba_context * context,
+	size_t size,
+	size_t length)
+{
+	size_t capacity = rba_compute_nxn_scramble_buffer_size(length);
+	char * scramble;
+
+	if (capacity == 0)
+		return NULL;
+
+	scramble = malloc(capacity);
+	if (scramble == NULL)
+		return NULL;
+
+	if (rba_generate_nxn_scramble_into_r(context, size, scramble, capacity, length) == 0)
+	{
+		free(scramble);
+		return NULL;
+	}
+
+	return scramble;
+}
+
+
+size_t rba_write_nxn_move_codes(
+	rba_nxn_move_code const * moves,
+	size_t count,
+	char * buffer,
+	size_t capacity)
+{
+	size_t writen_bytes;
+	size_t index;
+
+	if (count == 0)
+		return 0;
+
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= NXN_MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	writen_bytes = rba_write_nxn_moves(moves, count, buffer, capacity);
+	if (writen_bytes == 0)
+		return 0;
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+
+#include "random.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * Draws the next value of a splitmix64 sequence, used to expand a seed into a
+ * full generator state
+ *
+ * @param sequence - the current position in the sequence, updated
+ *
+ * @return - 64 well-mixed bits
+ */
+static uint64_t rba_splitmix64(uint64_t * sequence)
+{
+	uint64_t mixed = (* sequence += UINT64_CONSTANT(0x9E3779B9, 0x7F4A7C15));
+
+	mixed = (mixed ^ (mixed >> 30)) * UINT64_CONSTANT(0xBF58476D, 0x1CE4E5B9);
+	mixed = (mixed ^ (mixed >> 27)) * UINT64_CONSTANT(0x94D049BB, 0x133111EB);
+
+	return mixed ^ (mixed >> 31);
+}
+
+
+/**
+ * Mixes the bits of a value, murmur3 finalizer
+ * Distinct values stay distinct, and 0 stays 0
+ *
+ * @param value - the value to mix
+ *
+ * @return - the mixed value
+ */
+static uint64_t rba_mix64(uint64_t value)
+{
+	value = (value ^ (value >> 33)) * UINT64_CONSTANT(0xFF51AFD7, 0xED558CCD);
+	value = (value ^ (value >> 33)) * UINT64_CONSTANT(0xC4CEB9FE, 0x1A85EC53);
+
+	return value ^ (value >> 33);
+}
+
+
+struct rba_context * rba_create_context(uint64_t seed)
+{
+	struct rba_context * context = malloc(sizeof(* context));
+
+	if (context == NULL)
+		return NULL;
+
+	rba_seed_context(context, seed);
+
+	return context;
+}
+
+
+void rba_destroy_context(struct rba_context * context)
+{
+	free(context);
+}
+
+
+void rba_seed_context(struct rba_context * context, uint64_t seed)
+{
+	rba_seed_context_at(context, seed, 0);
+}
+
+
+void rba_seed_context_at(
+	struct rba_context * context,
+	uint64_t seed,
+	uint64_t index)
+{
+	/* the start of the sequence is derived from the index directly, the
+	 * sequences of previous indexes are never run */
+	uint64_t sequence = seed ^ rba_mix64(index);
+	uint64_t low_bits = rba_splitmix64(& sequence);
+	uint64_t high_bits = rba_splitmix64(& sequence);
+
+	context->state[0] = (uint32_t) low_bits;
+	context->state[1] = (uint32_t) (low_bits >> 32);
+	context->state[2] = (uint32_t) high_bits;
+	context->state[3] = (uint32_t) (high_bits >> 32);
+}
+
+
+void rba_seed_context_from_rand(struct rba_context * context)
+{
+	uint64_t seed = (uint32_t) rand();
+
+	seed = (seed << 32) ^ (uint32_t) rand();
+
+	rba_seed_context(context, seed);
+}
@@ -0,0 +1,112 @@
+#ifndef RUBIKS_ALGOS_RANDOM_HEADER
+#define RUBIKS_ALGOS_RANDOM_HEADER
+
+#include <stdint.h>
+
+#include "attributes.h"
+
+
+
+
+/**
+ * Builds a 64 bits constant from its 2 halves, C89 has no 64 bits literals
+ */
+#define UINT64_CONSTANT(high, low) ((((uint64_t) (high)) << 32) | (low))
+
+
+
+
+/**
+ * A random generator, running xoshiro128**
+ * Each context owns its whole state, so different threads can generate at
+ * full speed with their own context
+ */
+struct rba_context
+{
+	uint32_t state[4];
+};
+
+
+
+
+/**
+ * Seeds the given context from the libc generator, so functions without a
+ * context still depend on srand()
+ *
+ * @param context - the context to seed
+ */
+void rba_seed_context_from_rand(struct rba_context * context);
+
+
+
+
+/**
+ * Rotates the bits of the given value to the left
+ *
+ * @param value - the value to rotate
+ *
+ * @param shift - the number of bits to rotate, in ]0; 32[
+ *
+ * @return - the rotated value
+ */
+static INLINE uint32_t rba_rotate_left(uint32_t value, int shift)
+{
+	return (value << shift) | (value >> (32 - shift));
+}
+
+
+/**
+ * Draws the next 32 random bits of the context
+ *
+ * @param context - the generator to draw from
+ *
+ * @return - 32 random bits
+ */
+static INLINE uint32_t rba_next_random(struct rba_context * context)
+{
+	uint32_t * state = context->state;
+	uint32_t result = rba_rotate_left(state[1] * 5, 7) * 9;
+	uint32_t shifted = state[1] << 9;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= shifted;
+	state[3] = rba_rotate_left(state[3], 11);
+
+	return result;
+}
+
+
+/**
+ * Draws a random index without bias, scaling 32 random bits with a
+ * multiplication rather than reducing them with a division
+ * The few draws landing in the biased zone are rejected, the division
+ * computing this zone is only made when a draw may be in it
+ *
+ * @param context - the generator to draw from
+ *
+ * @param count - the number of possible indexes, not 0
+ *
+ * @return - a random index in [0; count[, all equally likely
+ */
+static INLINE uint32_t rba_random_index(struct rba_context * context, uint32_t count)
+{
+	uint64_t scaled = (uint64_t) rba_next_random(context) * count;
+
+	if ((uint32_t) scaled < count)
+	{
+		uint32_t biased_zone = (0u - count) % count;
+
+		while ((uint32_t) scaled < biased_zone)
+			scaled = (uint64_t) rba_next_random(context) * count;
+	}
+
+	return (uint32_t) (scaled >> 32);
+}
+
+
+
+
+#endif /* RUBIKS_ALGOS_RANDOM_HEADER */
@@ -1,5 +1,13 @@
 
 #include <stdlib.h>
+#include <string.h>
+
+#include "cubie.h"
+#include "random.h"
+#include "moves.h"
+#include "notation.h"
+#include "scramble.h"
+#include "solver.h"
 
 #include "../include/rubiks_algos.h"
 
@@ -7,465 +15,529 @@
 
 
 /**
- * The modifiers which can be applied to a move
+ * The codes of the base moves of each axis
  */
-enum rba_modifier
-{
-	/**
-	 * Plain layer rotation
-	 */
-	NO_MODIFIER = 0x0,
-
-	/**
-	 * Rotate the layer in opposite direction
-	 */
-	REVERSE_MODIFIER = 0x1,
-
-	/**
-	 * Rotate the layer twice
-	 */
-	DOUBLE_MODIFIER = 0x2,
-
-	/**
-	 * Bit-mask to extract the modifier from a move
-	 */
-	MODIFIER_MASK = 0x3
-} rba_modifier;
+#define X_BASE_CODES \
+	LAYER_CODES(LEFT_LAYER_INDEX), \
+	LAYER_CODES(MIDDLE_LAYER_INDEX), \
+	LAYER_CODES(RIGHT_LAYER_INDEX)
+#define Y_BASE_CODES \
+	LAYER_CODES(TOP_LAYER_INDEX), \
+	LAYER_CODES(EQUATOR_LAYER_INDEX), \
+	LAYER_CODES(BOTTOM_LAYER_INDEX)
+#define Z_BASE_CODES \
+	LAYER_CODES(FRONT_LAYER_INDEX), \
+	LAYER_CODES(STANDING_LAYER_INDEX), \
+	LAYER_CODES(BACK_LAYER_INDEX)
 
 
 /**
- * The 3 orthogonal axes the layers can rotate around
+ * The codes of the wide moves of each axis, when USE_WIDE_MOVES is set
  */
-enum rba_axis
-{
-	X_AXIS = 0x4,
-	Y_AXIS = 0x8,
-	Z_AXIS = 0x10,
-
-	/**
-	 * Bit-mask to extract the axis from a move
-	 */
-	AXIS_MASK = 0x1C
-} rba_axis;
+#define X_WIDE_CODES LAYER_CODES(LEFT_LAYERS_INDEX), LAYER_CODES(RIGHT_LAYERS_INDEX)
+#define Y_WIDE_CODES LAYER_CODES(TOP_LAYERS_INDEX), LAYER_CODES(BOTTOM_LAYERS_INDEX)
+#define Z_WIDE_CODES LAYER_CODES(FRONT_LAYERS_INDEX), LAYER_CODES(BACK_LAYERS_INDEX)
 
 
 /**
- * The 9 layers composing the cube, the corresponding axis in embedded inside
+ * The codes of the moves of each axis when POCKET_CUBE is set, the D-B-L
+ * corner staying in place
  */
-enum rba_layer
-{
-	LEFT_LAYER = 0x20 | X_AXIS,
-	MIDDLE_LAYER = 0x40 | X_AXIS,
-	RIGHT_LAYER = 0x80 | X_AXIS,
-
-	TOP_LAYER = 0x100 | Y_AXIS,
-	EQUATOR_LAYER = 0x200 | Y_AXIS,
-	BOTTOM_LAYER = 0x400 | Y_AXIS,
-
-	FRONT_LAYER = 0x800 | Z_AXIS,
-	STANDING_LAYER = 0x1000 | Z_AXIS,
-	BACK_LAYER = 0x2000 | Z_AXIS,
-
-	/* If USE_WIDE_MOVES option is enabled */
-	LEFT_LAYERS = LEFT_LAYER | MIDDLE_LAYER,
-	BUT_MIDDLE_LAYER = LEFT_LAYER | RIGHT_LAYER,
-	RIGHT_LAYERS = RIGHT_LAYER | MIDDLE_LAYER,
-	TOP_LAYERS = TOP_LAYER | EQUATOR_LAYER,
-	BUT_EQUATOR_LAYER = TOP_LAYER | BOTTOM_LAYER,
-	BOTTOM_LAYERS = BOTTOM_LAYER | EQUATOR_LAYER,
-	FRONT_LAYERS = FRONT_LAYER | STANDING_LAYER,
-	BUT_STANDING_LAYER = FRONT_LAYER | BACK_LAYER,
-	BACK_LAYERS = BACK_LAYER | STANDING_LAYER,
-
-	LAYER_MASK = 0x3FE0 | AXIS_MASK
-} rba_layer;
+#define X_POCKET_CODES LAYER_CODES(RIGHT_LAYER_INDEX)
+#define Y_POCKET_CODES LAYER_CODES(TOP_LAYER_INDEX)
+#define Z_POCKET_CODES LAYER_CODES(FRONT_LAYER_INDEX)
 
 
 /**
- * At least 16 bits
+ * The number of rows of the moves tables, 1 per axis which can be excluded
+ * NO_AXIS, X_AXIS, Y_AXIS and Z_AXIS
  */
-typedef unsigned int rba_move;
+#define EXCLUDED_AXES_COUNT 4
 
 
 
 
 /**
- * Available layers when no options enabled
+ * The moves which can follow a move on a given axis, so the next move is
+ * picked with a single random draw, instead of retrying until a move on
+ * another axis comes out
  */
-static enum rba_layer layers[] =
+struct rba_moves_set
 {
-	LEFT_LAYER, MIDDLE_LAYER, RIGHT_LAYER,
-	TOP_LAYER, EQUATOR_LAYER, BOTTOM_LAYER,
-	FRONT_LAYER, STANDING_LAYER, BACK_LAYER,
-
-	/* When USE_WIDE_MOVES is set */
-	LEFT_LAYERS, RIGHT_LAYERS,
-	TOP_LAYERS, BOTTOM_LAYERS,
-	FRONT_LAYERS, BACK_LAYERS,
+	/**
+	 * The number of legal moves
+	 */
+	uint32_t count;
+
+	/**
+	 * The codes of the legal moves, in any order
+	 */
+	rba_move_code moves[MOVE_CODES_COUNT];
 };
 
 
 
 
 /**
- * Picks a random base layer, wide moves are excluded
- *
- * @return - a random base layer
+ * Legal base moves after a move on each axis, indexed by rba_axis_index()
  */
-static enum rba_layer rba_random_base_layer(void)
+static struct rba_moves_set const base_moves_after_axis[EXCLUDED_AXES_COUNT] =
 {
-	return layers[rand() % 9];
-}
+	/* NO_AXIS */ { 27, { X_BASE_CODES, Y_BASE_CODES, Z_BASE_CODES } },
+	/* X_AXIS */ { 18, { Y_BASE_CODES, Z_BASE_CODES } },
+	/* Y_AXIS */ { 18, { X_BASE_CODES, Z_BASE_CODES } },
+	/* Z_AXIS */ { 18, { X_BASE_CODES, Y_BASE_CODES } }
+};
 
 
 /**
- * Picks a random layer, wide moves are included
- *
- * @return - a random layer
+ * Legal moves after a move on each axis when USE_WIDE_MOVES is set, indexed
+ * by rba_axis_index()
  */
-static enum rba_layer rba_random_extended_layer(void)
+static struct rba_moves_set const wide_moves_after_axis[EXCLUDED_AXES_COUNT] =
 {
-	return layers[rand() % 15];
-}
+	/* NO_AXIS */ { 45, {
+		X_BASE_CODES, Y_BASE_CODES, Z_BASE_CODES,
+		X_WIDE_CODES, Y_WIDE_CODES, Z_WIDE_CODES } },
+	/* X_AXIS */ { 30, { Y_BASE_CODES, Z_BASE_CODES, Y_WIDE_CODES, Z_WIDE_CODES } },
+	/* Y_AXIS */ { 30, { X_BASE_CODES, Z_BASE_CODES, X_WIDE_CODES, Z_WIDE_CODES } },
+	/* Z_AXIS */ { 30, { X_BASE_CODES, Y_BASE_CODES, X_WIDE_CODES, Y_WIDE_CODES } }
+};
 
 
 /**
- * Picks a random modifier
- *
- * @return - a random modifier
+ * Legal moves after a move on each axis when POCKET_CUBE is set, indexed by
+ * rba_axis_index()
  */
-static enum rba_modifier rba_random_modifier(void)
+static struct rba_moves_set const pocket_moves_after_axis[EXCLUDED_AXES_COUNT] =
 {
-	return rand() % MODIFIER_MASK;
-}
+	/* NO_AXIS */ { 9, { X_POCKET_CODES, Y_POCKET_CODES, Z_POCKET_CODES } },
+	/* X_AXIS */ { 6, { Y_POCKET_CODES, Z_POCKET_CODES } },
+	/* Y_AXIS */ { 6, { X_POCKET_CODES, Z_POCKET_CODES } },
+	/* Z_AXIS */ { 6, { X_POCKET_CODES, Y_POCKET_CODES } }
+};
 
 
-/**
- * Picks a random base move, which may contain a modifier
- *
- * @return - a random base move
- */
-static rba_move rba_generate_random_base_move(void)
-{
-	return rba_random_base_layer() | rba_random_modifier();
-}
 
 
 /**
- * Picks a random move, which may contain a modifier
+ * Maps an axis to its row in the moves tables
+ *
+ * @param axis - the axis to get the row of
  *
- * @return - a random move, may be a wide one
+ * @return - 0 for NO_AXIS, 1 for X_AXIS, 2 for Y_AXIS, 3 for Z_AXIS
  */
-static rba_move rba_generate_random_wide_move(void)
+static size_t rba_axis_index(enum rba_axis axis)
 {
-	return rba_random_extended_layer() | rba_random_modifier();
+	/* 0x0, 0x4, 0x8, 0x10 become 0, 1, 2, 4, then Z_AXIS is moved to 3 */
+	return (axis >> 2) - (axis >> 4);
 }
 
 
 /**
- * Picks a random base move, without restriction
+ * Picks a move on another axis than the given one
+ *
+ * @param context - the random generator to draw from
  *
- * @return - a random base move
+ * @param moves_after_axis - the moves table to pick from
+ *
+ * @param excluded_axis - the axis to exclude from picking
+ *
+ * @return - the code of a move, guaranteed to be on a new axis
  */
-static rba_move rba_generate_first_random_base_move(void)
+static rba_move_code rba_generate_next_random_move(
+	struct rba_context * context,
+	struct rba_moves_set const moves_after_axis[],
+	enum rba_axis excluded_axis)
 {
-	return rba_generate_random_base_move();
+	struct rba_moves_set const * legal_moves =
+		moves_after_axis + rba_axis_index(excluded_axis);
+
+	return legal_moves->moves[rba_random_index(context, legal_moves->count)];
 }
 
 
-/**
- * Picks a random move, without restriction
- *
- * @return - a random move, may be a wide one
- */
-static rba_move rba_generate_first_random_wide_move(void)
+void rba_generate_random_moves(
+	struct rba_context * context,
+	enum rba_option flags,
+	rba_move_code moves[],
+	size_t count,
+	enum rba_axis previous_axis)
 {
-	return rba_generate_random_wide_move();
+	struct rba_moves_set const * moves_after_axis = base_moves_after_axis;
+	size_t added_moves;
+
+	if (flags & POCKET_CUBE)
+		moves_after_axis = pocket_moves_after_axis;
+	else if (flags & USE_WIDE_MOVES)
+		moves_after_axis = wide_moves_after_axis;
+
+	for (added_moves = 0; added_moves < count; added_moves++)
+	{
+		moves[added_moves] = rba_generate_next_random_move(
+			context,
+			moves_after_axis,
+			previous_axis);
+		previous_axis = rba_moves_by_code[moves[added_moves]] & AXIS_MASK;
+	}
 }
 
 
 /**
- * Picks a base move on another axis than the given one
+ * Generates a random state scramble: the reverted solution of a state drawn
+ * uniformly among the unsolved ones
  *
- * @param excluded_axis - the axis to exclude from picking
+ * @param context - the random generator to draw from
+ *
+ * @param moves - the buffer to write the codes of the moves to, at least
+ * 	MAX_SOLUTION_LENGTH codes or length codes if it is lower
  *
- * @return - a base move, guaranteed to be on a new axis
+ * @param length - the maximum number of moves of the scramble
+ *
+ * @param flags - POCKET_CUBE to draw a state of a 2x2x2 cube, solved
+ * 	optimally
+ *
+ * @return - the number of moves of the scramble, 0 if no solution of at most
+ * 	length moves was found
  */
-static rba_move rba_generate_next_random_base_move(enum rba_axis excluded_axis)
+static size_t rba_generate_random_state_moves(
+	struct rba_context * context,
+	rba_move_code moves[],
+	size_t length,
+	enum rba_option flags)
 {
-	rba_move next_move;
+	struct rba_cubie_cube solved_cube;
+	struct rba_cubie_cube cube;
+	size_t count;
 
-	do next_move = rba_generate_random_base_move();
-	while ((next_move & AXIS_MASK) == excluded_axis);
+	if (flags & POCKET_CUBE)
+	{
+		/* every pair of coordinates is a reachable state, 0 and 0 is solved */
+		unsigned int permutation;
+		unsigned int twist;
+
+		do
+		{
+			permutation = rba_random_index(context, POCKET_PERMUTATION_COUNT);
+			twist = rba_random_index(context, POCKET_TWIST_COUNT);
+		}
+		while ((permutation == 0) && (twist == 0));
+
+		count = rba_solve_pocket_coordinates(permutation, twist, length, moves);
+	}
+	else
+	{
+		rba_init_cubie_cube(& solved_cube);
+		do
+			rba_random_cubie_cube(context, & cube);
+		while (memcmp(& cube, & solved_cube, sizeof(cube)) == 0);
 
-	return next_move;
+		count = rba_solve_cubie_cube(& cube, length, moves, 1);
+	}
+	rba_reverse_moves(moves, count);
+
+	return count;
 }
 
 
-/**
- * Picks a move on another axis than the given one, may be a wide move
- *
- * @param excluded_axis - the axis to exclude from picking
- *
- * @return - a move, guaranteed to be on a new axis
- */
-static rba_move rba_generate_next_random_wide_move(enum rba_axis excluded_axis)
+size_t rba_compute_scramble_buffer_size(size_t length, enum rba_option flags)
 {
-	rba_move next_move;
+	(void) flags;
 
-	do next_move = rba_generate_random_wide_move();
-	while ((next_move & AXIS_MASK) == excluded_axis);
+	if (length == 0)
+		return 0;
 
-	return next_move;
+	return rba_compute_max_scramble_string_length(length) + 1;
 }
 
 
-/**
- * Generates every base move of the scramble
- *
- * @param moves - the buffer to insert generated moved to
- *
- * @param count - the number of moves to generate
- */
-static void rba_generate_random_base_moves(rba_move moves[], size_t count)
+size_t rba_generate_scramble_into_r(
+	struct rba_context * context,
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags)
 {
-	size_t added_moves = 0;
+	rba_move_code moves[MOVES_CHUNK_SIZE];
+	enum rba_axis previous_axis = NO_AXIS;
+	size_t writen_bytes = 0;
 
-	moves[added_moves++] = rba_generate_first_random_base_move();
+	if ((length == 0) || (capacity == 0))
+		return 0;
 
-	while (added_moves < count)
+	if (flags & RANDOM_STATE)
 	{
-		enum rba_axis previous_axis = moves[added_moves - 1] & AXIS_MASK;
-		moves[added_moves++] = rba_generate_next_random_base_move(previous_axis);
-	}
-}
+		rba_move_code solution[MAX_SOLUTION_LENGTH];
+		size_t count = rba_generate_random_state_moves(context, solution, length, flags);
 
+		writen_bytes = (count > 0) ? rba_write_moves(solution, count, buffer, capacity) : 0;
+		if (writen_bytes == 0)
+		{
+			* buffer = '\0';
+			return 0;
+		}
 
-/**
- * Generates every move of the scramble, which may contain wide moves
- *
- * @param moves - the buffer to insert generated moved to
- *
- * @param count - the number of moves to generate
- */
-static void rba_generate_random_wide_moves(rba_move moves[], size_t count)
-{
-	size_t added_moves = 0;
+		* (buffer + --writen_bytes) = '\0';
 
-	moves[added_moves++] = rba_generate_first_random_wide_move();
+		return writen_bytes;
+	}
 
-	while (added_moves < count)
+	while (length > 0)
 	{
-		enum rba_axis previous_axis = moves[added_moves - 1] & AXIS_MASK;
-		moves[added_moves++] = rba_generate_next_random_wide_move(previous_axis);
+		size_t count = length < MOVES_CHUNK_SIZE ? length : MOVES_CHUNK_SIZE;
+		size_t chunk_length;
+
+		rba_generate_random_moves(context, flags, moves, count, previous_axis);
+
+		/* the moves and the separator following the last one */
+		chunk_length = rba_write_moves(
+			moves,
+			count,
+			buffer + writen_bytes,
+			capacity - writen_bytes);
+		if (chunk_length == 0)
+		{
+			* buffer = '\0';
+			return 0;
+		}
+
+		writen_bytes += chunk_length;
+		previous_axis = rba_moves_by_code[moves[count - 1]] & AXIS_MASK;
+		length -= count;
 	}
+
+	/* the last separator becomes the NULL-terminating byte */
+	* (buffer + --writen_bytes) = '\0';
+
+	return writen_bytes;
 }
 
 
-/**
- * Computes the number of bytes requires to store the given move, using
- * singmaster notation
- *
- * @param move - the move to compute the length for
- *
- * @return - the number of bytes requires to write the given move
- */
-static size_t rba_move_length(rba_move move)
+size_t rba_generate_scramble_moves_r(
+	struct rba_context * context,
+	rba_move_code * moves,
+	size_t length,
+	enum rba_option flags)
 {
-	size_t length = 1; /* 1 character for the layer */
+	if (flags & RANDOM_STATE)
+	{
+		rba_move_code solution[MAX_SOLUTION_LENGTH];
+		size_t count = rba_generate_random_state_moves(context, solution, length, flags);
+
+		memcpy(moves, solution, count * sizeof(* moves));
 
-	/* 1 character for the modifier, if any */
-	if ((move & MODIFIER_MASK) != NO_MODIFIER)
-		length++;
+		return count;
+	}
+
+	rba_generate_random_moves(context, flags, moves, length, NO_AXIS);
 
 	return length;
 }
 
 
-/**
- * Computes the length of the string required to store the scramble using
- * singmaster notation
- *
- * @param moves - the moves composing the scramble
- *
- * @param count - the number of moves in the scramble
- *
- * @return - the required length of the string, without NULL-terminating byte
- */
-static size_t rba_compute_scramble_string_length(rba_move const moves[], size_t count)
+size_t rba_generate_scramble_moves(
+	rba_move_code * moves,
+	size_t length,
+	enum rba_option flags)
 {
-	size_t string_length = 0;
-	size_t index;
+	struct rba_context context;
 
-	for (index = 0; index < count; index++)
-		string_length += rba_move_length(moves[index]);
+	rba_seed_context_from_rand(& context);
 
-	return string_length + count - 1;
+	return rba_generate_scramble_moves_r(& context, moves, length, flags);
 }
 
 
-/**
- * Matches the base layer to a symbol
- *
- * @param layer - the layer to get the symbol for
- *
- * @return - the symbol of the layer
- */
-static char rba_base_layer_symbol(enum rba_layer layer)
+size_t rba_generate_scramble_into(
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags)
 {
-	switch (layer)
-	{
-		case LEFT_LAYER: return 'L';
-		case MIDDLE_LAYER: return 'M';
-		case RIGHT_LAYER: return 'R';
-		case TOP_LAYER: return 'U';
-		case EQUATOR_LAYER: return 'E';
-		case BOTTOM_LAYER: return 'D';
-		case FRONT_LAYER: return 'F';
-		case STANDING_LAYER: return 'S';
-		case BACK_LAYER: return 'B';
-		default: return '?';
-	}
+	struct rba_context context;
+
+	rba_seed_context_from_rand(& context);
+
+	return rba_generate_scramble_into_r(& context, buffer, capacity, length, flags);
 }
 
 
-/**
- * Matches the wide layer to a symbol in singmaster notation
- *
- * @param layer - the layer to get the symbol for
- *
- * @return - the symbol of the layer
- */
-static char rba_extended_layer_symbol(enum rba_layer layer)
+char * rba_generate_scramble_r(
+	struct rba_context * context,
+	size_t length,
+	enum rba_option flags)
 {
-	switch (layer)
+	size_t capacity = rba_compute_scramble_buffer_size(length, flags);
+	char * scramble;
+
+	if (capacity == 0)
+		return NULL;
+
+	scramble = malloc(capacity);
+	if (scramble == NULL)
+		return NULL;
+
+	if (rba_generate_scramble_into_r(context, scramble, capacity, length, flags) == 0)
 	{
-		case LEFT_LAYERS: return 'l';
-		case BUT_MIDDLE_LAYER: return 'm';
-		case RIGHT_LAYERS: return 'r';
-		case TOP_LAYERS: return 'u';
-		case BUT_EQUATOR_LAYER: return 'e';
-		case BOTTOM_LAYERS: return 'd';
-		case FRONT_LAYERS: return 'f';
-		case BUT_STANDING_LAYER: return 's';
-		case BACK_LAYERS: return 'b';
-		default: return rba_base_layer_symbol(layer);
+		free(scramble);
+		return NULL;
 	}
+
+	return scramble;
 }
 
 
-/**
- * Returns the symbol of the given modifier
- *
- * @param modifier - the modifier to get the symbol for
- *
- * @return - the symbol to write the modifier, or '?' if unknown modifier,
- * or '?' if NO_MODIFIER
- */
-static char rba_modifier_symbol(enum rba_modifier modifier)
+char * rba_generate_scramble(size_t length, enum rba_option flags)
 {
-	if (modifier == REVERSE_MODIFIER)
-		return '\'';
-	if (modifier == DOUBLE_MODIFIER)
-		return '2';
+	struct rba_context context;
 
-	return '?';
+	rba_seed_context_from_rand(& context);
+
+	return rba_generate_scramble_r(& context, length, flags);
 }
 
 
 /**
- * Writes a move at the beginning of the scramble string, using singmaster
- * notation
+ * Generates several scrambles in a single allocation
+ * The caller is in charge of the memory
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param seed - the seed to derive the generator of each scramble from, or
+ * 	NULL to draw every scramble from the context as is
+ *
+ * @param first_index - the index of the first scramble, when derived from a
+ * 	seed
  *
- * @param move - the move to write
+ * @param count - the number of scrambles to generate
  *
- * @param scramble - the scramble string to write to
+ * @param length - the length of each scramble
  *
- * @return - the number of writen bytes
+ * @param flags - the options to generate the scrambles with
+ *
+ * @return - the generated scrambles, or NULL if count or length is 0, or if
+ * 	the allocation failed
  */
-static size_t rba_write_move(rba_move move, char * scramble)
+static struct rba_scramble_batch * rba_generate_scramble_batch(
+	struct rba_context * context,
+	uint64_t const * seed,
+	uint64_t first_index,
+	size_t count,
+	size_t length,
+	enum rba_option flags)
 {
+	size_t capacity = rba_compute_scramble_buffer_size(length, flags);
+	size_t header_size;
 	size_t writen_bytes = 0;
-	enum rba_layer layer_bits = move & LAYER_MASK;
+	struct rba_scramble_batch * batch;
+	struct rba_scramble_batch * shrunk_batch;
+	size_t index;
 
-	* (scramble + writen_bytes++) = rba_extended_layer_symbol(layer_bits);
+	if ((count == 0) || (capacity == 0))
+		return NULL;
+	/* the size of the offsets must not wrap before the strings are counted */
+	if (count >= ((size_t) -1 - sizeof(struct rba_scramble_batch)) / sizeof(size_t))
+		return NULL;
 
-	if ((move & MODIFIER_MASK) != NO_MODIFIER)
-		* (scramble + writen_bytes++) = rba_modifier_symbol(move & MODIFIER_MASK);
+	header_size = sizeof(struct rba_scramble_batch) + (count + 1) * sizeof(size_t);
+	if (count > ((size_t) -1 - header_size) / capacity)
+		return NULL;
 
-	return writen_bytes;
-}
+	/* the header, the offsets and every string of the worst case at once */
+	batch = malloc(header_size + count * capacity);
+	if (batch == NULL)
+		return NULL;
 
+	batch->count = count;
+	batch->offsets = (size_t *) (batch + 1);
+	batch->strings = (char *) (batch->offsets + count + 1);
 
-/**
- * Writes the scramble in the given string, using singmaster notation
- *
- * @param moves - the moves composing the scramble
- *
- * @param count - the number of moves in the scramble
- *
- * @param scramble - the writen scramble
- */
-static void rba_write_scramble(rba_move const moves[], size_t count, char * scramble)
-{
-	size_t move_index;
+	for (index = 0; index < count; index++)
+	{
+		char * scramble = batch->strings + writen_bytes;
 
-	scramble += rba_write_move(moves[0], scramble);
+		if (seed != NULL)
+			rba_seed_context_at(context, * seed, first_index + index);
 
-	for (move_index = 1; move_index < count; move_index++)
+		batch->offsets[index] = writen_bytes;
+		writen_bytes += rba_generate_scramble_into_r(context, scramble, capacity, length, flags) + 1;
+	}
+	batch->offsets[count] = writen_bytes;
+
+	/* give back the room the worst case didn't use, only the tail is cut */
+	shrunk_batch = realloc(batch, header_size + writen_bytes);
+	if (shrunk_batch != NULL)
 	{
-		* scramble++ = ' ';
-		scramble += rba_write_move(moves[move_index], scramble);
+		batch = shrunk_batch;
+		batch->offsets = (size_t *) (batch + 1);
+		batch->strings = (char *) (batch->offsets + count + 1);
 	}
 
-	* scramble = '\0';
+	return batch;
 }
 
 
-/**
- * Creates a scramble string from the given moves, using singmaster notation
- * The caller is in charge of the memory
- *
- * @param moves - the moves composing the scramble
- *
- * @param count - the number of moves in the scramble
- *
- * @return - the created scramble
- */
-static char * rba_create_scramble_string(rba_move const moves[], size_t count)
+struct rba_scramble_batch * rba_generate_scrambles_r(
+	struct rba_context * context,
+	size_t count,
+	size_t length,
+	enum rba_option flags)
 {
-	size_t string_length = rba_compute_scramble_string_length(moves, count);
-	char * scramble = malloc(string_length + 1);
+	return rba_generate_scramble_batch(context, NULL, 0, count, length, flags);
+}
 
-	if (scramble == NULL)
-		return NULL;
 
-	rba_write_scramble(moves, count, scramble);
+struct rba_scramble_batch * rba_generate_scrambles(
+	size_t count,
+	size_t length,
+	enum rba_option flags)
+{
+	struct rba_context context;
 
-	return scramble;
+	rba_seed_context_from_rand(& context);
+
+	return rba_generate_scrambles_r(& context, count, length, flags);
 }
 
 
-char * rba_generate_scramble(size_t length, enum rba_option flags)
+char * rba_generate_scramble_at(
+	uint64_t seed,
+	uint64_t index,
+	size_t length,
+	enum rba_option flags)
 {
-	rba_move * moves;
-	char * scramble;
+	struct rba_context context;
 
-	if (length == 0)
-		return NULL;
+	rba_seed_context_at(& context, seed, index);
 
-	moves = malloc(sizeof(rba_move) * length);
-	if (moves == NULL)
-		return NULL;
+	return rba_generate_scramble_r(& context, length, flags);
+}
 
-	if (flags & USE_WIDE_MOVES)
-		rba_generate_random_wide_moves(moves, length);
-	else
-		rba_generate_random_base_moves(moves, length);
 
-	scramble = rba_create_scramble_string(moves, length);
+size_t rba_generate_scramble_into_at(
+	uint64_t seed,
+	uint64_t index,
+	char * buffer,
+	size_t capacity,
+	size_t length,
+	enum rba_option flags)
+{
+	struct rba_context context;
 
-	free(moves);
+	rba_seed_context_at(& context, seed, index);
 
-	return scramble;
+	return rba_generate_scramble_into_r(& context, buffer, capacity, length, flags);
+}
+
+
+struct rba_scramble_batch * rba_generate_scrambles_at(
+	uint64_t seed,
+	uint64_t first_index,
+	size_t count,
+	size_t length,
+	enum rba_option flags)
+{
+	struct rba_context context;
+
+	return rba_generate_scramble_batch(& context, & seed, first_index, count, length, flags);
 }
@@ -0,0 +1,43 @@
+#ifndef RUBIKS_ALGOS_SCRAMBLE_HEADER
+#define RUBIKS_ALGOS_SCRAMBLE_HEADER
+
+#include "random.h"
+#include "moves.h"
+
+
+
+
+/**
+ * The number of moves generated at once on the stack before being writen, so
+ * scrambles of any length don't need a temporary heap buffer
+ */
+#define MOVES_CHUNK_SIZE 64
+
+
+
+
+/**
+ * Generates moves of the scramble, continuing after the given axis
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param flags - USE_WIDE_MOVES to include wide moves
+ *
+ * @param moves - the buffer to insert the codes of generated moves to
+ *
+ * @param count - the number of moves to generate
+ *
+ * @param previous_axis - the axis of the move preceding the first generated
+ * 	one, NO_AXIS if there is none
+ */
+void rba_generate_random_moves(
+	struct rba_context * context,
+	enum rba_option flags,
+	rba_move_code moves[],
+	size_t count,
+	enum rba_axis previous_axis);
+
+
+
+
+#endif /* RUBIKS_ALGOS_SCRAMBLE_HEADER */
@@ -0,0 +1,320 @@
+#include <string.h>
+
+#include "attributes.h"
+#include "moves.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of layers turning around an axis: 3 single layers and 2 wide
+ * layers
+ */
+#define AXIS_LAYERS_COUNT 5
+
+
+/**
+ * The axis of a group before the first move
+ */
+#define NO_GROUP_AXIS (-1)
+
+
+/**
+ * The quarter turns of the 3 layers of an axis are packed in a byte, 3 bits
+ * per layer, the spare bit catching the carry of additions modulo 4
+ */
+#define TURNS_SHIFT 3
+#define TURNS_MASK 0xDB
+#define GROUP_TURNS_COUNT 256
+
+
+
+
+/**
+ * Consecutive moves turning around the same axis, which commute, reduced to
+ * the quarter turns of each single layer
+ */
+struct rba_axis_group
+{
+	/**
+	 * The axis of the moves, 0 for x, 1 for y, 2 for z
+	 */
+	int axis;
+
+	/**
+	 * The clockwise quarter turns of each layer, as seen from the positive
+	 * side of the axis, packed by increasing bit of rba_layer_rotation.layers,
+	 * see TURNS_SHIFT
+	 */
+	unsigned int turns;
+};
+
+
+
+
+/**
+ * The layers turning around each axis, by increasing index, so the moves of
+ * a group are always written in the same order
+ */
+static int const axis_layers[3][AXIS_LAYERS_COUNT] =
+{
+	{ LEFT_LAYER_INDEX, MIDDLE_LAYER_INDEX, RIGHT_LAYER_INDEX, LEFT_LAYERS_INDEX, RIGHT_LAYERS_INDEX },
+	{ TOP_LAYER_INDEX, EQUATOR_LAYER_INDEX, BOTTOM_LAYER_INDEX, TOP_LAYERS_INDEX, BOTTOM_LAYERS_INDEX },
+	{ FRONT_LAYER_INDEX, STANDING_LAYER_INDEX, BACK_LAYER_INDEX, FRONT_LAYERS_INDEX, BACK_LAYERS_INDEX }
+};
+
+
+/**
+ * The packed quarter turns each move adds to the layers of its axis, filled
+ * at load time
+ */
+static uint8_t move_turns[MOVE_CODES_COUNT];
+
+
+/**
+ * The number of moves writing the packed turns of a group, without and with
+ * wide moves, filled at load time
+ */
+static uint8_t group_moves_counts[2][GROUP_TURNS_COUNT];
+
+
+/**
+ * The codes of the moves writing the packed turns of a group, without and
+ * with wide moves, for each axis, filled at load time
+ */
+static rba_move_code group_moves[2][3][GROUP_TURNS_COUNT][3];
+
+
+
+
+/**
+ * Computes the code of the move making quarter turns with a layer
+ *
+ * @param layer_index - the layer to turn, see rba_layer_index
+ *
+ * @param quarter_turns - the clockwise quarter turns, as seen from the
+ * 	positive side of the axis, 1 to 3
+ *
+ * @return - the code of the move
+ */
+static rba_move_code rba_layer_move_code(int layer_index, int quarter_turns)
+{
+	if (quarter_turns == 2)
+		return MOVE_CODE(layer_index, DOUBLE_MODIFIER);
+
+	return (quarter_turns == rba_layer_rotations[layer_index].quarter_turns)
+		? MOVE_CODE(layer_index, NO_MODIFIER)
+		: MOVE_CODE(layer_index, REVERSE_MODIFIER);
+}
+
+
+/**
+ * Finds the fewest moves making quarter turns with the layers of an axis
+ * The turns of the wide layers are chosen among the 16 possible ones, the
+ * single layers then make the rest, so at most 3 moves are needed
+ *
+ * @param axis - the axis the layers turn around
+ *
+ * @param quarter_turns - the clockwise quarter turns of each layer, see
+ * 	rba_axis_group
+ *
+ * @param use_wide_moves - whether wide moves can be used
+ *
+ * @param moves - the buffer to write the codes to, 3 codes
+ *
+ * @return - the number of moves, 0 if the turns cancel out
+ */
+static size_t rba_find_group_moves(int axis, int const quarter_turns[3], int use_wide_moves, rba_move_code moves[])
+{
+	int best_turns[8] = { 0 };
+	size_t best_count = AXIS_LAYERS_COUNT + 1;
+	int max_wide_turns = use_wide_moves ? 3 : 0;
+	int negative_turns;
+	int positive_turns;
+	size_t count = 0;
+	size_t index;
+
+	/* indexed by the layers bits of the moves: 0x3 and 0x6 are the wide ones */
+	for (negative_turns = 0; negative_turns <= max_wide_turns; negative_turns++)
+	{
+		for (positive_turns = 0; positive_turns <= max_wide_turns; positive_turns++)
+		{
+			int turns[8] = { 0 };
+			size_t moves_count;
+
+			turns[0x3] = negative_turns;
+			turns[0x6] = positive_turns;
+			turns[0x1] = (quarter_turns[0] + 4 - negative_turns) % 4;
+			turns[0x2] = (quarter_turns[1] + 8 - negative_turns - positive_turns) % 4;
+			turns[0x4] = (quarter_turns[2] + 4 - positive_turns) % 4;
+
+			moves_count = (turns[0x1] != 0) + (turns[0x2] != 0) + (turns[0x4] != 0)
+				+ (turns[0x3] != 0) + (turns[0x6] != 0);
+			if (moves_count < best_count)
+			{
+				memcpy(best_turns, turns, sizeof(turns));
+				best_count = moves_count;
+			}
+		}
+	}
+
+	for (index = 0; index < AXIS_LAYERS_COUNT; index++)
+	{
+		int layer_index = axis_layers[axis][index];
+		int turns = best_turns[rba_layer_rotations[layer_index].layers];
+
+		if (turns != 0)
+			moves[count++] = rba_layer_move_code(layer_index, turns);
+	}
+
+	return count;
+}
+
+
+/**
+ * Fills the tables of the simplifier, at load time
+ */
+CONSTRUCTOR static void rba_init_group_tables(void)
+{
+	unsigned int turns;
+	rba_move_code code;
+	int use_wide_moves;
+	int axis;
+	int layer;
+
+	for (code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		struct rba_layer_rotation const * rotation = rba_layer_rotations + code / 3;
+		int quarter_turns = rotation->quarter_turns * rba_modifier_turns[code % 3] % 4;
+
+		move_turns[code] = 0;
+		for (layer = 0; layer < 3; layer++)
+		{
+			if (rotation->layers & (1 << layer))
+				move_turns[code] |= (uint8_t) (quarter_turns << (TURNS_SHIFT * layer));
+		}
+	}
+
+	for (turns = 0; turns < GROUP_TURNS_COUNT; turns++)
+	{
+		int quarter_turns[3];
+
+		if (turns & ~TURNS_MASK)
+			continue;
+
+		for (layer = 0; layer < 3; layer++)
+			quarter_turns[layer] = (turns >> (TURNS_SHIFT * layer)) & 0x3;
+
+		for (use_wide_moves = 0; use_wide_moves < 2; use_wide_moves++)
+		{
+			for (axis = 0; axis < 3; axis++)
+			{
+				group_moves_counts[use_wide_moves][turns] = (uint8_t) rba_find_group_moves(
+					axis,
+					quarter_turns,
+					use_wide_moves,
+					group_moves[use_wide_moves][axis][turns]);
+			}
+		}
+	}
+}
+
+
+/**
+ * Writes a group after the moves simplified so far, and starts a new one
+ *
+ * @param group - the group to write, emptied
+ *
+ * @param use_wide_moves - whether wide moves can be written
+ *
+ * @param simplified - the moves simplified so far
+ *
+ * @param capacity - the number of codes simplified can store
+ *
+ * @param length - the number of moves simplified so far, updated
+ *
+ * @return - 1 if the group was written, 0 if it doesn't fit
+ */
+static int rba_flush_group(
+	struct rba_axis_group * group,
+	int use_wide_moves,
+	rba_move_code * simplified,
+	size_t capacity,
+	size_t * length)
+{
+	size_t count;
+
+	if (group->axis == NO_GROUP_AXIS)
+		return 1;
+
+	count = group_moves_counts[use_wide_moves][group->turns];
+	if (count > capacity - * length)
+		return 0;
+
+	memcpy(simplified + * length, group_moves[use_wide_moves][group->axis][group->turns], count);
+	* length += count;
+	group->turns = 0;
+
+	return 1;
+}
+
+
+
+
+size_t rba_simplify_moves(
+	rba_move_code const * moves,
+	size_t count,
+	rba_move_code * simplified,
+	size_t capacity,
+	enum rba_option flags)
+{
+	int use_wide_moves = (flags & USE_WIDE_MOVES) != 0;
+	struct rba_axis_group group;
+	size_t length = 0;
+	size_t index;
+
+	/* checked beforehand, moves may be simplified in place */
+	for (index = 0; index < count; index++)
+	{
+		if (moves[index] >= MOVE_CODES_COUNT)
+			return 0;
+	}
+
+	group.axis = NO_GROUP_AXIS;
+	group.turns = 0;
+
+	for (index = 0; index < count; index++)
+	{
+		rba_move_code move = moves[index];
+		int axis = rba_layer_rotations[move / 3].axis;
+
+		if (axis != group.axis)
+		{
+			size_t previous_length = length;
+
+			if (! rba_flush_group(& group, use_wide_moves, simplified, capacity, & length))
+				return 0;
+
+			/* the group cancelled out, the one before may go on */
+			if (length == previous_length)
+			{
+				while ((length > 0) && (rba_layer_rotations[simplified[length - 1] / 3].axis == axis))
+				{
+					length--;
+					group.turns = (group.turns + move_turns[simplified[length]]) & TURNS_MASK;
+				}
+			}
+
+			group.axis = axis;
+		}
+
+		group.turns = (group.turns + move_turns[move]) & TURNS_MASK;
+	}
+
+	if (! rba_flush_group(& group, use_wide_moves, simplified, capacity, & length))
+		return 0;
+
+	return length;
+}
@@ -0,0 +1,1199 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "attributes.h"
+#include "cube.h"
+#include "cubie.h"
+#include "solver.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The maximum number of moves of phase 2, any state of its subgroup can be
+ * solved with 18 moves but long phases 2 are slow to search, a longer phase 1
+ * is tried instead
+ */
+#define MAX_PHASE2_LENGTH 12
+
+
+/**
+ * The number of moves keeping a cube in the subgroup of phase 2: the turns
+ * of U and D, and the half turns of the 4 other faces
+ */
+#define PHASE2_MOVES_COUNT 10
+
+
+/**
+ * The number of moves of a 2x2x2 cube whose D-B-L corner stays in place:
+ * the turns of U, R and F
+ */
+#define POCKET_MOVES_COUNT 9
+
+
+/**
+ * The distance of the states not reached yet while building pruning tables
+ */
+#define UNKNOWN_DISTANCE 0xF
+
+
+/**
+ * The face before the first move of a solution, no move is redundant after it
+ */
+#define NO_FACE 0xF
+
+
+/**
+ * The maximum number of threads building the pruning tables or solving a cube
+ */
+#define MAX_THREADS_COUNT 256
+
+
+/**
+ * The number of first moves of phase 1 fixed by a unit of work of a parallel
+ * search, 2 moves give about 250 subtrees per phase 1 length
+ */
+#define SPLIT_DEPTH 2
+
+
+/**
+ * The maximum number of sequences of SPLIT_DEPTH moves
+ */
+#define MAX_PREFIXES_COUNT (FACE_MOVES_COUNT * FACE_MOVES_COUNT)
+
+
+
+
+/**
+ * The state of a search for a solution
+ */
+struct rba_search
+{
+	/**
+	 * The tables to search with
+	 */
+	struct rba_solver_tables const * tables;
+
+	/**
+	 * The coordinates of phase 2 of the cube to solve, followed through the
+	 * moves of phase 1 with the move tables
+	 */
+	unsigned int corners;
+	unsigned int slice_sorted;
+	unsigned int up_edges;
+	unsigned int down_edges;
+
+	/**
+	 * The maximum number of moves of the solution
+	 */
+	size_t max_length;
+
+	/**
+	 * The face moves of the current sequence
+	 */
+	uint8_t moves[MAX_SOLUTION_LENGTH];
+
+	/**
+	 * The unit of work being searched, see rba_parallel_search
+	 */
+	size_t unit;
+
+	/**
+	 * The first unit known to have a solution, the search of later units is
+	 * useless and stops
+	 */
+	size_t const volatile * solved_unit;
+};
+
+
+/**
+ * A search shared by several threads
+ * The search is split in units, a unit being a phase 1 length and a
+ * sequence of first moves, ordered as the single-threaded search tries them,
+ * threads take the next unit when they are done with theirs, and the
+ * solution of the first unit having one is kept, the one a single thread
+ * finds
+ */
+struct rba_parallel_search
+{
+	/**
+	 * The search every thread starts from
+	 */
+	struct rba_search search;
+
+	/**
+	 * The coordinates of phase 1 of the cube
+	 */
+	unsigned int twist;
+	unsigned int flip;
+	unsigned int slice;
+
+	/**
+	 * The sequences of first moves, in the order of the search
+	 */
+	uint8_t prefixes[MAX_PREFIXES_COUNT][SPLIT_DEPTH];
+	size_t prefixes_count;
+
+	/**
+	 * The number of units, for phase 1 lengths from SPLIT_DEPTH to the
+	 * maximum length
+	 */
+	size_t units_count;
+
+	/**
+	 * The next unit to search, taken atomically
+	 */
+	size_t next_unit;
+
+	/**
+	 * The first unit having a solution, units_count until one is found
+	 */
+	size_t volatile solved_unit;
+
+	/**
+	 * Protects the solution
+	 */
+	pthread_mutex_t mutex;
+
+	/**
+	 * The solution of the first unit having one
+	 */
+	uint8_t moves[MAX_SOLUTION_LENGTH];
+	size_t length;
+};
+
+
+/**
+ * The share of a thread in the expansion of a depth of a pruning table
+ */
+struct rba_distances_job
+{
+	/**
+	 * The pruning table being filled, see rba_build_distances()
+	 */
+	uint8_t * distances;
+	uint16_t const (* first_moves)[FACE_MOVES_COUNT];
+	uint16_t const (* second_moves)[FACE_MOVES_COUNT];
+	size_t second_count;
+	uint8_t const * face_moves;
+	size_t face_moves_count;
+
+	/**
+	 * The depth to expand, the states at this depth lead to depth + 1
+	 */
+	unsigned int depth;
+
+	/**
+	 * Whether other threads fill the table at the same time, distances are
+	 * then written with atomic operations
+	 */
+	int shared;
+
+	/**
+	 * The range of indexes of the states the thread expands
+	 */
+	size_t begin;
+	size_t end;
+
+	/**
+	 * The number of states the thread reached first, output
+	 */
+	size_t reached_count;
+};
+
+
+/**
+ * The functions reading and writing a coordinate of a cube
+ */
+typedef unsigned int (* rba_coordinate_getter)(struct rba_cubie_cube const * cube);
+typedef void (* rba_coordinate_setter)(struct rba_cubie_cube * cube, unsigned int coordinate);
+
+
+
+
+/**
+ * Every face move
+ */
+static uint8_t const all_moves[FACE_MOVES_COUNT] =
+{
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17
+};
+
+
+/**
+ * The face moves of phase 2: U, U2, U', R2, F2, D, D2, D', L2 and B2
+ */
+static uint8_t const phase2_moves[PHASE2_MOVES_COUNT] = { 0, 1, 2, 4, 7, 9, 10, 11, 13, 16 };
+
+
+/**
+ * The face moves of a 2x2x2 cube: U, U2, U', R, R2, R', F, F2 and F'
+ */
+static uint8_t const pocket_moves[POCKET_MOVES_COUNT] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+
+
+/**
+ * The tables of the solver, NULL until built or loaded
+ */
+static struct rba_solver_tables const * solver_tables = NULL;
+
+
+/**
+ * Makes sure the tables are built or loaded once, whatever the thread
+ */
+static pthread_mutex_t solver_tables_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * The solved unit of single-threaded searches, which are never stopped
+ */
+static size_t const no_solved_unit = (size_t) -1;
+
+
+
+
+/**
+ * Gives the number of threads to use
+ *
+ * @param threads_count - the requested number of threads, 0 for 1 per
+ * 	processor
+ *
+ * @return - the number of threads, 1 to MAX_THREADS_COUNT
+ */
+static size_t rba_count_threads(size_t threads_count)
+{
+	long processors_count;
+
+	if (threads_count == 0)
+	{
+		processors_count = sysconf(_SC_NPROCESSORS_ONLN);
+		threads_count = (processors_count > 0) ? (size_t) processors_count : 1;
+	}
+
+	return (threads_count < MAX_THREADS_COUNT) ? threads_count : MAX_THREADS_COUNT;
+}
+
+
+/**
+ * Reads a distance from a pruning table
+ *
+ * @param distances - the pruning table
+ *
+ * @param index - the index of the distance
+ *
+ * @return - the distance
+ */
+static unsigned int rba_get_distance(uint8_t const distances[], size_t index)
+{
+	return (distances[index / 2] >> (4 * (index % 2))) & 0xF;
+}
+
+
+/**
+ * Writes a distance in a pruning table, unless the state was already
+ * reached, the 2 distances of a byte may be written by different threads
+ *
+ * @param distances - the pruning table
+ *
+ * @param index - the index of the distance
+ *
+ * @param distance - the distance, 0 to 14
+ *
+ * @param shared - whether other threads write in the table at the same time
+ *
+ * @return - 1 if the distance was written, 0 if the state was already reached
+ */
+static int rba_set_unknown_distance(uint8_t distances[], size_t index, unsigned int distance, int shared)
+{
+	unsigned int shift = 4 * (index % 2);
+	uint8_t * pair = distances + index / 2;
+	uint8_t previous_pair;
+	uint8_t next_pair;
+
+	if (! shared)
+	{
+		if (((* pair >> shift) & 0xF) != UNKNOWN_DISTANCE)
+			return 0;
+
+		* pair = (uint8_t) ((* pair & ~(0xF << shift)) | (distance << shift));
+		return 1;
+	}
+
+	do
+	{
+		previous_pair = * (uint8_t volatile *) pair;
+		if (((previous_pair >> shift) & 0xF) != UNKNOWN_DISTANCE)
+			return 0;
+
+		next_pair = (uint8_t) ((previous_pair & ~(0xF << shift)) | (distance << shift));
+	}
+	while (! __sync_bool_compare_and_swap(pair, previous_pair, next_pair));
+
+	return 1;
+}
+
+
+/**
+ * Tells whether a move is useless after a move on the given face: the same
+ * face, or the opposite face in the other order, eg. U after D
+ *
+ * @param previous_face - the face of the previous move, or NO_FACE
+ *
+ * @param move - the face move to check
+ *
+ * @return - 1 if the move is redundant, 0 otherwise
+ */
+static int rba_is_redundant_move(unsigned int previous_face, unsigned int move)
+{
+	unsigned int face = FACE_MOVE_FACE(move);
+
+	return (face == previous_face) || (face + 3 == previous_face);
+}
+
+
+/**
+ * Tells whether a move keeps a cube in the subgroup of phase 2
+ *
+ * @param move - the face move to check
+ *
+ * @return - 1 if the move is a move of phase 2, 0 otherwise
+ */
+static int rba_is_phase2_move(unsigned int move)
+{
+	unsigned int face = FACE_MOVE_FACE(move);
+
+	return (face == 0) || (face == 3) || (move % 3 == 1);
+}
+
+
+/**
+ * Fills the move table of a coordinate
+ *
+ * @param moves - the move table to fill
+ *
+ * @param count - the number of values of the coordinate
+ *
+ * @param get - reads the coordinate
+ *
+ * @param set - writes the coordinate
+ *
+ * @param face_moves - the moves to fill the table for
+ *
+ * @param face_moves_count - the number of moves to fill the table for
+ */
+static void rba_build_moves(
+	uint16_t (* moves)[FACE_MOVES_COUNT],
+	size_t count,
+	rba_coordinate_getter get,
+	rba_coordinate_setter set,
+	uint8_t const face_moves[],
+	size_t face_moves_count)
+{
+	struct rba_cubie_cube cube;
+	size_t coordinate;
+	size_t index;
+
+	rba_init_cubie_cube(& cube);
+
+	for (coordinate = 0; coordinate < count; coordinate++)
+	{
+		set(& cube, (unsigned int) coordinate);
+
+		for (index = 0; index < face_moves_count; index++)
+		{
+			struct rba_cubie_cube turned_cube = cube;
+
+			rba_apply_face_move(& turned_cube, face_moves[index]);
+			moves[coordinate][face_moves[index]] = (uint16_t) get(& turned_cube);
+		}
+	}
+}
+
+
+/**
+ * Expands a range of states of a depth of a pruning table: the states they
+ * lead to which were not reached yet are at the next depth
+ *
+ * @param job - the range to expand, see rba_distances_job
+ *
+ * @return - NULL
+ */
+static void * rba_expand_distances(void * job)
+{
+	/* copied, the writes of distances could otherwise alias the job */
+	struct rba_distances_job range = * (struct rba_distances_job *) job;
+	size_t reached_count = 0;
+	size_t index;
+
+	for (index = range.begin; index < range.end; index++)
+	{
+		size_t first = index / range.second_count;
+		size_t second = index % range.second_count;
+		size_t move;
+
+		if (rba_get_distance(range.distances, index) != range.depth)
+			continue;
+
+		for (move = 0; move < range.face_moves_count; move++)
+		{
+			unsigned int face_move = range.face_moves[move];
+			size_t next_index = range.first_moves[first][face_move] * range.second_count
+				+ range.second_moves[second][face_move];
+
+			reached_count += rba_set_unknown_distance(range.distances, next_index, range.depth + 1, range.shared);
+		}
+	}
+
+	((struct rba_distances_job *) job)->reached_count = reached_count;
+
+	return NULL;
+}
+
+
+/**
+ * Fills a pruning table with a breadth-first search from the goal, the
+ * table is indexed by first coordinate * second_count + second coordinate
+ * Each depth is expanded by several threads, a state is given the depth of
+ * the first thread reaching it, which is the same for all of them, so the
+ * table doesn't depend on the number of threads
+ *
+ * @param distances - the pruning table to fill
+ *
+ * @param first_moves - the move table of the first coordinate
+ *
+ * @param first_count - the number of values of the first coordinate
+ *
+ * @param second_moves - the move table of the second coordinate
+ *
+ * @param second_count - the number of values of the second coordinate
+ *
+ * @param face_moves - the moves of the phase
+ *
+ * @param face_moves_count - the number of moves of the phase
+ *
+ * @param threads_count - the number of threads, 1 to MAX_THREADS_COUNT
+ */
+static void rba_build_distances(
+	uint8_t distances[],
+	uint16_t const (* first_moves)[FACE_MOVES_COUNT],
+	size_t first_count,
+	uint16_t const (* second_moves)[FACE_MOVES_COUNT],
+	size_t second_count,
+	uint8_t const face_moves[],
+	size_t face_moves_count,
+	size_t threads_count)
+{
+	struct rba_distances_job jobs[MAX_THREADS_COUNT];
+	pthread_t threads[MAX_THREADS_COUNT];
+	int started[MAX_THREADS_COUNT];
+	size_t count = first_count * second_count;
+	size_t reached_count = 1;
+	size_t thread;
+	unsigned int depth;
+
+	memset(distances, 0xFF, DISTANCES_SIZE(count));
+	rba_set_unknown_distance(distances, 0, 0, 0);
+
+	for (depth = 0; reached_count < count; depth++)
+	{
+		size_t depth_reached_count = 0;
+
+		/* ranges of even size, a byte of distances is scanned by a thread */
+		for (thread = 0; thread < threads_count; thread++)
+		{
+			jobs[thread].distances = distances;
+			jobs[thread].first_moves = first_moves;
+			jobs[thread].second_moves = second_moves;
+			jobs[thread].second_count = second_count;
+			jobs[thread].face_moves = face_moves;
+			jobs[thread].face_moves_count = face_moves_count;
+			jobs[thread].depth = depth;
+			jobs[thread].shared = (threads_count > 1);
+			jobs[thread].begin = count / 2 * thread / threads_count * 2;
+			jobs[thread].end = (thread + 1 < threads_count) ? count / 2 * (thread + 1) / threads_count * 2 : count;
+		}
+
+		/* the calling thread expands the first range, and those of threads failing to start */
+		for (thread = 1; thread < threads_count; thread++)
+			started[thread] = (pthread_create(threads + thread, NULL, rba_expand_distances, jobs + thread) == 0);
+		rba_expand_distances(jobs);
+		for (thread = 1; thread < threads_count; thread++)
+		{
+			if (started[thread])
+				pthread_join(threads[thread], NULL);
+			else
+				rba_expand_distances(jobs + thread);
+		}
+
+		for (thread = 0; thread < threads_count; thread++)
+			depth_reached_count += jobs[thread].reached_count;
+
+		/* the remaining states can't be reached */
+		if (depth_reached_count == 0)
+			break;
+
+		reached_count += depth_reached_count;
+	}
+}
+
+
+/**
+ * Allocates and fills the tables of the solver
+ *
+ * @param threads_count - the number of threads building the pruning tables,
+ * 	1 to MAX_THREADS_COUNT
+ *
+ * @return - the tables, or NULL if the allocation failed
+ */
+static struct rba_solver_tables * rba_create_solver_tables(size_t threads_count)
+{
+	struct rba_solver_tables * tables = malloc(sizeof(* tables));
+	uint16_t slice_moves[SLICE_COUNT][FACE_MOVES_COUNT];
+	size_t slice;
+	size_t move;
+
+	if (tables == NULL)
+		return NULL;
+
+	rba_build_moves(
+		tables->twist_moves, TWIST_COUNT,
+		rba_get_twist, rba_set_twist,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->flip_moves, FLIP_COUNT,
+		rba_get_flip, rba_set_flip,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->slice_sorted_moves, SLICE_SORTED_COUNT,
+		rba_get_slice_sorted, rba_set_slice_sorted,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->corner_permutation_moves, CORNER_PERMUTATION_COUNT,
+		rba_get_corner_permutation, rba_set_corner_permutation,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->up_edges_moves, SLICE_SORTED_COUNT,
+		rba_get_up_edges_sorted, rba_set_up_edges_sorted,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->down_edges_moves, SLICE_SORTED_COUNT,
+		rba_get_down_edges_sorted, rba_set_down_edges_sorted,
+		all_moves, FACE_MOVES_COUNT);
+	rba_build_moves(
+		tables->edge_permutation_moves, EDGE_PERMUTATION_COUNT,
+		rba_get_edge_permutation, rba_set_edge_permutation,
+		phase2_moves, PHASE2_MOVES_COUNT);
+	rba_build_moves(
+		tables->pocket_permutation_moves, POCKET_PERMUTATION_COUNT,
+		rba_get_pocket_permutation, rba_set_pocket_permutation,
+		pocket_moves, POCKET_MOVES_COUNT);
+	rba_build_moves(
+		tables->pocket_twist_moves, POCKET_TWIST_COUNT,
+		rba_get_pocket_twist, rba_set_pocket_twist,
+		pocket_moves, POCKET_MOVES_COUNT);
+
+	/* the positions of the slice edges only, for the tables of phase 1 */
+	for (slice = 0; slice < SLICE_COUNT; slice++)
+	{
+		for (move = 0; move < FACE_MOVES_COUNT; move++)
+		{
+			slice_moves[slice][move] = (uint16_t)
+				(tables->slice_sorted_moves[slice * SLICE_PERMUTATION_COUNT][move] / SLICE_PERMUTATION_COUNT);
+		}
+	}
+
+	rba_build_distances(
+		tables->slice_twist_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) slice_moves, SLICE_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->twist_moves, TWIST_COUNT,
+		all_moves, FACE_MOVES_COUNT, threads_count);
+	rba_build_distances(
+		tables->slice_flip_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) slice_moves, SLICE_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->flip_moves, FLIP_COUNT,
+		all_moves, FACE_MOVES_COUNT, threads_count);
+	rba_build_distances(
+		tables->twist_flip_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->twist_moves, TWIST_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->flip_moves, FLIP_COUNT,
+		all_moves, FACE_MOVES_COUNT, threads_count);
+	rba_build_distances(
+		tables->slice_corner_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->slice_sorted_moves, SLICE_PERMUTATION_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->corner_permutation_moves, CORNER_PERMUTATION_COUNT,
+		phase2_moves, PHASE2_MOVES_COUNT, threads_count);
+	rba_build_distances(
+		tables->slice_edge_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->slice_sorted_moves, SLICE_PERMUTATION_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->edge_permutation_moves, EDGE_PERMUTATION_COUNT,
+		phase2_moves, PHASE2_MOVES_COUNT, threads_count);
+
+	/* every state of a 2x2x2 cube, the distances are exact */
+	rba_build_distances(
+		tables->pocket_distances,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->pocket_permutation_moves, POCKET_PERMUTATION_COUNT,
+		(uint16_t const (*)[FACE_MOVES_COUNT]) tables->pocket_twist_moves, POCKET_TWIST_COUNT,
+		pocket_moves, POCKET_MOVES_COUNT, threads_count);
+
+	return tables;
+}
+
+
+/**
+ * Moves the phase 1 coordinates by a move, unless it leads further than the
+ * remaining number of moves
+ *
+ * @param tables - the tables of the solver
+ *
+ * @param coordinates - the twist, flip and slice coordinates to move
+ *
+ * @param move - the face move to make
+ *
+ * @param remaining - the number of moves left to make, including this one
+ *
+ * @return - 1 if the coordinates were moved, 0 if the move is pruned
+ */
+static int rba_move_phase1_coordinates(
+	struct rba_solver_tables const * tables,
+	unsigned int coordinates[3],
+	unsigned int move,
+	size_t remaining)
+{
+	unsigned int twist = tables->twist_moves[coordinates[0]][move];
+	unsigned int flip = tables->flip_moves[coordinates[1]][move];
+	unsigned int slice = tables->slice_sorted_moves[coordinates[2] * SLICE_PERMUTATION_COUNT][move]
+		/ SLICE_PERMUTATION_COUNT;
+
+	if ((rba_get_distance(tables->slice_twist_distances, slice * TWIST_COUNT + twist) >= remaining)
+		|| (rba_get_distance(tables->slice_flip_distances, slice * FLIP_COUNT + flip) >= remaining)
+		|| (rba_get_distance(tables->twist_flip_distances, twist * FLIP_COUNT + flip) >= remaining))
+		return 0;
+
+	coordinates[0] = twist;
+	coordinates[1] = flip;
+	coordinates[2] = slice;
+
+	return 1;
+}
+
+
+/**
+ * Looks for the moves of phase 2 solving the cube, with exactly the given
+ * number of moves
+ *
+ * @param search - the state of the search
+ *
+ * @param corners - the corner permutation coordinate
+ *
+ * @param edges - the edge permutation coordinate
+ *
+ * @param slice - the slice permutation coordinate
+ *
+ * @param depth - the number of moves already made
+ *
+ * @param remaining - the number of moves left to make
+ *
+ * @return - 1 if a solution was found, 0 otherwise
+ */
+static int rba_search_phase2(
+	struct rba_search * search,
+	unsigned int corners,
+	unsigned int edges,
+	unsigned int slice,
+	size_t depth,
+	size_t remaining)
+{
+	struct rba_solver_tables const * tables = search->tables;
+	unsigned int previous_face = (depth > 0) ? FACE_MOVE_FACE(search->moves[depth - 1]) : NO_FACE;
+	size_t index;
+
+	if (search->unit > * search->solved_unit)
+		return 0;
+
+	if (remaining == 0)
+		return (corners == 0) && (edges == 0) && (slice == 0);
+
+	for (index = 0; index < PHASE2_MOVES_COUNT; index++)
+	{
+		unsigned int move = phase2_moves[index];
+		unsigned int next_corners;
+		unsigned int next_edges;
+		unsigned int next_slice;
+		unsigned int corners_distance;
+		unsigned int edges_distance;
+
+		if (rba_is_redundant_move(previous_face, move))
+			continue;
+
+		next_corners = tables->corner_permutation_moves[corners][move];
+		next_edges = tables->edge_permutation_moves[edges][move];
+		next_slice = tables->slice_sorted_moves[slice][move];
+		corners_distance = rba_get_distance(
+			tables->slice_corner_distances,
+			next_slice * CORNER_PERMUTATION_COUNT + next_corners);
+		edges_distance = rba_get_distance(
+			tables->slice_edge_distances,
+			next_slice * EDGE_PERMUTATION_COUNT + next_edges);
+		if ((corners_distance >= remaining) || (edges_distance >= remaining))
+			continue;
+
+		search->moves[depth] = (uint8_t) move;
+		if (rba_search_phase2(search, next_corners, next_edges, next_slice, depth + 1, remaining - 1))
+			return 1;
+	}
+
+	return 0;
+}
+
+
+/**
+ * Looks for the shortest phase 2 completing the moves of phase 1
+ *
+ * @param search - the state of the search
+ *
+ * @param phase1_length - the number of moves of phase 1
+ *
+ * @return - the number of moves of the solution, 0 if none fits
+ */
+static size_t rba_start_phase2(struct rba_search * search, size_t phase1_length)
+{
+	struct rba_solver_tables const * tables = search->tables;
+	size_t max_phase2_length = search->max_length - phase1_length;
+	unsigned int corners = search->corners;
+	unsigned int slice = search->slice_sorted;
+	unsigned int up_edges = search->up_edges;
+	unsigned int down_edges = search->down_edges;
+	unsigned int edges;
+	size_t phase2_length;
+	size_t index;
+
+	for (index = 0; index < phase1_length; index++)
+	{
+		unsigned int move = search->moves[index];
+
+		corners = tables->corner_permutation_moves[corners][move];
+		slice = tables->slice_sorted_moves[slice][move];
+		up_edges = tables->up_edges_moves[up_edges][move];
+		down_edges = tables->down_edges_moves[down_edges][move];
+	}
+
+	/* the edges of the U and D faces are back on these faces in phase 2 */
+	edges = rba_merge_edge_permutation(up_edges, down_edges);
+
+	phase2_length = rba_get_distance(tables->slice_corner_distances, slice * CORNER_PERMUTATION_COUNT + corners);
+	if (phase2_length < rba_get_distance(tables->slice_edge_distances, slice * EDGE_PERMUTATION_COUNT + edges))
+		phase2_length = rba_get_distance(tables->slice_edge_distances, slice * EDGE_PERMUTATION_COUNT + edges);
+
+	if (max_phase2_length > MAX_PHASE2_LENGTH)
+		max_phase2_length = MAX_PHASE2_LENGTH;
+
+	for (; phase2_length <= max_phase2_length; phase2_length++)
+	{
+		if (rba_search_phase2(search, corners, edges, slice, phase1_length, phase2_length))
+			return phase1_length + phase2_length;
+	}
+
+	return 0;
+}
+
+
+/**
+ * Looks for the moves of phase 1 bringing the cube in the subgroup of phase
+ * 2, with exactly the given number of moves, then completes them with phase 2
+ *
+ * @param search - the state of the search
+ *
+ * @param twist - the twist coordinate
+ *
+ * @param flip - the flip coordinate
+ *
+ * @param slice - the slice coordinate
+ *
+ * @param depth - the number of moves already made
+ *
+ * @param remaining - the number of moves left to make
+ *
+ * @return - the number of moves of the solution, 0 if none was found
+ */
+static size_t rba_search_phase1(
+	struct rba_search * search,
+	unsigned int twist,
+	unsigned int flip,
+	unsigned int slice,
+	size_t depth,
+	size_t remaining)
+{
+	unsigned int previous_face = (depth > 0) ? FACE_MOVE_FACE(search->moves[depth - 1]) : NO_FACE;
+	unsigned int move;
+
+	if (search->unit > * search->solved_unit)
+		return 0;
+
+	if (remaining == 0)
+	{
+		if ((twist != 0) || (flip != 0) || (slice != 0))
+			return 0;
+
+		/* ending with a move of phase 2, the subgroup was already reached */
+		if ((depth > 0) && rba_is_phase2_move(search->moves[depth - 1]))
+			return 0;
+
+		return rba_start_phase2(search, depth);
+	}
+
+	for (move = 0; move < FACE_MOVES_COUNT; move++)
+	{
+		unsigned int coordinates[3];
+		size_t length;
+
+		if (rba_is_redundant_move(previous_face, move))
+			continue;
+
+		coordinates[0] = twist;
+		coordinates[1] = flip;
+		coordinates[2] = slice;
+		if (! rba_move_phase1_coordinates(search->tables, coordinates, move, remaining))
+			continue;
+
+		search->moves[depth] = (uint8_t) move;
+		length = rba_search_phase1(search, coordinates[0], coordinates[1], coordinates[2], depth + 1, remaining - 1);
+		if (length > 0)
+			return length;
+	}
+
+	return 0;
+}
+
+
+/**
+ * Searches a unit of a parallel search
+ *
+ * @param parallel - the shared search
+ *
+ * @param search - the search of the thread, its unit is set
+ *
+ * @return - the number of moves of the solution, 0 if the unit has none
+ */
+static size_t rba_search_unit(struct rba_parallel_search const * parallel, struct rba_search * search)
+{
+	size_t phase1_length = SPLIT_DEPTH + search->unit / parallel->prefixes_count;
+	uint8_t const * prefix = parallel->prefixes[search->unit % parallel->prefixes_count];
+	unsigned int coordinates[3];
+	size_t depth;
+
+	coordinates[0] = parallel->twist;
+	coordinates[1] = parallel->flip;
+	coordinates[2] = parallel->slice;
+
+	for (depth = 0; depth < SPLIT_DEPTH; depth++)
+	{
+		if (! rba_move_phase1_coordinates(search->tables, coordinates, prefix[depth], phase1_length - depth))
+			return 0;
+
+		search->moves[depth] = prefix[depth];
+	}
+
+	return rba_search_phase1(
+		search,
+		coordinates[0],
+		coordinates[1],
+		coordinates[2],
+		SPLIT_DEPTH,
+		phase1_length - SPLIT_DEPTH);
+}
+
+
+/**
+ * Searches units of a parallel search until none is left or a previous unit
+ * has a solution, run by every thread
+ *
+ * @param parallel - the shared search, see rba_parallel_search
+ *
+ * @return - NULL
+ */
+static void * rba_search_units(void * parallel)
+{
+	struct rba_parallel_search * shared = parallel;
+	struct rba_search search = shared->search;
+
+	search.solved_unit = & shared->solved_unit;
+
+	for (;;)
+	{
+		size_t length;
+
+		search.unit = __sync_fetch_and_add(& shared->next_unit, 1);
+		if ((search.unit >= shared->units_count) || (search.unit > shared->solved_unit))
+			break;
+
+		length = rba_search_unit(shared, & search);
+		if (length == 0)
+			continue;
+
+		pthread_mutex_lock(& shared->mutex);
+		if (search.unit < shared->solved_unit)
+		{
+			shared->solved_unit = search.unit;
+			shared->length = length;
+			memcpy(shared->moves, search.moves, length);
+		}
+		pthread_mutex_unlock(& shared->mutex);
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Looks for a solution with phase 1 lengths from SPLIT_DEPTH with several
+ * threads, the calling one included
+ *
+ * @param parallel - the shared search, its search, coordinates and mutex are
+ * 	set
+ *
+ * @param threads_count - the number of threads, 2 to MAX_THREADS_COUNT
+ *
+ * @return - the number of moves of the solution, written to the search of
+ * 	parallel, 0 if none was found
+ */
+static size_t rba_search_in_parallel(struct rba_parallel_search * parallel, size_t threads_count)
+{
+	pthread_t threads[MAX_THREADS_COUNT];
+	size_t started_count = 0;
+	unsigned int first_move;
+	unsigned int second_move;
+	size_t thread;
+
+	parallel->prefixes_count = 0;
+	for (first_move = 0; first_move < FACE_MOVES_COUNT; first_move++)
+	{
+		for (second_move = 0; second_move < FACE_MOVES_COUNT; second_move++)
+		{
+			if (rba_is_redundant_move(FACE_MOVE_FACE(first_move), second_move))
+				continue;
+
+			parallel->prefixes[parallel->prefixes_count][0] = (uint8_t) first_move;
+			parallel->prefixes[parallel->prefixes_count][1] = (uint8_t) second_move;
+			parallel->prefixes_count++;
+		}
+	}
+
+	parallel->units_count = (parallel->search.max_length + 1 - SPLIT_DEPTH) * parallel->prefixes_count;
+	parallel->next_unit = 0;
+	parallel->solved_unit = parallel->units_count;
+	parallel->length = 0;
+
+	/* threads failing to start leave their units to the others */
+	for (thread = 1; thread < threads_count; thread++)
+	{
+		if (pthread_create(threads + started_count, NULL, rba_search_units, parallel) == 0)
+			started_count++;
+	}
+	rba_search_units(parallel);
+	for (thread = 0; thread < started_count; thread++)
+		pthread_join(threads[thread], NULL);
+
+	memcpy(parallel->search.moves, parallel->moves, parallel->length);
+
+	return parallel->length;
+}
+
+
+/**
+ * Gives the tables of the solver, building them if none were built or loaded
+ * yet
+ *
+ * @param threads_count - the number of threads building the pruning tables,
+ * 	0 for 1 per processor
+ *
+ * @return - the tables, or NULL if they couldn't be allocated
+ */
+static struct rba_solver_tables const * rba_provide_solver_tables(size_t threads_count)
+{
+	struct rba_solver_tables const * tables;
+
+	/* once set, the tables never change, they are read without locking */
+	tables = __atomic_load_n(& solver_tables, __ATOMIC_ACQUIRE);
+	if (tables != NULL)
+		return tables;
+
+	pthread_mutex_lock(& solver_tables_mutex);
+	if (solver_tables == NULL)
+		__atomic_store_n(& solver_tables, rba_create_solver_tables(rba_count_threads(threads_count)), __ATOMIC_RELEASE);
+	tables = solver_tables;
+	pthread_mutex_unlock(& solver_tables_mutex);
+
+	return tables;
+}
+
+
+
+
+struct rba_solver_tables const * rba_get_solver_tables(void)
+{
+	return rba_provide_solver_tables(0);
+}
+
+
+struct rba_solver_tables const * rba_install_solver_tables(struct rba_solver_tables const * tables)
+{
+	pthread_mutex_lock(& solver_tables_mutex);
+	if (solver_tables == NULL)
+		__atomic_store_n(& solver_tables, tables, __ATOMIC_RELEASE);
+	tables = solver_tables;
+	pthread_mutex_unlock(& solver_tables_mutex);
+
+	return tables;
+}
+
+
+size_t rba_solve_cubie_cube(
+	struct rba_cubie_cube const * cube,
+	size_t max_length,
+	rba_move_code solution[],
+	size_t threads_count)
+{
+	struct rba_cubie_cube solved_cube;
+	struct rba_parallel_search parallel;
+	struct rba_search * search = & parallel.search;
+	size_t phase1_length;
+	size_t length = 0;
+	size_t index;
+
+	rba_init_cubie_cube(& solved_cube);
+	if (memcmp(cube, & solved_cube, sizeof(solved_cube)) == 0)
+		return 0;
+
+	search->tables = rba_get_solver_tables();
+	if (search->tables == NULL)
+		return 0;
+
+	search->corners = rba_get_corner_permutation(cube);
+	search->slice_sorted = rba_get_slice_sorted(cube);
+	search->up_edges = rba_get_up_edges_sorted(cube);
+	search->down_edges = rba_get_down_edges_sorted(cube);
+	search->max_length = (max_length < MAX_SOLUTION_LENGTH) ? max_length : MAX_SOLUTION_LENGTH;
+	search->unit = 0;
+	search->solved_unit = & no_solved_unit;
+	parallel.twist = rba_get_twist(cube);
+	parallel.flip = rba_get_flip(cube);
+	parallel.slice = rba_get_slice_sorted(cube) / SLICE_PERMUTATION_COUNT;
+	threads_count = rba_count_threads(threads_count);
+
+	/* longer phases 1 than needed may allow shorter phases 2 */
+	for (phase1_length = 0; (length == 0) && (phase1_length <= search->max_length); phase1_length++)
+	{
+		/* too few subtrees before, the split ones are searched at once */
+		if ((threads_count > 1) && (phase1_length == SPLIT_DEPTH))
+		{
+			pthread_mutex_init(& parallel.mutex, NULL);
+			length = rba_search_in_parallel(& parallel, threads_count);
+			pthread_mutex_destroy(& parallel.mutex);
+			break;
+		}
+
+		length = rba_search_phase1(search, parallel.twist, parallel.flip, parallel.slice, 0, phase1_length);
+	}
+
+	for (index = 0; index < length; index++)
+		solution[index] = rba_face_move_codes[search->moves[index]];
+
+	return length;
+}
+
+
+size_t rba_solve_pocket_coordinates(
+	unsigned int permutation,
+	unsigned int twist,
+	size_t max_length,
+	rba_move_code solution[])
+{
+	struct rba_solver_tables const * tables = rba_get_solver_tables();
+	unsigned int distance;
+	size_t length;
+
+	if (tables == NULL)
+		return 0;
+
+	distance = rba_get_distance(tables->pocket_distances, permutation * POCKET_TWIST_COUNT + twist);
+	if (distance > max_length)
+		return 0;
+
+	/* a move 1 closer always exists, the first one is taken */
+	for (length = 0; length < distance; length++)
+	{
+		unsigned int next_permutation = permutation;
+		unsigned int next_twist = twist;
+		size_t move;
+
+		for (move = 0; move < POCKET_MOVES_COUNT; move++)
+		{
+			next_permutation = tables->pocket_permutation_moves[permutation][pocket_moves[move]];
+			next_twist = tables->pocket_twist_moves[twist][pocket_moves[move]];
+
+			if (rba_get_distance(tables->pocket_distances, next_permutation * POCKET_TWIST_COUNT + next_twist)
+				== distance - length - 1)
+				break;
+		}
+
+		solution[length] = rba_face_move_codes[pocket_moves[move]];
+		permutation = next_permutation;
+		twist = next_twist;
+	}
+
+	return distance;
+}
+
+
+enum rba_tables_status rba_build_solver_tables(size_t threads_count)
+{
+	return (rba_provide_solver_tables(threads_count) != NULL) ? TABLES_OK : TABLES_OUT_OF_MEMORY;
+}
+
+
+size_t rba_solve_cube(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length)
+{
+	return rba_solve_cube_parallel(cube, moves, max_length, 1);
+}
+
+
+size_t rba_solve_cube_parallel(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length,
+	size_t threads_count)
+{
+	struct rba_cubie_cube cubie_cube;
+
+	if (! rba_read_cube(cube, & cubie_cube))
+		return 0;
+
+	return rba_solve_cubie_cube(& cubie_cube, max_length, moves, threads_count);
+}
+
+
+size_t rba_solve_pocket_cube(
+	struct rba_cube const * cube,
+	rba_move_code * moves,
+	size_t max_length)
+{
+	struct rba_cubie_cube cubie_cube;
+
+	if (! rba_read_pocket_cube(cube, & cubie_cube))
+		return 0;
+
+	return rba_solve_pocket_coordinates(
+		rba_get_pocket_permutation(& cubie_cube),
+		rba_get_pocket_twist(& cubie_cube),
+		max_length,
+		moves);
+}
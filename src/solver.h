@@ -0,0 +1,170 @@
+#ifndef RUBIKS_ALGOS_SOLVER_HEADER
+#define RUBIKS_ALGOS_SOLVER_HEADER
+
+#include "cubie.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of moves of the longest solution the solver looks for, any
+ * state can be solved in 20 moves
+ */
+#define MAX_SOLUTION_LENGTH 30
+
+
+/**
+ * The number of bytes of a pruning table, 2 distances are packed per byte
+ */
+#define DISTANCES_SIZE(count) (((count) + 1) / 2)
+
+
+
+
+/**
+ * The tables of the solver, built once or loaded from a file, see
+ * rba_save_solver_tables()
+ * Move tables give the coordinate reached by each face move from each
+ * coordinate, pruning tables give a lower bound of the number of moves to
+ * reach the goal of a phase from each pair of coordinates
+ */
+struct rba_solver_tables
+{
+	uint16_t twist_moves[TWIST_COUNT][FACE_MOVES_COUNT];
+	uint16_t flip_moves[FLIP_COUNT][FACE_MOVES_COUNT];
+	uint16_t slice_sorted_moves[SLICE_SORTED_COUNT][FACE_MOVES_COUNT];
+	uint16_t corner_permutation_moves[CORNER_PERMUTATION_COUNT][FACE_MOVES_COUNT];
+
+	/**
+	 * The edges of the U and D faces, followed through phase 1 to get the
+	 * edge permutation of phase 2, see rba_merge_edge_permutation()
+	 */
+	uint16_t up_edges_moves[SLICE_SORTED_COUNT][FACE_MOVES_COUNT];
+	uint16_t down_edges_moves[SLICE_SORTED_COUNT][FACE_MOVES_COUNT];
+
+	/**
+	 * Only filled for the moves of phase 2
+	 */
+	uint16_t edge_permutation_moves[EDGE_PERMUTATION_COUNT][FACE_MOVES_COUNT];
+
+	/**
+	 * Phase 1, indexed by slice * TWIST_COUNT + twist
+	 */
+	uint8_t slice_twist_distances[DISTANCES_SIZE(SLICE_COUNT * TWIST_COUNT)];
+
+	/**
+	 * Phase 1, indexed by slice * FLIP_COUNT + flip
+	 */
+	uint8_t slice_flip_distances[DISTANCES_SIZE(SLICE_COUNT * FLIP_COUNT)];
+
+	/**
+	 * Phase 1, indexed by twist * FLIP_COUNT + flip
+	 */
+	uint8_t twist_flip_distances[DISTANCES_SIZE(TWIST_COUNT * FLIP_COUNT)];
+
+	/**
+	 * Phase 2, indexed by slice permutation * CORNER_PERMUTATION_COUNT +
+	 * corner permutation
+	 */
+	uint8_t slice_corner_distances[DISTANCES_SIZE(SLICE_PERMUTATION_COUNT * CORNER_PERMUTATION_COUNT)];
+
+	/**
+	 * Phase 2, indexed by slice permutation * EDGE_PERMUTATION_COUNT + edge
+	 * permutation
+	 */
+	uint8_t slice_edge_distances[DISTANCES_SIZE(SLICE_PERMUTATION_COUNT * EDGE_PERMUTATION_COUNT)];
+
+	/**
+	 * The corners of a 2x2x2 cube, only filled for the moves of the U, R and
+	 * F faces, see rba_get_pocket_permutation()
+	 */
+	uint16_t pocket_permutation_moves[POCKET_PERMUTATION_COUNT][FACE_MOVES_COUNT];
+	uint16_t pocket_twist_moves[POCKET_TWIST_COUNT][FACE_MOVES_COUNT];
+
+	/**
+	 * The exact distance of every state of a 2x2x2 cube, indexed by pocket
+	 * permutation * POCKET_TWIST_COUNT + pocket twist
+	 */
+	uint8_t pocket_distances[DISTANCES_SIZE(POCKET_PERMUTATION_COUNT * POCKET_TWIST_COUNT)];
+};
+
+
+
+
+/**
+ * Gives the tables of the solver, building them if none were built or loaded
+ * yet
+ *
+ * @return - the tables, or NULL if they couldn't be allocated
+ */
+struct rba_solver_tables const * rba_get_solver_tables(void);
+
+
+/**
+ * Makes the solver use the given tables, unless some were already built or
+ * loaded
+ *
+ * @param tables - the tables to use, they must outlive every solve
+ *
+ * @return - the tables the solver uses, the given ones or the previous ones
+ */
+struct rba_solver_tables const * rba_install_solver_tables(struct rba_solver_tables const * tables);
+
+
+/**
+ * Finds a solution of a cube with the two-phase algorithm, only face moves
+ * are used
+ * The tables of the solver are built on the first call
+ *
+ * @param cube - the cube to solve
+ *
+ * @param max_length - the maximum number of moves of the solution
+ *
+ * @param solution - the buffer to write the codes of the moves to, at least
+ * 	max_length codes or MAX_SOLUTION_LENGTH codes if it is lower
+ *
+ * @param threads_count - the number of threads searching, 0 for 1 per
+ * 	processor, the solution is the same whatever the number of threads
+ *
+ * @return - the number of moves of the solution, 0 if the cube is solved,
+ * 	has no solution of at most max_length moves or if the tables couldn't be
+ * 	allocated
+ */
+size_t rba_solve_cubie_cube(
+	struct rba_cubie_cube const * cube,
+	size_t max_length,
+	rba_move_code solution[],
+	size_t threads_count);
+
+
+
+/**
+ * Finds an optimal solution of a 2x2x2 cube, descending its distance table:
+ * each move leads to a state 1 move closer, only U, R and F moves are used
+ * The tables of the solver are built on the first call
+ *
+ * @param permutation - the pocket permutation of the cube, see
+ * 	rba_get_pocket_permutation()
+ *
+ * @param twist - the pocket twist of the cube, see rba_get_pocket_twist()
+ *
+ * @param max_length - the maximum number of moves of the solution
+ *
+ * @param solution - the buffer to write the codes of the moves to, at least
+ * 	max_length codes or POCKET_MAX_LENGTH codes if it is lower
+ *
+ * @return - the number of moves of the solution, 0 if the cube is solved,
+ * 	needs more than max_length moves or if the tables couldn't be allocated
+ */
+size_t rba_solve_pocket_coordinates(
+	unsigned int permutation,
+	unsigned int twist,
+	size_t max_length,
+	rba_move_code solution[]);
+
+
+
+
+#endif /* RUBIKS_ALGOS_SOLVER_HEADER */
@@ -0,0 +1,118 @@
+#include <stdlib.h>
+
+#include "random.h"
+#include "moves.h"
+#include "notation.h"
+#include "scramble.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The number of bytes a move takes in the stream in the worst case, its
+ * symbols and its separator
+ */
+#define MAX_STREAMED_MOVE_LENGTH (MAX_MOVE_LENGTH + 1)
+
+
+
+
+/**
+ * An endless scramble, only the generator and the last axis are kept so any
+ * number of moves runs in constant memory
+ */
+struct rba_stream
+{
+	/**
+	 * The random generator to draw moves from
+	 */
+	struct rba_context context;
+
+	/**
+	 * The options the moves are generated with
+	 */
+	enum rba_option flags;
+
+	/**
+	 * The axis of the last generated move, NO_AXIS before the first one
+	 */
+	enum rba_axis previous_axis;
+};
+
+
+
+
+struct rba_stream * rba_create_stream(uint64_t seed, enum rba_option flags)
+{
+	struct rba_stream * stream;
+
+	/* a random state is a whole scramble, it has no next move */
+	if (flags & RANDOM_STATE)
+		return NULL;
+
+	stream = malloc(sizeof(* stream));
+	if (stream == NULL)
+		return NULL;
+
+	rba_seed_context(& stream->context, seed);
+	stream->flags = flags;
+	stream->previous_axis = NO_AXIS;
+
+	return stream;
+}
+
+
+void rba_destroy_stream(struct rba_stream * stream)
+{
+	free(stream);
+}
+
+
+rba_move_code rba_stream_next_move(struct rba_stream * stream)
+{
+	rba_move_code move;
+
+	rba_generate_random_moves(
+		& stream->context,
+		stream->flags,
+		& move,
+		1,
+		stream->previous_axis);
+	stream->previous_axis = rba_moves_by_code[move] & AXIS_MASK;
+
+	return move;
+}
+
+
+size_t rba_stream_fill(struct rba_stream * stream, char * buffer, size_t capacity)
+{
+	rba_move_code moves[MOVES_CHUNK_SIZE];
+	size_t writen_bytes = 0;
+
+	/* only as many moves as surely fit are drawn, none is ever dropped */
+	while (capacity - writen_bytes >= MAX_STREAMED_MOVE_LENGTH)
+	{
+		size_t count = (capacity - writen_bytes) / MAX_STREAMED_MOVE_LENGTH;
+
+		if (count > MOVES_CHUNK_SIZE)
+			count = MOVES_CHUNK_SIZE;
+
+		rba_generate_random_moves(
+			& stream->context,
+			stream->flags,
+			moves,
+			count,
+			stream->previous_axis);
+		stream->previous_axis = rba_moves_by_code[moves[count - 1]] & AXIS_MASK;
+
+		writen_bytes += rba_write_moves(
+			moves,
+			count,
+			buffer + writen_bytes,
+			capacity - writen_bytes);
+	}
+
+	return writen_bytes;
+}
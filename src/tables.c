@@ -0,0 +1,261 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "random.h"
+#include "solver.h"
+
+#include "../include/rubiks_algos.h"
+
+
+
+
+/**
+ * The first bytes of a tables file
+ */
+#define TABLES_MAGIC "RBA-TBLS"
+#define TABLES_MAGIC_SIZE 8
+
+
+/**
+ * The version of the format of tables files, to increase whenever the
+ * tables of the solver change
+ */
+#define TABLES_VERSION 3
+
+
+/**
+ * Written in the byte order of the machine, it reads 0x04030201 on a machine
+ * with the other byte order
+ */
+#define TABLES_BYTE_ORDER 0x01020304UL
+#define SWAPPED_TABLES_BYTE_ORDER 0x04030201UL
+
+
+/**
+ * The size of the header of a tables file, the tables follow it, aligned as
+ * any type
+ */
+#define TABLES_HEADER_SIZE 64
+
+
+/**
+ * The room for the process identifier and the suffix of a temporary name
+ */
+#define TEMPORARY_SUFFIX_SIZE 32
+
+
+/**
+ * The offset basis and prime of the 64 bits FNV-1a hash
+ */
+#define CHECKSUM_BASIS UINT64_CONSTANT(0xCBF29CE4, 0x84222325)
+#define CHECKSUM_PRIME UINT64_CONSTANT(0x00000100, 0x000001B3)
+
+
+
+
+/**
+ * The header of a tables file
+ */
+struct rba_tables_header
+{
+	/**
+	 * TABLES_MAGIC, without NULL-terminating byte
+	 */
+	char magic[TABLES_MAGIC_SIZE];
+
+	/**
+	 * TABLES_VERSION
+	 */
+	uint32_t version;
+
+	/**
+	 * TABLES_BYTE_ORDER, as written by the machine
+	 */
+	uint32_t byte_order;
+
+	/**
+	 * The number of bytes of the tables
+	 */
+	uint64_t tables_size;
+
+	/**
+	 * The checksum of the tables, see rba_compute_checksum()
+	 */
+	uint64_t checksum;
+};
+
+
+
+
+/**
+ * Computes the checksum of some data, the FNV-1a hash of its 64 bits words,
+ * so hashing megabytes takes about a millisecond
+ *
+ * @param data - the data to hash
+ *
+ * @param size - the number of bytes of the data
+ *
+ * @return - the checksum
+ */
+static uint64_t rba_compute_checksum(void const * data, size_t size)
+{
+	unsigned char const * bytes = data;
+	uint64_t checksum = CHECKSUM_BASIS;
+	size_t index;
+
+	for (index = 0; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t))
+	{
+		uint64_t word;
+
+		memcpy(& word, bytes + index, sizeof(word));
+		checksum = (checksum ^ word) * CHECKSUM_PRIME;
+	}
+
+	for (; index < size; index++)
+		checksum = (checksum ^ bytes[index]) * CHECKSUM_PRIME;
+
+	return checksum;
+}
+
+
+/**
+ * Checks the header of a mapped tables file
+ *
+ * @param file - the mapped file
+ *
+ * @param file_size - the size of the file
+ *
+ * @param verify_checksum - whether to check the content of the tables
+ *
+ * @return - TABLES_OK if the tables can be used, an error otherwise
+ */
+static enum rba_tables_status rba_check_tables_file(
+	unsigned char const * file,
+	size_t file_size,
+	int verify_checksum)
+{
+	struct rba_tables_header header;
+
+	if (file_size < TABLES_HEADER_SIZE)
+		return TABLES_INVALID_FILE;
+
+	memcpy(& header, file, sizeof(header));
+	if (memcmp(header.magic, TABLES_MAGIC, TABLES_MAGIC_SIZE) != 0)
+		return TABLES_INVALID_FILE;
+
+	/* the other fields are only meaningful in the byte order of the machine */
+	if (header.byte_order == SWAPPED_TABLES_BYTE_ORDER)
+		return TABLES_ENDIANNESS_MISMATCH;
+	if (header.byte_order != TABLES_BYTE_ORDER)
+		return TABLES_INVALID_FILE;
+
+	if ((header.version != TABLES_VERSION) || (header.tables_size != sizeof(struct rba_solver_tables)))
+		return TABLES_VERSION_MISMATCH;
+	if (file_size != TABLES_HEADER_SIZE + sizeof(struct rba_solver_tables))
+		return TABLES_INVALID_FILE;
+
+	if (verify_checksum && (rba_compute_checksum(file + TABLES_HEADER_SIZE, header.tables_size) != header.checksum))
+		return TABLES_CHECKSUM_MISMATCH;
+
+	return TABLES_OK;
+}
+
+
+
+
+enum rba_tables_status rba_save_solver_tables(char const * path)
+{
+	struct rba_solver_tables const * tables = rba_get_solver_tables();
+	unsigned char header_bytes[TABLES_HEADER_SIZE];
+	struct rba_tables_header header;
+	char * temporary_path;
+	FILE * file;
+	int written;
+
+	if (tables == NULL)
+		return TABLES_OUT_OF_MEMORY;
+
+	memcpy(header.magic, TABLES_MAGIC, TABLES_MAGIC_SIZE);
+	header.version = TABLES_VERSION;
+	header.byte_order = TABLES_BYTE_ORDER;
+	header.tables_size = sizeof(* tables);
+	header.checksum = rba_compute_checksum(tables, sizeof(* tables));
+	memset(header_bytes, 0, sizeof(header_bytes));
+	memcpy(header_bytes, & header, sizeof(header));
+
+	/* a process per temporary file, so concurrent saves don't mix */
+	temporary_path = malloc(strlen(path) + TEMPORARY_SUFFIX_SIZE);
+	if (temporary_path == NULL)
+		return TABLES_OUT_OF_MEMORY;
+	sprintf(temporary_path, "%s.%ld.tmp", path, (long) getpid());
+
+	file = fopen(temporary_path, "wb");
+	if (file == NULL)
+	{
+		free(temporary_path);
+		return TABLES_IO_ERROR;
+	}
+
+	written = (fwrite(header_bytes, sizeof(header_bytes), 1, file) == 1)
+		&& (fwrite(tables, sizeof(* tables), 1, file) == 1);
+	written = (fclose(file) == 0) && written;
+	written = written && (rename(temporary_path, path) == 0);
+	if (! written)
+		remove(temporary_path);
+
+	free(temporary_path);
+
+	return written ? TABLES_OK : TABLES_IO_ERROR;
+}
+
+
+enum rba_tables_status rba_load_solver_tables(char const * path, int verify_checksum)
+{
+	struct rba_solver_tables const * tables;
+	enum rba_tables_status status;
+	struct stat file_status;
+	unsigned char * file;
+	int descriptor;
+
+	descriptor = open(path, O_RDONLY);
+	if (descriptor < 0)
+		return TABLES_IO_ERROR;
+
+	if (fstat(descriptor, & file_status) != 0)
+	{
+		close(descriptor);
+		return TABLES_IO_ERROR;
+	}
+	if ((size_t) file_status.st_size < TABLES_HEADER_SIZE)
+	{
+		close(descriptor);
+		return TABLES_INVALID_FILE;
+	}
+
+	/* the mapping outlives the descriptor */
+	file = mmap(NULL, file_status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+	if (file == MAP_FAILED)
+		return TABLES_IO_ERROR;
+
+	status = rba_check_tables_file(file, file_status.st_size, verify_checksum);
+	if (status != TABLES_OK)
+	{
+		munmap(file, file_status.st_size);
+		return status;
+	}
+
+	/* tables already built or loaded are kept, solves may be using them */
+	tables = (struct rba_solver_tables const *) (file + TABLES_HEADER_SIZE);
+	if (rba_install_solver_tables(tables) != tables)
+		munmap(file, file_status.st_size);
+
+	return TABLES_OK;
+}
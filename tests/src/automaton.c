@@ -0,0 +1,511 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * Long enough to span several chunks of generated moves
+ */
+#define SCRAMBLE_SIZE 200
+
+
+/**
+ * Long enough for every allowed pattern to come out
+ */
+#define LONG_SCRAMBLE_SIZE 10000
+
+
+/**
+ * The layer index of L, M and R in move codes
+ */
+#define LEFT_LAYER 0
+#define MIDDLE_LAYER 1
+#define RIGHT_LAYER 2
+
+
+/**
+ * The number of sequences of 2 moves drawn to compute statistics on
+ */
+#define STATISTICS_SIZE 63000
+
+
+/**
+ * The chi-square value with 2 degrees of freedom exceeded with a 0.1%
+ * probability
+ */
+#define CHI_SQUARE_CRITICAL_VALUE 13.82
+
+
+/**
+ * The number of modifiers of a move: none, ' and 2
+ */
+#define MODIFIERS_COUNT 3
+
+
+
+
+/**
+ * Gives the layer index of a move without wide moves
+ *
+ * @param move - the code of the move
+ *
+ * @return size_t - the layer index, 0 to 8 in L M R U E D F S B order
+ */
+static size_t get_layer(rba_move_code move)
+{
+	return move / 3;
+}
+
+
+/**
+ * Gives the axis of a move without wide moves
+ *
+ * @param move - the code of the move
+ *
+ * @return size_t - 0 for X, 1 for Y, 2 for Z
+ */
+static size_t get_axis(rba_move_code move)
+{
+	return get_layer(move) / 3;
+}
+
+
+/**
+ * Tells whether a move without wide moves turns a slice
+ *
+ * @param move - the code of the move
+ *
+ * @return int - 1 for [M], [E] and [S] moves, 0 otherwise
+ */
+static int is_slice_move(rba_move_code move)
+{
+	return get_layer(move) % 3 == 1;
+}
+
+
+/**
+ * Generates a long constrained scramble
+ *
+ * @param rules - the rules to follow
+ *
+ * @param moves - the buffer to write the codes to, LONG_SCRAMBLE_SIZE long
+ */
+static void generate_long_scramble(struct rba_scramble_rules const * rules, rba_move_code moves[])
+{
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(rules, 0);
+	size_t length;
+
+	cr_assert_not_null(automaton, "the rules should be compiled");
+	length = rba_generate_constrained_moves_r(context, automaton, moves, LONG_SCRAMBLE_SIZE);
+	cr_assert_eq(length, LONG_SCRAMBLE_SIZE, "expected %d moves, got %zu", LONG_SCRAMBLE_SIZE, length);
+
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+
+
+Test(automaton, regular_rules_match_regular_scrambles)
+{
+	enum rba_option const flags[] = { 0, USE_WIDE_MOVES, POCKET_CUBE };
+	struct rba_scramble_rules const rules = { 1, 0, 0 };
+
+	for (size_t index = 0; index < sizeof(flags) / sizeof(* flags); index++)
+	{
+		// given: 2 generators with the same seed
+		struct rba_context * constrained_context = rba_create_context(42);
+		struct rba_context * regular_context = rba_create_context(42);
+		struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, flags[index]);
+		rba_move_code constrained_moves[SCRAMBLE_SIZE];
+		rba_move_code regular_moves[SCRAMBLE_SIZE];
+
+		// when
+		size_t constrained_length = rba_generate_constrained_moves_r(
+			constrained_context,
+			automaton,
+			constrained_moves,
+			SCRAMBLE_SIZE);
+		size_t regular_length = rba_generate_scramble_moves_r(regular_context, regular_moves, SCRAMBLE_SIZE, flags[index]);
+
+		// then
+		cr_assert_eq(constrained_length, regular_length, "flags %d: expected %zu moves, got %zu", flags[index], regular_length, constrained_length);
+		cr_assert_arr_eq(constrained_moves, regular_moves, SCRAMBLE_SIZE, "flags %d: the scrambles should be the same", flags[index]);
+
+		rba_destroy_scramble_automaton(automaton);
+		rba_destroy_context(constrained_context);
+		rba_destroy_context(regular_context);
+	}
+}
+
+
+Test(automaton, axis_runs_turn_distinct_layers)
+{
+	// given
+	struct rba_scramble_rules const rules = { 2, 0, 0 };
+	static rba_move_code moves[LONG_SCRAMBLE_SIZE];
+	int left_then_right = 0;
+	int right_then_left = 0;
+
+	// when
+	generate_long_scramble(& rules, moves);
+
+	// then
+	for (size_t move = 1; move < LONG_SCRAMBLE_SIZE; move++)
+	{
+		if (get_axis(moves[move]) != get_axis(moves[move - 1]))
+			continue;
+
+		cr_assert_neq(get_layer(moves[move]), get_layer(moves[move - 1]), "move %zu turns the layer of the previous one", move);
+		if (move > 1)
+			cr_assert_neq(get_axis(moves[move]), get_axis(moves[move - 2]), "moves %zu to %zu turn the same axis", move - 2, move);
+
+		left_then_right |= (get_layer(moves[move - 1]) == LEFT_LAYER) && (get_layer(moves[move]) == RIGHT_LAYER);
+		right_then_left |= (get_layer(moves[move - 1]) == RIGHT_LAYER) && (get_layer(moves[move]) == LEFT_LAYER);
+	}
+	cr_assert(left_then_right && right_then_left, "both [L R] and [R L] should be generated");
+}
+
+
+Test(automaton, ordered_axis_runs_follow_the_order_of_layers)
+{
+	// given
+	struct rba_scramble_rules const rules = { 3, 1, 0 };
+	static rba_move_code moves[LONG_SCRAMBLE_SIZE];
+	int full_run = 0;
+
+	// when
+	generate_long_scramble(& rules, moves);
+
+	// then
+	for (size_t move = 1; move < LONG_SCRAMBLE_SIZE; move++)
+	{
+		if (get_axis(moves[move]) != get_axis(moves[move - 1]))
+			continue;
+
+		cr_assert_gt(get_layer(moves[move]), get_layer(moves[move - 1]), "move %zu breaks the order of the run", move);
+		full_run |= (get_layer(moves[move - 1]) == MIDDLE_LAYER) && (get_layer(moves[move]) == RIGHT_LAYER)
+			&& (move > 1) && (get_layer(moves[move - 2]) == LEFT_LAYER);
+	}
+	cr_assert(full_run, "[L M R] runs should be generated");
+}
+
+
+Test(automaton, slice_moves_are_spaced)
+{
+	// given
+	struct rba_scramble_rules const rules = { 1, 0, 4 };
+	static rba_move_code moves[LONG_SCRAMBLE_SIZE];
+	size_t slices_count = 0;
+	size_t last_slice = 0;
+
+	// when
+	generate_long_scramble(& rules, moves);
+
+	// then
+	for (size_t move = 0; move < LONG_SCRAMBLE_SIZE; move++)
+	{
+		if (! is_slice_move(moves[move]))
+			continue;
+
+		if (slices_count > 0)
+			cr_assert_gt(move - last_slice, rules.slice_spacing, "moves %zu and %zu are too close slice moves", last_slice, move);
+
+		slices_count++;
+		last_slice = move;
+	}
+	cr_assert_gt(slices_count, 0, "slice moves should be generated");
+}
+
+
+Test(automaton, constrained_strings_match_move_codes)
+{
+	// given: 2 generators with the same seed
+	struct rba_scramble_rules const rules = { 3, 1, 2 };
+	struct rba_context * string_context = rba_create_context(42);
+	struct rba_context * moves_context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, USE_WIDE_MOVES);
+	size_t capacity = rba_compute_scramble_buffer_size(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * scramble = malloc(capacity);
+	char * expected_scramble = malloc(capacity);
+	rba_move_code moves[SCRAMBLE_SIZE];
+
+	// when
+	size_t length = rba_generate_constrained_scramble_into_r(string_context, automaton, scramble, capacity, SCRAMBLE_SIZE);
+	size_t moves_count = rba_generate_constrained_moves_r(moves_context, automaton, moves, SCRAMBLE_SIZE);
+	size_t expected_length = rba_write_move_codes(moves, moves_count, expected_scramble, capacity);
+
+	// then
+	cr_assert_gt(length, 0, "the scramble should fit in the buffer");
+	cr_assert_eq(length, expected_length, "expected %zu bytes, got %zu", expected_length, length);
+	cr_assert_str_eq(scramble, expected_scramble, "the string should match the codes");
+
+	free(scramble);
+	free(expected_scramble);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(string_context);
+	rba_destroy_context(moves_context);
+}
+
+
+Test(automaton, doesnt_compile_invalid_rules)
+{
+	// given
+	struct rba_scramble_rules const invalid_rules[] =
+	{
+		{ 0, 0, 0 },
+		{ 4, 0, 0 },
+		{ 1, 0, MAX_SLICE_SPACING + 1 }
+	};
+
+	for (size_t index = 0; index < sizeof(invalid_rules) / sizeof(* invalid_rules); index++)
+	{
+		// when
+		struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(invalid_rules + index, 0);
+
+		// then
+		cr_assert_null(automaton, "rules %zu are invalid", index);
+	}
+}
+
+
+Test(automaton, uniform_sequences_are_equally_likely)
+{
+	// given: with ordered runs of 2 moves, 24 sequences of 2 moves start with
+	// [L], 21 with [M] and 18 with [R], on each axis
+	struct rba_scramble_rules const rules = { 2, 1, 0 };
+	double const expected_shares[] = { 24.0 / 63.0, 21.0 / 63.0, 18.0 / 63.0 };
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	struct rba_uniform_sampler * sampler = rba_create_uniform_sampler(automaton, 2);
+	size_t counts[3] = { 0 };
+	double chi_square = 0.0;
+
+	// when
+	for (size_t sequence = 0; sequence < STATISTICS_SIZE; sequence++)
+	{
+		rba_move_code moves[2];
+		size_t length = rba_generate_uniform_moves_r(context, sampler, moves, 2);
+
+		cr_assert_eq(length, 2, "expected 2 moves, got %zu", length);
+		counts[get_layer(moves[0]) % 3]++;
+	}
+
+	// then
+	for (size_t layer = 0; layer < 3; layer++)
+	{
+		double expected_count = expected_shares[layer] * STATISTICS_SIZE;
+		double difference = counts[layer] - expected_count;
+
+		chi_square += difference * difference / expected_count;
+	}
+	cr_assert_lt(
+		chi_square,
+		CHI_SQUARE_CRITICAL_VALUE,
+		"the first moves should follow the number of sequences they start, got %zu, %zu and %zu",
+		counts[0], counts[1], counts[2]);
+
+	rba_destroy_uniform_sampler(sampler);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+Test(automaton, uniform_sequences_follow_the_rules)
+{
+	// given
+	struct rba_scramble_rules const rules = { 3, 1, 4 };
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	struct rba_uniform_sampler * sampler = rba_create_uniform_sampler(automaton, LONG_SCRAMBLE_SIZE);
+	static rba_move_code moves[LONG_SCRAMBLE_SIZE];
+	size_t last_slice = 0;
+	int sliced = 0;
+
+	// when
+	size_t length = rba_generate_uniform_moves_r(context, sampler, moves, LONG_SCRAMBLE_SIZE);
+
+	// then
+	cr_assert_not_null(sampler, "the sampler should be created");
+	cr_assert_eq(length, LONG_SCRAMBLE_SIZE, "expected %d moves, got %zu", LONG_SCRAMBLE_SIZE, length);
+	for (size_t move = 0; move < length; move++)
+	{
+		if ((move > 0) && (get_axis(moves[move]) == get_axis(moves[move - 1])))
+			cr_assert_gt(get_layer(moves[move]), get_layer(moves[move - 1]), "move %zu breaks the order of the run", move);
+
+		if (is_slice_move(moves[move]))
+		{
+			if (sliced)
+				cr_assert_gt(move - last_slice, rules.slice_spacing, "moves %zu and %zu are too close slice moves", last_slice, move);
+
+			sliced = 1;
+			last_slice = move;
+		}
+	}
+
+	rba_destroy_uniform_sampler(sampler);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+Test(automaton, uniform_strings_match_move_codes)
+{
+	// given: 2 generators with the same seed
+	struct rba_scramble_rules const rules = { 2, 0, 1 };
+	struct rba_context * string_context = rba_create_context(42);
+	struct rba_context * moves_context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, USE_WIDE_MOVES);
+	struct rba_uniform_sampler * sampler = rba_create_uniform_sampler(automaton, SCRAMBLE_SIZE);
+	size_t capacity = rba_compute_scramble_buffer_size(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * scramble = malloc(capacity);
+	char * expected_scramble = malloc(capacity);
+	rba_move_code moves[SCRAMBLE_SIZE];
+
+	// when
+	size_t length = rba_generate_uniform_scramble_into_r(string_context, sampler, scramble, capacity, SCRAMBLE_SIZE);
+	size_t moves_count = rba_generate_uniform_moves_r(moves_context, sampler, moves, SCRAMBLE_SIZE);
+	size_t expected_length = rba_write_move_codes(moves, moves_count, expected_scramble, capacity);
+
+	// then
+	cr_assert_gt(length, 0, "the scramble should fit in the buffer");
+	cr_assert_eq(length, expected_length, "expected %zu bytes, got %zu", expected_length, length);
+	cr_assert_str_eq(scramble, expected_scramble, "the string should match the codes");
+
+	free(scramble);
+	free(expected_scramble);
+	rba_destroy_uniform_sampler(sampler);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(string_context);
+	rba_destroy_context(moves_context);
+}
+
+
+Test(automaton, doesnt_sample_beyond_the_maximum_length)
+{
+	// given
+	struct rba_scramble_rules const rules = { 1, 0, MAX_SLICE_SPACING };
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	struct rba_uniform_sampler * sampler = rba_create_uniform_sampler(automaton, SCRAMBLE_SIZE);
+	rba_move_code moves[SCRAMBLE_SIZE + 1];
+
+	// when
+	size_t length = rba_generate_uniform_moves_r(context, sampler, moves, SCRAMBLE_SIZE);
+	size_t longer_length = rba_generate_uniform_moves_r(context, sampler, moves, SCRAMBLE_SIZE + 1);
+
+	// then
+	cr_assert_eq(length, SCRAMBLE_SIZE, "expected %d moves, got %zu", SCRAMBLE_SIZE, length);
+	cr_assert_eq(longer_length, 0, "the sampler draws %d moves at most, got %zu", SCRAMBLE_SIZE, longer_length);
+	cr_assert_null(rba_create_uniform_sampler(automaton, 0), "empty sequences can't be sampled");
+
+	rba_destroy_uniform_sampler(sampler);
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+Test(automaton, weighted_moves_follow_the_weights)
+{
+	// given: no slice moves, half turns twice as likely as quarter turns
+	struct rba_scramble_rules const rules = { 1, 0, 0 };
+	double const expected_shares[MODIFIERS_COUNT] = { 0.25, 0.25, 0.5 };
+	struct rba_context * context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	static rba_move_code moves[LONG_SCRAMBLE_SIZE];
+	double weights[MOVE_CODES_COUNT];
+	size_t counts[MODIFIERS_COUNT] = { 0 };
+	double chi_square = 0.0;
+	for (size_t code = 0; code < MOVE_CODES_COUNT; code++)
+		weights[code] = is_slice_move((rba_move_code) code) ? 0.0 : (code % MODIFIERS_COUNT == 2) ? 2.0 : 1.0;
+
+	// when
+	int weighted = rba_weight_scramble_moves(automaton, weights);
+	size_t length = rba_generate_constrained_moves_r(context, automaton, moves, LONG_SCRAMBLE_SIZE);
+
+	// then
+	cr_assert(weighted, "the weights should be set");
+	cr_assert_eq(length, LONG_SCRAMBLE_SIZE, "expected %d moves, got %zu", LONG_SCRAMBLE_SIZE, length);
+	for (size_t move = 0; move < length; move++)
+	{
+		cr_assert_not(is_slice_move(moves[move]), "move %zu weighs nothing", move);
+		if (move > 0)
+			cr_assert_neq(get_axis(moves[move]), get_axis(moves[move - 1]), "move %zu turns the same axis", move);
+
+		counts[moves[move] % MODIFIERS_COUNT]++;
+	}
+	for (size_t modifier = 0; modifier < MODIFIERS_COUNT; modifier++)
+	{
+		double expected_count = expected_shares[modifier] * LONG_SCRAMBLE_SIZE;
+		double difference = counts[modifier] - expected_count;
+
+		chi_square += difference * difference / expected_count;
+	}
+	cr_assert_lt(
+		chi_square,
+		CHI_SQUARE_CRITICAL_VALUE,
+		"the modifiers should follow the weights, got %zu, %zu and %zu",
+		counts[0], counts[1], counts[2]);
+
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(context);
+}
+
+
+Test(automaton, removed_weights_restore_regular_scrambles)
+{
+	// given: 2 generators with the same seed
+	struct rba_scramble_rules const rules = { 1, 0, 0 };
+	struct rba_context * constrained_context = rba_create_context(42);
+	struct rba_context * regular_context = rba_create_context(42);
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	rba_move_code constrained_moves[SCRAMBLE_SIZE];
+	rba_move_code regular_moves[SCRAMBLE_SIZE];
+	double weights[MOVE_CODES_COUNT];
+	for (size_t code = 0; code < MOVE_CODES_COUNT; code++)
+		weights[code] = 1.0 + code;
+
+	// when
+	int weighted = rba_weight_scramble_moves(automaton, weights);
+	int unweighted = rba_weight_scramble_moves(automaton, NULL);
+	size_t constrained_length = rba_generate_constrained_moves_r(constrained_context, automaton, constrained_moves, SCRAMBLE_SIZE);
+	size_t regular_length = rba_generate_scramble_moves_r(regular_context, regular_moves, SCRAMBLE_SIZE, 0);
+
+	// then
+	cr_assert(weighted && unweighted, "the weights should be set then removed");
+	cr_assert_eq(constrained_length, regular_length, "expected %zu moves, got %zu", regular_length, constrained_length);
+	cr_assert_arr_eq(constrained_moves, regular_moves, SCRAMBLE_SIZE, "the scrambles should be the same");
+
+	rba_destroy_scramble_automaton(automaton);
+	rba_destroy_context(constrained_context);
+	rba_destroy_context(regular_context);
+}
+
+
+Test(automaton, doesnt_set_invalid_weights)
+{
+	// given
+	struct rba_scramble_rules const rules = { 1, 0, 0 };
+	struct rba_scramble_automaton * automaton = rba_compile_scramble_rules(& rules, 0);
+	double negative_weights[MOVE_CODES_COUNT];
+	double x_axis_weights[MOVE_CODES_COUNT];
+	for (size_t code = 0; code < MOVE_CODES_COUNT; code++)
+	{
+		negative_weights[code] = (code == 0) ? -1.0 : 1.0;
+		x_axis_weights[code] = (get_axis((rba_move_code) code) == 0) ? 1.0 : 0.0;
+	}
+
+	// when
+	int negative_weighted = rba_weight_scramble_moves(automaton, negative_weights);
+	int x_axis_weighted = rba_weight_scramble_moves(automaton, x_axis_weights);
+
+	// then
+	cr_assert_not(negative_weighted, "weights can't be negative");
+	cr_assert_not(x_axis_weighted, "an X move can't be followed by another X move");
+
+	rba_destroy_scramble_automaton(automaton);
+}
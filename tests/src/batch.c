@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Not a multiple of the padding nor of the tiles, so partial ones are turned
+ */
+#define CUBES_COUNT 300
+
+
+/**
+ * The length of the scramble of each cube
+ */
+#define SCRAMBLE_SIZE 25
+
+
+
+
+Test(batch, new_batch_is_solved)
+{
+	// given
+	struct rba_cube_batch * batch = rba_create_cube_batch(CUBES_COUNT);
+
+	// when
+	size_t solved_count = rba_count_solved_batch_cubes(batch);
+
+	// then
+	cr_assert_eq(solved_count, CUBES_COUNT, "every cube should be solved, got %zu", solved_count);
+
+	rba_destroy_cube_batch(batch);
+}
+
+
+Test(batch, same_moves_turn_every_cube_as_a_single_cube)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	struct rba_cube_batch * batch = rba_create_cube_batch(CUBES_COUNT);
+	static struct rba_cube cubes[CUBES_COUNT];
+	rba_move_code scramble[SCRAMBLE_SIZE];
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+	{
+		size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+		rba_init_cube(cubes + index);
+		rba_apply_moves(cubes + index, scramble, length);
+		rba_set_batch_cube(batch, index, cubes + index);
+	}
+	size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+	// when
+	size_t applied_count = rba_apply_batch_moves(batch, scramble, length);
+
+	// then
+	cr_assert_eq(applied_count, length, "every move should be applied");
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+	{
+		struct rba_cube cube;
+		rba_get_batch_cube(batch, index, & cube);
+		rba_apply_moves(cubes + index, scramble, length);
+		cr_assert_arr_eq(cube.facelets, cubes[index].facelets, CUBE_SIZE, "cube %zu should have the same stickers", index);
+	}
+
+	rba_destroy_cube_batch(batch);
+	rba_destroy_context(context);
+}
+
+
+Test(batch, lane_moves_turn_each_cube_as_a_single_cube)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	struct rba_cube_batch * batch = rba_create_cube_batch(CUBES_COUNT);
+	static rba_move_code scrambles[CUBES_COUNT][SCRAMBLE_SIZE];
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+		rba_generate_scramble_moves_r(context, scrambles[index], SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+	// when
+	size_t applied_count = rba_apply_batch_lane_moves(batch, scrambles[0], SCRAMBLE_SIZE);
+
+	// then
+	cr_assert_eq(applied_count, SCRAMBLE_SIZE, "every move should be applied");
+	cr_assert_eq(rba_count_solved_batch_cubes(batch), 0, "every cube should be mixed");
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+	{
+		struct rba_cube expected_cube;
+		struct rba_cube cube;
+		rba_init_cube(& expected_cube);
+		rba_apply_moves(& expected_cube, scrambles[index], SCRAMBLE_SIZE);
+		rba_get_batch_cube(batch, index, & cube);
+		cr_assert_arr_eq(cube.facelets, expected_cube.facelets, CUBE_SIZE, "cube %zu should have the same stickers", index);
+	}
+
+	rba_destroy_cube_batch(batch);
+	rba_destroy_context(context);
+}
+
+
+Test(batch, reverse_lane_moves_solve_every_cube)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	struct rba_cube_batch * batch = rba_create_cube_batch(CUBES_COUNT);
+	static rba_move_code scrambles[CUBES_COUNT][SCRAMBLE_SIZE];
+	static rba_move_code reverse_scrambles[CUBES_COUNT][SCRAMBLE_SIZE];
+	for (size_t index = 0; index < CUBES_COUNT; index++)
+	{
+		rba_generate_scramble_moves_r(context, scrambles[index], SCRAMBLE_SIZE, USE_WIDE_MOVES);
+		for (size_t move = 0; move < SCRAMBLE_SIZE; move++)
+			reverse_scrambles[index][move] = reverse_move(scrambles[index][SCRAMBLE_SIZE - 1 - move]);
+	}
+
+	// when
+	rba_apply_batch_lane_moves(batch, scrambles[0], SCRAMBLE_SIZE);
+	rba_apply_batch_lane_moves(batch, reverse_scrambles[0], SCRAMBLE_SIZE);
+
+	// then
+	cr_assert_eq(rba_count_solved_batch_cubes(batch), CUBES_COUNT, "every cube should be solved again");
+
+	rba_destroy_cube_batch(batch);
+	rba_destroy_context(context);
+}
+
+
+Test(batch, doesnt_apply_invalid_code)
+{
+	// given
+	struct rba_cube_batch * batch = rba_create_cube_batch(2);
+	rba_move_code moves[] = { 0, MOVE_CODES_COUNT };
+
+	// when
+	size_t applied_count = rba_apply_batch_moves(batch, moves, 2);
+	size_t lane_applied_count = rba_apply_batch_lane_moves(batch, moves, 1);
+
+	// then
+	cr_assert_eq(applied_count, 0, "code %d is invalid, got %zu moves", MOVE_CODES_COUNT, applied_count);
+	cr_assert_eq(lane_applied_count, 0, "code %d is invalid, got %zu moves", MOVE_CODES_COUNT, lane_applied_count);
+	cr_assert_eq(rba_count_solved_batch_cubes(batch), 2, "the cubes should be left untouched");
+
+	rba_destroy_cube_batch(batch);
+}
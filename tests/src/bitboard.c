@@ -0,0 +1,171 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Long enough to mix every sticker many times
+ */
+#define SCRAMBLE_SIZE 1024
+
+
+/**
+ * The number of scrambles applied to both representations
+ */
+#define SCRAMBLES_COUNT 100
+
+
+
+
+Test(bitboard, solved_cube_is_solved)
+{
+	// given
+	struct rba_bitboard_cube cube;
+	struct rba_bitboard_cube packed_cube;
+	struct rba_cube unpacked_cube;
+	rba_init_cube(& unpacked_cube);
+
+	// when
+	rba_init_bitboard_cube(& cube);
+	rba_pack_cube(& unpacked_cube, & packed_cube);
+
+	// then
+	cr_assert(rba_is_bitboard_cube_solved(& cube), "a new cube should be solved");
+	cr_assert(rba_are_bitboard_cubes_equal(& cube, & packed_cube), "a packed solved cube should be the solved cube");
+}
+
+
+Test(bitboard, moves_turn_the_same_stickers_as_the_cube)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SCRAMBLES_COUNT; index++)
+	{
+		// given
+		rba_move_code scramble[SCRAMBLE_SIZE];
+		size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+		struct rba_bitboard_cube bitboard_cube;
+		struct rba_cube unpacked_cube;
+		struct rba_cube cube;
+		rba_init_bitboard_cube(& bitboard_cube);
+		rba_init_cube(& cube);
+
+		// when
+		size_t applied_count = rba_apply_bitboard_moves(& bitboard_cube, scramble, length);
+		rba_apply_moves(& cube, scramble, length);
+		rba_unpack_cube(& bitboard_cube, & unpacked_cube);
+
+		// then
+		cr_assert_eq(applied_count, length, "every move should be applied");
+		cr_assert_arr_eq(
+			unpacked_cube.facelets,
+			cube.facelets,
+			CUBE_SIZE,
+			"scramble %zu should give the same stickers",
+			index);
+		cr_assert_not(rba_is_bitboard_cube_solved(& bitboard_cube), "scramble %zu should mix the cube", index);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(bitboard, each_move_gives_a_different_state)
+{
+	struct rba_bitboard_cube cubes[MOVE_CODES_COUNT];
+
+	for (rba_move_code move = 0; move < MOVE_CODES_COUNT; move++)
+	{
+		// given
+		rba_init_bitboard_cube(cubes + move);
+
+		// when
+		rba_apply_bitboard_moves(cubes + move, & move, 1);
+
+		// then
+		for (rba_move_code other_move = 0; other_move < move; other_move++)
+		{
+			cr_assert_not(
+				rba_are_bitboard_cubes_equal(cubes + move, cubes + other_move),
+				"moves %d and %d should give different states",
+				move,
+				other_move);
+			cr_assert_neq(
+				rba_hash_bitboard_cube(cubes + move),
+				rba_hash_bitboard_cube(cubes + other_move),
+				"moves %d and %d should have different hashes",
+				move,
+				other_move);
+		}
+	}
+}
+
+
+Test(bitboard, reverse_moves_give_back_the_cube)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	rba_move_code scramble[SCRAMBLE_SIZE];
+	rba_move_code reverse_scramble[SCRAMBLE_SIZE];
+	size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	struct rba_bitboard_cube cube;
+	struct rba_bitboard_cube solved_cube;
+	for (size_t index = 0; index < length; index++)
+		reverse_scramble[index] = reverse_move(scramble[length - 1 - index]);
+	rba_init_bitboard_cube(& cube);
+	rba_init_bitboard_cube(& solved_cube);
+
+	// when
+	rba_apply_bitboard_moves(& cube, scramble, length);
+	rba_apply_bitboard_moves(& cube, reverse_scramble, length);
+
+	// then
+	cr_assert(rba_are_bitboard_cubes_equal(& cube, & solved_cube), "the cube should be solved again");
+	cr_assert_eq(rba_hash_bitboard_cube(& cube), rba_hash_bitboard_cube(& solved_cube), "equal cubes should have the same hash");
+
+	rba_destroy_context(context);
+}
+
+
+Test(bitboard, packs_and_unpacks_stickers)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	rba_move_code scramble[SCRAMBLE_SIZE];
+	size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	struct rba_bitboard_cube bitboard_cube;
+	struct rba_cube unpacked_cube;
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	rba_apply_moves(& cube, scramble, length);
+
+	// when
+	rba_pack_cube(& cube, & bitboard_cube);
+	rba_unpack_cube(& bitboard_cube, & unpacked_cube);
+
+	// then
+	cr_assert_arr_eq(unpacked_cube.facelets, cube.facelets, CUBE_SIZE, "the stickers should be unpacked as packed");
+
+	rba_destroy_context(context);
+}
+
+
+Test(bitboard, doesnt_apply_invalid_code)
+{
+	// given
+	rba_move_code moves[] = { 0, MOVE_CODES_COUNT };
+	struct rba_bitboard_cube cube;
+	rba_init_bitboard_cube(& cube);
+
+	// when
+	size_t applied_count = rba_apply_bitboard_moves(& cube, moves, 2);
+
+	// then
+	cr_assert_eq(applied_count, 0, "code %d is invalid, got %zu moves", MOVE_CODES_COUNT, applied_count);
+	cr_assert(rba_is_bitboard_cube_solved(& cube), "the cube should be left untouched");
+}
@@ -0,0 +1,172 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Long enough for the coordinates to go through many values
+ */
+#define SCRAMBLE_SIZE 100
+
+
+/**
+ * The number of scrambles followed move by move
+ */
+#define SCRAMBLES_COUNT 20
+
+
+/**
+ * The number of random coordinates turned into cubes
+ */
+#define SAMPLES_COUNT 1000
+
+
+/**
+ * The code of [M], a slice move
+ */
+#define MIDDLE_MOVE_CODE 3
+
+
+
+
+/**
+ * Asserts that 2 sets of coordinates are equal
+ *
+ * @param coordinates - the actual coordinates
+ *
+ * @param expected_coordinates - the expected coordinates
+ *
+ * @param message - what the coordinates are
+ */
+static void assert_coordinates_eq(
+	struct rba_coordinates const * coordinates,
+	struct rba_coordinates const * expected_coordinates,
+	char const * message)
+{
+	cr_assert_eq(coordinates->twist, expected_coordinates->twist, "%s: wrong twist", message);
+	cr_assert_eq(coordinates->flip, expected_coordinates->flip, "%s: wrong flip", message);
+	cr_assert_eq(coordinates->slice, expected_coordinates->slice, "%s: wrong slice", message);
+	cr_assert_eq(
+		coordinates->corner_permutation,
+		expected_coordinates->corner_permutation,
+		"%s: wrong corner permutation",
+		message);
+}
+
+
+
+
+Test(coordinates, solved_cube_has_null_coordinates)
+{
+	// given
+	struct rba_coordinates expected_coordinates = { 0, 0, 0, 0 };
+	struct rba_coordinates coordinates;
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	// when
+	int read = rba_get_coordinates(& cube, & coordinates);
+
+	// then
+	cr_assert(read, "a solved cube should be read");
+	assert_coordinates_eq(& coordinates, & expected_coordinates, "solved cube");
+}
+
+
+Test(coordinates, moves_follow_the_coordinates_of_the_cube)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SCRAMBLES_COUNT; index++)
+	{
+		// given
+		rba_move_code scramble[SCRAMBLE_SIZE];
+		size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, NO_OPTIONS);
+		struct rba_coordinates coordinates = { 0, 0, 0, 0 };
+		struct rba_cube cube;
+		rba_init_cube(& cube);
+
+		for (size_t move = 0; move < length; move++)
+		{
+			struct rba_coordinates expected_coordinates;
+
+			if (! is_face_move(scramble[move]))
+				continue;
+
+			// when
+			size_t moved_count = rba_move_coordinates(& coordinates, scramble + move, 1);
+			rba_apply_moves(& cube, scramble + move, 1);
+
+			// then
+			cr_assert_eq(moved_count, 1, "move %d should be applied", scramble[move]);
+			cr_assert(rba_get_coordinates(& cube, & expected_coordinates), "the scrambled cube should be read");
+			assert_coordinates_eq(& coordinates, & expected_coordinates, "moved coordinates");
+		}
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(coordinates, builds_cubes_having_the_coordinates)
+{
+	srand(42);
+
+	for (size_t index = 0; index < SAMPLES_COUNT; index++)
+	{
+		// given
+		struct rba_coordinates expected_coordinates =
+		{
+			rand() % TWIST_COUNT,
+			rand() % FLIP_COUNT,
+			rand() % SLICE_COUNT,
+			rand() % CORNER_PERMUTATION_COUNT
+		};
+		struct rba_coordinates coordinates;
+		struct rba_cube cube;
+
+		// when
+		int built = rba_set_coordinates(& expected_coordinates, & cube);
+		int read = rba_get_coordinates(& cube, & coordinates);
+
+		// then
+		cr_assert(built, "sample %zu should be built", index);
+		cr_assert(read, "the cube of sample %zu should be reachable", index);
+		assert_coordinates_eq(& coordinates, & expected_coordinates, "built cube");
+	}
+}
+
+
+Test(coordinates, doesnt_move_with_other_moves)
+{
+	// given
+	rba_move_code moves[] = { 0, MIDDLE_MOVE_CODE };
+	struct rba_coordinates expected_coordinates = { 0, 0, 0, 0 };
+	struct rba_coordinates coordinates = { 0, 0, 0, 0 };
+
+	// when
+	size_t moved_count = rba_move_coordinates(& coordinates, moves, 2);
+
+	// then
+	cr_assert_eq(moved_count, 0, "[M] isn't a face move, got %zu moves", moved_count);
+	assert_coordinates_eq(& coordinates, & expected_coordinates, "untouched coordinates");
+}
+
+
+Test(coordinates, doesnt_build_out_of_range_coordinates)
+{
+	// given
+	struct rba_coordinates coordinates = { 0, 0, SLICE_COUNT, 0 };
+	struct rba_cube cube;
+
+	// when
+	int built = rba_set_coordinates(& coordinates, & cube);
+
+	// then
+	cr_assert_not(built, "slice %d is out of range", SLICE_COUNT);
+}
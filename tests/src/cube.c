@@ -0,0 +1,253 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/parameterized.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Long enough to mix every sticker many times
+ */
+#define SCRAMBLE_SIZE 1024
+
+
+
+
+/**
+ * Parameterized tests arguments for the stickers a move brings on a face
+ */
+typedef struct turned_stickers_params
+{
+	/**
+	 * The code of the move to apply on a solved cube
+	 */
+	rba_move_code move;
+
+	/**
+	 * The positions of 3 stickers brought by the move
+	 */
+	size_t facelets[3];
+
+	/**
+	 * The color the 3 stickers are expected to have
+	 */
+	int color;
+} turned_stickers_params;
+
+
+/**
+ * Parameterized tests arguments for wide moves
+ */
+typedef struct wide_move_params
+{
+	/**
+	 * The code of the wide move
+	 */
+	rba_move_code wide_move;
+
+	/**
+	 * The codes of the 2 moves doing the same
+	 */
+	rba_move_code moves[2];
+} wide_move_params;
+
+
+
+
+Test(cube, is_solved_once_initialized)
+{
+	// given
+	struct rba_cube cube;
+
+	// when
+	rba_init_cube(& cube);
+
+	// then
+	cr_assert(rba_is_cube_solved(& cube), "the initial cube should be solved");
+	for (size_t facelet = 0; facelet < FACELETS_COUNT; facelet++)
+	{
+		cr_assert_eq(
+			cube.facelets[facelet],
+			facelet / 9,
+			"sticker %zu should have color %zu",
+			facelet,
+			facelet / 9);
+	}
+}
+
+
+ParameterizedTestParameters(cube, moves_bring_the_expected_stickers)
+{
+	static turned_stickers_params params[] =
+	{
+		/* U: R goes to F */ { 9, { 18, 19, 20 }, RIGHT_FACE },
+		/* R: F goes to U */ { 6, { 2, 5, 8 }, FRONT_FACE },
+		/* F: U goes to R */ { 18, { 9, 12, 15 }, UP_FACE },
+		/* D: L goes to F */ { 15, { 24, 25, 26 }, LEFT_FACE },
+		/* L: U goes to F */ { 0, { 18, 21, 24 }, UP_FACE },
+		/* B: U goes to L */ { 24, { 36, 39, 42 }, UP_FACE },
+		/* M: U goes to F */ { 3, { 19, 22, 25 }, UP_FACE },
+		/* E: L goes to F */ { 12, { 21, 22, 23 }, LEFT_FACE },
+		/* S: U goes to R */ { 21, { 10, 13, 16 }, UP_FACE }
+	};
+
+	return cr_make_param_array(
+		turned_stickers_params,
+		params,
+		sizeof(params) / sizeof(* params));
+}
+
+
+ParameterizedTest(turned_stickers_params * params, cube, moves_bring_the_expected_stickers)
+{
+	// given
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	// when
+	size_t count = rba_apply_moves(& cube, & params->move, 1);
+
+	// then
+	cr_assert_eq(count, 1, "move %d should be applied", params->move);
+	for (size_t index = 0; index < 3; index++)
+	{
+		cr_assert_eq(
+			cube.facelets[params->facelets[index]],
+			params->color,
+			"after move %d, sticker %zu should have color %d, not %d",
+			params->move,
+			params->facelets[index],
+			params->color,
+			cube.facelets[params->facelets[index]]);
+	}
+}
+
+
+Test(cube, every_move_has_the_order_of_its_modifier)
+{
+	for (rba_move_code move = 0; move < MOVE_CODES_COUNT; move++)
+	{
+		// given: a quarter turn is repeated 4 times, a half turn twice
+		rba_move_code moves[] = { move, move, move, move };
+		size_t order = (move % 3 == 2) ? 2 : 4;
+		struct rba_cube cube;
+		rba_init_cube(& cube);
+
+		// when: the move alone, then repeated
+		rba_apply_moves(& cube, moves, 1);
+		int solved_once = rba_is_cube_solved(& cube);
+		rba_apply_moves(& cube, moves, order - 1);
+
+		// then
+		cr_assert_not(solved_once, "move %d should change the cube", move);
+		cr_assert(rba_is_cube_solved(& cube), "move %d repeated %zu times should solve", move, order);
+	}
+}
+
+
+Test(cube, sexy_move_has_order_6)
+{
+	// given: R U R' U'
+	rba_move_code moves[] = { 6, 9, 7, 10 };
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	for (size_t repetition = 1; repetition <= 6; repetition++)
+	{
+		// when
+		rba_apply_moves(& cube, moves, 4);
+
+		// then: solved on the 6th repetition only
+		cr_assert_eq(
+			rba_is_cube_solved(& cube),
+			repetition == 6,
+			"unexpected state after %zu repetitions",
+			repetition);
+	}
+}
+
+
+ParameterizedTestParameters(cube, wide_moves_turn_2_layers)
+{
+	static wide_move_params params[] =
+	{
+		/* l = L M */ { 27, { 0, 3 } },
+		/* r = R M' */ { 30, { 6, 4 } },
+		/* u = U E' */ { 33, { 9, 13 } },
+		/* d = D E */ { 36, { 15, 12 } },
+		/* f = F S */ { 39, { 18, 21 } },
+		/* b = B S' */ { 42, { 24, 22 } }
+	};
+
+	return cr_make_param_array(wide_move_params, params, sizeof(params) / sizeof(* params));
+}
+
+
+ParameterizedTest(wide_move_params * params, cube, wide_moves_turn_2_layers)
+{
+	// given: a mixed cube
+	rba_move_code mix[] = { 6, 9, 20, 34, 3, 13 };
+	struct rba_cube wide_cube;
+	struct rba_cube cube;
+	rba_init_cube(& wide_cube);
+	rba_apply_moves(& wide_cube, mix, 6);
+	cube = wide_cube;
+
+	// when
+	rba_apply_moves(& wide_cube, & params->wide_move, 1);
+	rba_apply_moves(& cube, params->moves, 2);
+
+	// then
+	cr_assert_arr_eq(
+		wide_cube.facelets,
+		cube.facelets,
+		FACELETS_COUNT,
+		"move %d should turn the same stickers as moves %d and %d",
+		params->wide_move,
+		params->moves[0],
+		params->moves[1]);
+}
+
+
+Test(cube, reversed_scramble_solves_the_cube)
+{
+	// given: a scramble and its reversed sequence
+	rba_move_code scramble[SCRAMBLE_SIZE];
+	rba_move_code reversed_scramble[SCRAMBLE_SIZE];
+	struct rba_cube cube;
+	size_t length = rba_generate_scramble_moves(scramble, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	for (size_t index = 0; index < length; index++)
+		reversed_scramble[length - 1 - index] = reverse_move(scramble[index]);
+	rba_init_cube(& cube);
+
+	// when
+	size_t scramble_count = rba_apply_moves(& cube, scramble, length);
+	int solved_by_scramble = rba_is_cube_solved(& cube);
+	size_t reversed_count = rba_apply_moves(& cube, reversed_scramble, length);
+
+	// then
+	cr_assert_eq(scramble_count, SCRAMBLE_SIZE, "expected %d moves, applied %zu", SCRAMBLE_SIZE, scramble_count);
+	cr_assert_eq(reversed_count, SCRAMBLE_SIZE, "expected %d moves, applied %zu", SCRAMBLE_SIZE, reversed_count);
+	cr_assert_not(solved_by_scramble, "the scramble should mix the cube");
+	cr_assert(rba_is_cube_solved(& cube), "the reversed scramble should solve the cube");
+}
+
+
+Test(cube, doesnt_apply_invalid_move_codes)
+{
+	// given: a code past the wide moves
+	rba_move_code moves[] = { 6, MOVE_CODES_COUNT };
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	// when
+	size_t count = rba_apply_moves(& cube, moves, 2);
+
+	// then
+	cr_assert_eq(count, 0, "code %d is not a move", MOVE_CODES_COUNT);
+	cr_assert(rba_is_cube_solved(& cube), "the cube should be left untouched");
+}
@@ -0,0 +1,42 @@
+#include <stdlib.h>
+
+#include "moves.h"
+
+
+
+
+rba_move_code reverse_move(rba_move_code move)
+{
+	switch (move % 3)
+	{
+		case 0:
+			return move + 1;
+
+		case 1:
+			return move - 1;
+
+		default:
+			return move;
+	}
+}
+
+
+int is_face_move(rba_move_code move)
+{
+	size_t layer_index = move / 3;
+
+	return (layer_index < 9) && (layer_index % 3 != 1);
+}
+
+
+void scramble_cube(struct rba_context * context, struct rba_cube * cube, size_t length, enum rba_option flags)
+{
+	rba_move_code * scramble = malloc(length + 1);
+
+	length = rba_generate_scramble_moves_r(context, scramble, length, flags);
+
+	rba_init_cube(cube);
+	rba_apply_moves(cube, scramble, length);
+
+	free(scramble);
+}
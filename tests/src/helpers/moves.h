@@ -0,0 +1,46 @@
+#ifndef RUBIKS_MOVES_HELPERS_HEADER
+#define RUBIKS_MOVES_HELPERS_HEADER
+
+#include "../../../include/rubiks_algos.h"
+
+
+
+
+/**
+ * Computes the code of the move reverting the given one
+ *
+ * @param move - the code of the move to revert
+ *
+ * @return rba_move_code - the code of the reverting move
+ */
+rba_move_code reverse_move(rba_move_code move);
+
+
+/**
+ * Tells whether a move code is a face move: a quarter, half or reverse turn
+ * of one of the 6 outer layers
+ *
+ * @param move - the code of the move
+ *
+ * @return int - 1 if the move is a face move, 0 otherwise
+ */
+int is_face_move(rba_move_code move);
+
+
+/**
+ * Scrambles a solved cube with a random walk
+ *
+ * @param context - the random generator to draw from
+ *
+ * @param cube - the cube to scramble, output
+ *
+ * @param length - the number of moves of the walk
+ *
+ * @param flags - the options to generate the walk with
+ */
+void scramble_cube(struct rba_context * context, struct rba_cube * cube, size_t length, enum rba_option flags);
+
+
+
+
+#endif /* RUBIKS_MOVES_HELPERS_HEADER */
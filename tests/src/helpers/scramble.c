@@ -1,4 +1,5 @@
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -82,7 +83,7 @@ char const * find_repeated_layers(char const * scramble)
 
 
 /**
- * Returns the axis of the given [move]
+ * Returns the axis of the given [move], wide moves included
  *
  * @param move - the move to get the axis from
  *
@@ -90,6 +91,9 @@ char const * find_repeated_layers(char const * scramble)
  */
 static rba_axis get_move_axis(char move)
 {
+	/* wide moves rotate around the same axis as their base layer */
+	move = (char) toupper((unsigned char) move);
+
 	if ((move == 'L') || (move == 'M') || (move == 'R'))
 		return AXIS_1;
 	if ((move == 'U') || (move == 'E') || (move == 'D'))
@@ -145,6 +149,39 @@ static int string_in_array(char const * const * haystack, char * needle)
 }
 
 
+int find_move_index(char const * const * moves, char const * move)
+{
+	for (int index = 0; moves[index] != NULL; index++)
+	{
+		if (strcmp(moves[index], move) == 0)
+			return index;
+	}
+
+	return -1;
+}
+
+
+double uniform_chi_square(size_t const observed[], size_t outcomes_count)
+{
+	size_t total = 0;
+	double expected;
+	double chi_square = 0;
+
+	for (size_t index = 0; index < outcomes_count; index++)
+		total += observed[index];
+
+	expected = (double) total / outcomes_count;
+
+	for (size_t index = 0; index < outcomes_count; index++)
+	{
+		double deviation = observed[index] - expected;
+		chi_square += deviation * deviation / expected;
+	}
+
+	return chi_square;
+}
+
+
 char * find_invalid_move(char * scramble, char const * const * valid_moves)
 {
 	char * token = strtok(scramble, " ");
@@ -61,6 +61,32 @@ char const * find_repeated_axis(char const * scramble);
 char * find_invalid_move(char * scramble, char const * const * valid_moves);
 
 
+/**
+ * Returns the index of a move in an array of moves
+ *
+ * @param moves - the array of moves, this array must be NULL-terminated
+ *
+ * @param move - the move to find
+ *
+ * @return int - the index of the move in the array, -1 if not found
+ */
+int find_move_index(char const * const * moves, char const * move);
+
+
+/**
+ * Computes the chi-square statistic of the given counts, against a uniform
+ * 	distribution
+ *
+ * @param observed - how many times each outcome was observed
+ *
+ * @param outcomes_count - the number of possible outcomes
+ *
+ * @return double - the chi-square statistic, to compare with the critical
+ * 	value for [outcomes_count - 1] degrees of freedom
+ */
+double uniform_chi_square(size_t const observed[], size_t outcomes_count);
+
+
 /**
  * Duplicates a string to be used in a parameterized test
  * Memory from libc malloc() is unavailable in sub-processes because of ASLR
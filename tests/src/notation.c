@@ -0,0 +1,336 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+#include <criterion/parameterized.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/scramble.h"
+
+
+/**
+ * Long enough to contain every move
+ */
+#define SCRAMBLE_SIZE 1024
+
+
+
+
+/**
+ * Parameterized tests arguments for invalid sequences
+ */
+typedef struct invalid_sequence_params
+{
+	/**
+	 * The sequence to read
+	 */
+	char * scramble;
+} invalid_sequence_params;
+
+
+/**
+ * Parameterized tests arguments for the position of parsing errors
+ */
+typedef struct parsing_error_params
+{
+	/**
+	 * The sequence to parse
+	 */
+	char * scramble;
+
+	/**
+	 * The expected position of the error
+	 */
+	size_t offset;
+} parsing_error_params;
+
+
+
+
+/**
+ * Called by Criterion, if specified in cr_make_param_array()
+ * Deallocates strings which were allocated for a parameterized test
+ *
+ * @param crp - provided by Criterion
+ */
+static void free_invalid_sequence_params(struct criterion_test_params * crp)
+{
+	invalid_sequence_params * params = crp->params;
+
+	for (size_t index = 0; index < crp->length; index++)
+		cr_free(params[index].scramble);
+}
+
+
+/**
+ * Called by Criterion, if specified in cr_make_param_array()
+ * Deallocates strings which were allocated for a parameterized test
+ *
+ * @param crp - provided by Criterion
+ */
+static void free_parsing_error_params(struct criterion_test_params * crp)
+{
+	parsing_error_params * params = crp->params;
+
+	for (size_t index = 0; index < crp->length; index++)
+		cr_free(params[index].scramble);
+}
+
+
+
+
+Test(notation, writes_move_codes_in_singmaster_notation)
+{
+	// given: [L], [M'], [b2] and [U2]
+	rba_move_code moves[] = { 0, 4, 44, 11 };
+	char buffer[16];
+
+	// when
+	size_t length = rba_write_move_codes(moves, 4, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_str_eq(buffer, "L M' b2 U2", "unexpected sequence [%s]", buffer);
+	cr_assert_eq(length, strlen(buffer), "expected length %zu, got %zu", strlen(buffer), length);
+}
+
+
+Test(notation, doesnt_write_invalid_move_codes)
+{
+	// given: a code past the wide moves
+	rba_move_code moves[] = { 0, MOVE_CODES_COUNT };
+	char buffer[16];
+
+	// when
+	size_t length = rba_write_move_codes(moves, 2, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_eq(length, 0, "code %d is not a move", MOVE_CODES_COUNT);
+}
+
+
+Test(notation, doesnt_write_past_the_buffer)
+{
+	// given: 2 moves needing 6 bytes
+	rba_move_code moves[] = { 2, 5 };
+	char buffer[5];
+
+	// when
+	size_t length = rba_write_move_codes(moves, 2, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_eq(length, 0, "[L2 M2] doesn't fit in %zu bytes", sizeof(buffer));
+}
+
+
+Test(notation, writes_in_a_buffer_of_exact_size)
+{
+	// given: moves of different lengths, and a buffer with no room left
+	rba_move_code moves[] = { 3, 5, 7, 27 };
+	char buffer[10];
+
+	// when
+	size_t length = rba_write_move_codes(moves, 4, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_str_eq(buffer, "M M2 R' l", "unexpected sequence [%s]", buffer);
+	cr_assert_eq(length, 9, "expected length 9, got %zu", length);
+}
+
+
+Test(notation, reads_singmaster_notation_as_move_codes)
+{
+	// given
+	char const * scramble = "L M' b2  U2";
+	rba_move_code expected_moves[] = { 0, 4, 44, 11 };
+	rba_move_code moves[8];
+
+	// when
+	size_t count = rba_read_move_codes(scramble, moves, 8);
+
+	// then
+	cr_assert_eq(count, 4, "expected 4 moves, got %zu", count);
+	cr_assert_arr_eq(moves, expected_moves, sizeof(expected_moves), "unexpected codes");
+}
+
+
+ParameterizedTestParameters(notation, doesnt_read_invalid_sequences)
+{
+	static invalid_sequence_params params[8];
+
+	params[0] = (invalid_sequence_params) { cr_strdup("") };
+	params[1] = (invalid_sequence_params) { cr_strdup("a B L") };
+	params[2] = (invalid_sequence_params) { cr_strdup("LL R U2") };
+	params[3] = (invalid_sequence_params) { cr_strdup("' L F2") };
+	params[4] = (invalid_sequence_params) { cr_strdup("R' D R22") };
+	params[5] = (invalid_sequence_params) { cr_strdup("F2 D2' U") };
+	params[6] = (invalid_sequence_params) { cr_strdup("R m") };
+	params[7] = (invalid_sequence_params) { cr_strdup("R U F D L B") };
+
+	return cr_make_param_array(
+		invalid_sequence_params,
+		params,
+		8,
+		free_invalid_sequence_params);
+}
+
+
+ParameterizedTest(invalid_sequence_params * params, notation, doesnt_read_invalid_sequences)
+{
+	// given: room for 5 moves only
+	rba_move_code moves[5];
+
+	// when
+	size_t count = rba_read_move_codes(params->scramble, moves, 5);
+
+	// then
+	cr_assert_eq(count, 0, "[%s] should be rejected, read %zu moves", params->scramble, count);
+}
+
+
+Test(notation, reading_reverts_writing)
+{
+	// given: a generated scramble, writen in singmaster notation
+	char * scramble = rba_generate_scramble(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	rba_move_code moves[SCRAMBLE_SIZE];
+	size_t capacity = rba_compute_scramble_buffer_size(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * rewriten_scramble = malloc(capacity);
+
+	// when: reading it and writing it again
+	size_t count = rba_read_move_codes(scramble, moves, SCRAMBLE_SIZE);
+	size_t length = rba_write_move_codes(moves, count, rewriten_scramble, capacity);
+
+	// then: the scramble is unchanged
+	cr_assert_eq(count, SCRAMBLE_SIZE, "expected %d moves, read %zu", SCRAMBLE_SIZE, count);
+	cr_assert_eq(length, strlen(scramble), "expected length %zu, got %zu", strlen(scramble), length);
+	cr_assert_str_eq(rewriten_scramble, scramble, "the scramble changed");
+
+	free(scramble);
+	free(rewriten_scramble);
+}
+
+
+Test(notation, parses_moves_separated_by_whitespaces)
+{
+	// given: [R], [U'], [f2] and [M] among spaces, tabs and line breaks
+	char const * scramble = "  R\tU'\n\nf2 \r M  ";
+	rba_move_code expected_moves[] = { 6, 10, 41, 3 };
+	rba_move_code moves[8];
+	size_t error_offset;
+
+	// when
+	size_t count = rba_parse_scramble(scramble, strlen(scramble), moves, 8, & error_offset);
+
+	// then
+	cr_assert_eq(count, 4, "expected 4 moves, parsed %zu", count);
+	cr_assert_arr_eq(moves, expected_moves, sizeof(expected_moves), "unexpected codes");
+	cr_assert_eq(error_offset, strlen(scramble), "no error expected, got one at %zu", error_offset);
+}
+
+
+Test(notation, parses_only_the_given_length)
+{
+	// given: the sequence is cut after [U2]
+	char const * scramble = "R U2 F";
+	rba_move_code moves[8];
+
+	// when
+	size_t count = rba_parse_scramble(scramble, 4, moves, 8, NULL);
+
+	// then
+	cr_assert_eq(count, 2, "expected 2 moves, parsed %zu", count);
+	cr_assert_eq(moves[1], 11, "expected [U2], got code %d", moves[1]);
+}
+
+
+Test(notation, parsing_reverts_writing)
+{
+	// given: generated moves, writen in singmaster notation
+	rba_move_code moves[SCRAMBLE_SIZE];
+	rba_move_code parsed_moves[SCRAMBLE_SIZE];
+	size_t capacity = rba_compute_scramble_buffer_size(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * scramble = malloc(capacity);
+	size_t length = rba_write_move_codes(
+		moves,
+		rba_generate_scramble_moves(moves, SCRAMBLE_SIZE, USE_WIDE_MOVES),
+		scramble,
+		capacity);
+
+	// when
+	size_t count = rba_parse_scramble(scramble, length, parsed_moves, SCRAMBLE_SIZE, NULL);
+
+	// then
+	cr_assert_eq(count, SCRAMBLE_SIZE, "expected %d moves, parsed %zu", SCRAMBLE_SIZE, count);
+	cr_assert_arr_eq(parsed_moves, moves, sizeof(moves), "the moves changed");
+
+	free(scramble);
+}
+
+
+ParameterizedTestParameters(notation, reports_the_position_of_parsing_errors)
+{
+	static parsing_error_params params[8];
+
+	params[0] = (parsing_error_params) { cr_strdup("a B L"), 0 };
+	params[1] = (parsing_error_params) { cr_strdup("LL R U2"), 1 };
+	params[2] = (parsing_error_params) { cr_strdup("' L F2"), 0 };
+	params[3] = (parsing_error_params) { cr_strdup("R' D R22"), 7 };
+	params[4] = (parsing_error_params) { cr_strdup("F2 D2' U"), 5 };
+	params[5] = (parsing_error_params) { cr_strdup("R  m"), 3 };
+	params[6] = (parsing_error_params) { cr_strdup("R'2 U"), 2 };
+	params[7] = (parsing_error_params) { cr_strdup("R U F D L B"), 10 };
+
+	return cr_make_param_array(
+		parsing_error_params,
+		params,
+		8,
+		free_parsing_error_params);
+}
+
+
+ParameterizedTest(parsing_error_params * params, notation, reports_the_position_of_parsing_errors)
+{
+	// given: room for 5 moves only
+	rba_move_code moves[5];
+	size_t error_offset;
+
+	// when
+	size_t count = rba_parse_scramble(params->scramble, strlen(params->scramble), moves, 5, & error_offset);
+
+	// then
+	cr_assert_eq(count, 0, "[%s] should be rejected, parsed %zu moves", params->scramble, count);
+	cr_assert_eq(
+		error_offset,
+		params->offset,
+		"[%s] error expected at %zu, got %zu",
+		params->scramble,
+		params->offset,
+		error_offset);
+}
+
+
+Test(notation, reports_parsing_errors_anywhere_in_long_sequences)
+{
+	// given: a long scramble
+	char * scramble = rba_generate_scramble(SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	size_t length = strlen(scramble);
+	rba_move_code moves[SCRAMBLE_SIZE];
+
+	for (size_t position = 0; position < length; position++)
+	{
+		// when: a single byte is replaced by an invalid symbol
+		char symbol = scramble[position];
+		size_t error_offset;
+		size_t count;
+
+		scramble[position] = 'x';
+		count = rba_parse_scramble(scramble, length, moves, SCRAMBLE_SIZE, & error_offset);
+		scramble[position] = symbol;
+
+		// then
+		cr_assert_eq(count, 0, "invalid symbol at %zu, parsed %zu moves", position, count);
+		cr_assert_eq(error_offset, position, "error expected at %zu, got %zu", position, error_offset);
+	}
+
+	free(scramble);
+}
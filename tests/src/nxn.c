@@ -0,0 +1,218 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * Long enough to span several chunks of generated moves
+ */
+#define SCRAMBLE_SIZE 200
+
+
+/**
+ * Long enough for every legal move to come out
+ */
+#define LONG_SCRAMBLE_SIZE 10000
+
+
+/**
+ * The number of codes of the moves of a face
+ */
+#define FACE_CODES_COUNT (3 * MAX_NXN_DEPTH)
+
+
+
+
+/**
+ * Gives the axis of a move: 0 for U and D, 1 for R and L, 2 for F and B
+ *
+ * @param move - the code of the move
+ *
+ * @return size_t - the axis of the move
+ */
+static size_t get_axis(rba_nxn_move_code move)
+{
+	return move / FACE_CODES_COUNT % 3;
+}
+
+
+/**
+ * Tells whether a move turns a cube of the given size
+ *
+ * @param move - the code of the move
+ *
+ * @param size - the number of layers of the cube
+ *
+ * @return int - 1 if the move turns 1 to size / 2 outer layers, and half an
+ * 	even cube only from U, R or F, 0 otherwise
+ */
+static int is_legal_move(rba_nxn_move_code move, size_t size)
+{
+	size_t face = move / FACE_CODES_COUNT;
+	size_t depth = move % FACE_CODES_COUNT / 3 + 1;
+
+	if ((move >= NXN_MOVE_CODES_COUNT) || (depth > size / 2))
+		return 0;
+
+	return (size % 2 == 1) || (depth < size / 2) || (face < 3);
+}
+
+
+
+
+Test(nxn, scrambles_turn_a_new_axis_each_move)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t size = MIN_NXN_SIZE; size <= MAX_NXN_SIZE; size++)
+	{
+		// given
+		rba_nxn_move_code moves[SCRAMBLE_SIZE];
+
+		// when
+		size_t length = rba_generate_nxn_scramble_moves_r(context, size, moves, SCRAMBLE_SIZE);
+
+		// then
+		cr_assert_eq(length, SCRAMBLE_SIZE, "%zux%zu: expected %d moves, got %zu", size, size, SCRAMBLE_SIZE, length);
+		for (size_t move = 0; move < length; move++)
+		{
+			cr_assert(is_legal_move(moves[move], size), "%zux%zu: move %d can't be made", size, size, moves[move]);
+			if (move > 0)
+				cr_assert_neq(get_axis(moves[move]), get_axis(moves[move - 1]), "%zux%zu: move %zu turns the same axis", size, size, move);
+		}
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(nxn, scrambles_use_every_move_of_the_size)
+{
+	struct rba_context * context = rba_create_context(42);
+	size_t const expected_counts[] = { 9, 18, 27, 36, 45, 54 };
+
+	for (size_t size = MIN_NXN_SIZE; size <= MAX_NXN_SIZE; size++)
+	{
+		// given
+		static rba_nxn_move_code moves[LONG_SCRAMBLE_SIZE];
+		int seen[NXN_MOVE_CODES_COUNT] = { 0 };
+		size_t seen_count = 0;
+
+		// when
+		size_t length = rba_generate_nxn_scramble_moves_r(context, size, moves, LONG_SCRAMBLE_SIZE);
+		for (size_t move = 0; move < length; move++)
+		{
+			seen_count += ! seen[moves[move]];
+			seen[moves[move]] = 1;
+		}
+
+		// then
+		cr_assert_eq(
+			seen_count,
+			expected_counts[size - MIN_NXN_SIZE],
+			"%zux%zu: expected %zu different moves, got %zu",
+			size, size, expected_counts[size - MIN_NXN_SIZE], seen_count);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(nxn, writes_wca_notation)
+{
+	// given: [U], [Rw'], [3Rw2], [Fw], [L2], [3Bw']
+	rba_nxn_move_code const moves[] = { 0, 13, 17, 21, 38, 52 };
+	char buffer[64];
+
+	// when
+	size_t length = rba_write_nxn_move_codes(moves, 6, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_str_eq(buffer, "U Rw' 3Rw2 Fw L2 3Bw'", "the moves should be written in WCA notation");
+	cr_assert_eq(length, strlen(buffer), "expected %zu bytes, got %zu", strlen(buffer), length);
+}
+
+
+Test(nxn, doesnt_write_invalid_codes)
+{
+	// given
+	rba_nxn_move_code const moves[] = { 0, NXN_MOVE_CODES_COUNT };
+	char buffer[64];
+
+	// when
+	size_t length = rba_write_nxn_move_codes(moves, 2, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_eq(length, 0, "code %d is invalid, got %zu bytes", NXN_MOVE_CODES_COUNT, length);
+}
+
+
+Test(nxn, scramble_strings_match_move_codes)
+{
+	for (size_t size = MIN_NXN_SIZE; size <= MAX_NXN_SIZE; size++)
+	{
+		// given: 2 generators with the same seed
+		struct rba_context * string_context = rba_create_context(42);
+		struct rba_context * moves_context = rba_create_context(42);
+		size_t capacity = rba_compute_nxn_scramble_buffer_size(SCRAMBLE_SIZE);
+		char * expected_scramble = malloc(capacity);
+		rba_nxn_move_code moves[SCRAMBLE_SIZE];
+
+		// when
+		char * scramble = rba_generate_nxn_scramble_r(string_context, size, SCRAMBLE_SIZE);
+		size_t length = rba_generate_nxn_scramble_moves_r(moves_context, size, moves, SCRAMBLE_SIZE);
+		size_t expected_length = rba_write_nxn_move_codes(moves, length, expected_scramble, capacity);
+
+		// then
+		cr_assert_not_null(scramble, "%zux%zu: the scramble should be generated", size, size);
+		cr_assert_gt(expected_length, 0, "%zux%zu: the moves should fit in the buffer", size, size);
+		cr_assert_str_eq(scramble, expected_scramble, "%zux%zu: the string should match the codes", size, size);
+
+		free(scramble);
+		free(expected_scramble);
+		rba_destroy_context(string_context);
+		rba_destroy_context(moves_context);
+	}
+}
+
+
+Test(nxn, fits_the_longest_moves_in_the_computed_size)
+{
+	// given: only [3Rw'] and [3Fw'], the longest moves
+	rba_nxn_move_code moves[SCRAMBLE_SIZE];
+	size_t capacity = rba_compute_nxn_scramble_buffer_size(SCRAMBLE_SIZE);
+	char * buffer = malloc(capacity);
+	for (size_t move = 0; move < SCRAMBLE_SIZE; move++)
+		moves[move] = (move % 2 == 0) ? 16 : 25;
+
+	// when
+	size_t length = rba_write_nxn_move_codes(moves, SCRAMBLE_SIZE, buffer, capacity);
+
+	// then
+	cr_assert_eq(length, capacity - 1, "expected %zu bytes, got %zu", capacity - 1, length);
+
+	free(buffer);
+}
+
+
+Test(nxn, doesnt_generate_unsupported_sizes)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	rba_nxn_move_code moves[SCRAMBLE_SIZE];
+
+	// when
+	size_t small_length = rba_generate_nxn_scramble_moves_r(context, MIN_NXN_SIZE - 1, moves, SCRAMBLE_SIZE);
+	size_t large_length = rba_generate_nxn_scramble_moves_r(context, MAX_NXN_SIZE + 1, moves, SCRAMBLE_SIZE);
+	char * scramble = rba_generate_nxn_scramble_r(context, MAX_NXN_SIZE + 1, SCRAMBLE_SIZE);
+
+	// then
+	cr_assert_eq(small_length, 0, "a %dx%d cube isn't supported", MIN_NXN_SIZE - 1, MIN_NXN_SIZE - 1);
+	cr_assert_eq(large_length, 0, "a %dx%d cube isn't supported", MAX_NXN_SIZE + 1, MAX_NXN_SIZE + 1);
+	cr_assert_null(scramble, "a %dx%d cube isn't supported", MAX_NXN_SIZE + 1, MAX_NXN_SIZE + 1);
+
+	rba_destroy_context(context);
+}
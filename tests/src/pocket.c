@@ -0,0 +1,354 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Long enough for a random walk to reach any state of a 2x2x2 cube
+ */
+#define SCRAMBLE_SIZE 100
+
+
+/**
+ * The number of cubes solved by each test
+ */
+#define SOLVES_COUNT 200
+
+
+/**
+ * The number of random state scrambles to compute statistics on
+ */
+#define STATISTICS_SIZE 2000
+
+
+/**
+ * The chi-square value with 3 degrees of freedom exceeded with a 0.1%
+ * probability
+ */
+#define CHI_SQUARE_CRITICAL_VALUE 16.27
+
+
+/**
+ * The number of states of a 2x2x2 cube, and the number of them at each
+ * distance, up to 7 moves, 8, 9, and 10 or 11 moves
+ */
+#define POCKET_STATES_COUNT 3674160.0
+#define DISTANCE_BUCKETS_COUNT 4
+
+
+/**
+ * A seed whose generator first draws the coordinates of the solved state, 1
+ * draw in 3674160
+ */
+#define SOLVED_DRAW_SEED 2867497
+
+
+/**
+ * The layer index of R, U and F in move codes
+ */
+#define RIGHT_LAYER 2
+#define TOP_LAYER 3
+#define FRONT_LAYER 6
+
+
+/**
+ * The stickers of the up-right-front corner: U9, R1 and F3
+ */
+#define URF_FACELETS 8, 9, 20
+
+
+
+
+/**
+ * The number of states of a 2x2x2 cube in each bucket of distances
+ */
+static double const distance_counts[DISTANCE_BUCKETS_COUNT] = { 289896, 870072, 1887748, 626444 };
+
+
+
+
+/**
+ * Tells whether a move code turns the R, U or F face
+ *
+ * @param move - the code of the move
+ *
+ * @return int - 1 if the move is a move of a 2x2x2 cube, 0 otherwise
+ */
+static int is_pocket_move(rba_move_code move)
+{
+	size_t layer_index = move / 3;
+
+	return (layer_index == RIGHT_LAYER) || (layer_index == TOP_LAYER) || (layer_index == FRONT_LAYER);
+}
+
+
+/**
+ * Tells whether every corner sticker of a cube has the color of its face
+ *
+ * @param cube - the cube to check
+ *
+ * @return int - 1 if the corners are solved, 0 otherwise
+ */
+static int are_corners_solved(struct rba_cube const * cube)
+{
+	size_t const corner_stickers[] = { 0, 2, 6, 8 };
+
+	for (size_t face = 0; face < FACES_COUNT; face++)
+	{
+		for (size_t sticker = 0; sticker < 4; sticker++)
+		{
+			if (cube->facelets[9 * face + corner_stickers[sticker]] != face)
+				return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+
+
+Test(pocket, solves_scrambled_corners)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		rba_move_code solution[POCKET_MAX_LENGTH];
+		struct rba_cube cube;
+		scramble_cube(context, & cube, SCRAMBLE_SIZE, POCKET_CUBE);
+
+		// when
+		size_t length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+		size_t applied_count = rba_apply_moves(& cube, solution, length);
+
+		// then
+		cr_assert_gt(length, 0, "scrambled cube %zu should be solved", index);
+		cr_assert_eq(applied_count, length, "the solution should only contain valid moves");
+		cr_assert(are_corners_solved(& cube), "the solution of cube %zu should solve its corners", index);
+		for (size_t move = 0; move < length; move++)
+			cr_assert(is_pocket_move(solution[move]), "move %d should turn R, U or F", solution[move]);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(pocket, solutions_are_no_longer_than_short_scrambles)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		size_t scramble_length = 1 + index % 5;
+		rba_move_code solution[POCKET_MAX_LENGTH];
+		struct rba_cube cube;
+		scramble_cube(context, & cube, scramble_length, POCKET_CUBE);
+
+		// when
+		size_t length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+
+		// then
+		cr_assert_leq(length, scramble_length, "cube %zu was scrambled with %zu moves, got %zu", index, scramble_length, length);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(pocket, reads_corners_relative_to_the_fixed_corner)
+{
+	// given: [L] turns the D-B-L corner, [L R'] turns the whole cube
+	rba_move_code const left_move = 0;
+	rba_move_code solution[POCKET_MAX_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	rba_apply_moves(& cube, & left_move, 1);
+
+	// when
+	size_t length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+
+	// then
+	cr_assert_eq(length, 1, "[L] should be undone with a single move, got %zu", length);
+	cr_assert_eq(solution[0], 3 * RIGHT_LAYER + 1, "[L] should be undone with [R'], got %d", solution[0]);
+}
+
+
+Test(pocket, doesnt_solve_solved_corners)
+{
+	// given: only the corners are read
+	rba_move_code const middle_move = 3;
+	rba_move_code solution[POCKET_MAX_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	rba_apply_moves(& cube, & middle_move, 1);
+
+	// when
+	size_t length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+
+	// then
+	cr_assert_eq(length, 0, "solved corners need no move, got %zu", length);
+}
+
+
+Test(pocket, doesnt_solve_twisted_corner)
+{
+	// given: a single corner twisted in place, unreachable with moves
+	size_t const facelets[] = { URF_FACELETS };
+	rba_move_code solution[POCKET_MAX_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	uint8_t color = cube.facelets[facelets[0]];
+	cube.facelets[facelets[0]] = cube.facelets[facelets[1]];
+	cube.facelets[facelets[1]] = cube.facelets[facelets[2]];
+	cube.facelets[facelets[2]] = color;
+
+	// when
+	size_t length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+
+	// then
+	cr_assert_eq(length, 0, "a twisted corner can't be solved, got %zu moves", length);
+}
+
+
+Test(pocket, random_state_scrambles_are_solved_optimally)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		rba_move_code scramble[POCKET_MAX_LENGTH];
+		rba_move_code solution[POCKET_MAX_LENGTH];
+		struct rba_cube cube;
+		rba_init_cube(& cube);
+
+		// when
+		size_t length = rba_generate_scramble_moves_r(
+			context,
+			scramble,
+			POCKET_MAX_LENGTH,
+			POCKET_CUBE | RANDOM_STATE | USE_WIDE_MOVES);
+		rba_apply_moves(& cube, scramble, length);
+		size_t solution_length = rba_solve_pocket_cube(& cube, solution, POCKET_MAX_LENGTH);
+
+		// then
+		cr_assert_gt(length, 0, "scramble %zu should be found", index);
+		cr_assert_eq(solution_length, length, "scramble %zu should be as short as its solution", index);
+		for (size_t move = 0; move < length; move++)
+			cr_assert(is_pocket_move(scramble[move]), "move %d should turn R, U or F", scramble[move]);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(pocket, random_state_scrambles_follow_the_distances_of_the_states)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	double counts[DISTANCE_BUCKETS_COUNT] = { 0 };
+	double chi_square = 0;
+
+	// when
+	for (size_t index = 0; index < STATISTICS_SIZE; index++)
+	{
+		rba_move_code scramble[POCKET_MAX_LENGTH];
+		size_t length = rba_generate_scramble_moves_r(
+			context,
+			scramble,
+			POCKET_MAX_LENGTH,
+			POCKET_CUBE | RANDOM_STATE);
+
+		counts[(length <= 7) ? 0 : (length >= 10) ? 3 : length - 7]++;
+	}
+
+	// then
+	for (size_t bucket = 0; bucket < DISTANCE_BUCKETS_COUNT; bucket++)
+	{
+		double expected_count = STATISTICS_SIZE * distance_counts[bucket] / POCKET_STATES_COUNT;
+
+		chi_square += (counts[bucket] - expected_count) * (counts[bucket] - expected_count) / expected_count;
+	}
+	cr_assert_lt(chi_square, CHI_SQUARE_CRITICAL_VALUE, "the lengths aren't those of uniform states: %f", chi_square);
+
+	rba_destroy_context(context);
+}
+
+
+Test(pocket, random_state_scrambles_respect_the_maximum_length)
+{
+	// given: 1 state in 300 is 5 moves away or closer
+	struct rba_context * context = rba_create_context(42);
+	size_t found_count = 0;
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		rba_move_code scramble[POCKET_MAX_LENGTH];
+
+		// when
+		size_t length = rba_generate_scramble_moves_r(context, scramble, 5, POCKET_CUBE | RANDOM_STATE);
+
+		// then
+		cr_assert_leq(length, 5, "scramble %zu is too long: %zu moves", index, length);
+		found_count += (length > 0);
+	}
+	cr_assert_lt(found_count, SOLVES_COUNT / 10, "few states can be scrambled in 5 moves, got %zu", found_count);
+
+	rba_destroy_context(context);
+}
+
+
+Test(pocket, random_state_scrambles_draw_again_the_solved_state)
+{
+	// given: 2 generators drawing the solved state first
+	struct rba_context * moves_context = rba_create_context(SOLVED_DRAW_SEED);
+	struct rba_context * string_context = rba_create_context(SOLVED_DRAW_SEED);
+	rba_move_code scramble[POCKET_MAX_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	// when
+	size_t length = rba_generate_scramble_moves_r(moves_context, scramble, POCKET_MAX_LENGTH, POCKET_CUBE | RANDOM_STATE);
+	char * string = rba_generate_scramble_r(string_context, POCKET_MAX_LENGTH, POCKET_CUBE | RANDOM_STATE);
+	rba_apply_moves(& cube, scramble, length);
+
+	// then
+	cr_assert_gt(length, 0, "the scramble should have moves");
+	cr_assert_not(rba_is_cube_solved(& cube), "the scramble should lead to an unsolved state");
+	cr_assert_not_null(string, "the scramble should be written");
+	cr_assert_gt(strlen(string), 0, "the written scramble should have moves");
+
+	free(string);
+	rba_destroy_context(moves_context);
+	rba_destroy_context(string_context);
+}
+
+
+Test(pocket, random_walks_turn_a_new_face_each_move)
+{
+	// given
+	struct rba_context * context = rba_create_context(42);
+	rba_move_code scramble[SCRAMBLE_SIZE];
+
+	// when
+	size_t length = rba_generate_scramble_moves_r(context, scramble, SCRAMBLE_SIZE, POCKET_CUBE | USE_WIDE_MOVES);
+
+	// then
+	cr_assert_eq(length, SCRAMBLE_SIZE, "the walk should have %d moves, got %zu", SCRAMBLE_SIZE, length);
+	for (size_t move = 0; move < length; move++)
+	{
+		cr_assert(is_pocket_move(scramble[move]), "move %d should turn R, U or F", scramble[move]);
+		if (move > 0)
+			cr_assert_neq(scramble[move] / 3, scramble[move - 1] / 3, "move %zu turns the same face again", move);
+	}
+
+	rba_destroy_context(context);
+}
@@ -0,0 +1,198 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * Long enough for 2 different seeds to never generate the same scramble
+ */
+#define SCRAMBLE_SIZE 64
+
+
+
+
+Test(random, same_seed_generates_same_scramble)
+{
+	// given: 2 contexts with the same seed
+	struct rba_context * first_context = rba_create_context(42);
+	struct rba_context * second_context = rba_create_context(42);
+
+	// when: generating a scramble with each of them
+	char * first_scramble = rba_generate_scramble_r(first_context, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * second_scramble = rba_generate_scramble_r(second_context, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+	// then: they should be the same
+	cr_assert_str_eq(
+		first_scramble,
+		second_scramble,
+		"expected [%s], got [%s]",
+		first_scramble,
+		second_scramble);
+
+	free(first_scramble);
+	free(second_scramble);
+	rba_destroy_context(first_context);
+	rba_destroy_context(second_context);
+}
+
+
+Test(random, different_seeds_generate_different_scrambles)
+{
+	// given: 2 contexts with different seeds
+	struct rba_context * first_context = rba_create_context(1);
+	struct rba_context * second_context = rba_create_context(2);
+
+	// when: generating a scramble with each of them
+	char * first_scramble = rba_generate_scramble_r(first_context, SCRAMBLE_SIZE, NO_OPTIONS);
+	char * second_scramble = rba_generate_scramble_r(second_context, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// then: they should differ
+	cr_assert_str_neq(first_scramble, second_scramble, "both seeds generated [%s]", first_scramble);
+
+	free(first_scramble);
+	free(second_scramble);
+	rba_destroy_context(first_context);
+	rba_destroy_context(second_context);
+}
+
+
+Test(random, reseeding_restarts_the_sequence)
+{
+	// given: a scramble generated right after seeding
+	struct rba_context * context = rba_create_context(7);
+	char * first_scramble = rba_generate_scramble_r(context, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// when: reseeding with the same seed
+	rba_seed_context(context, 7);
+	char * second_scramble = rba_generate_scramble_r(context, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// then: the same scramble is generated again
+	cr_assert_str_eq(
+		first_scramble,
+		second_scramble,
+		"expected [%s], got [%s]",
+		first_scramble,
+		second_scramble);
+
+	free(first_scramble);
+	free(second_scramble);
+	rba_destroy_context(context);
+}
+
+
+Test(random, context_doesnt_depend_on_libc_generator)
+{
+	// given: a context, and a libc generator seeded differently between runs
+	struct rba_context * context = rba_create_context(3);
+	char buffer[3 * SCRAMBLE_SIZE];
+	char * expected_scramble;
+	size_t length;
+
+	srand(1);
+	expected_scramble = rba_generate_scramble_r(context, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// when: generating again from the same seed after reseeding libc
+	srand(2);
+	rba_seed_context(context, 3);
+	length = rba_generate_scramble_into_r(context, buffer, sizeof(buffer), SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// then: the scramble is unchanged
+	cr_assert_neq(length, 0, "the scramble should fit in %zu bytes", sizeof(buffer));
+	cr_assert_str_eq(buffer, expected_scramble, "expected [%s], got [%s]", expected_scramble, buffer);
+
+	free(expected_scramble);
+	rba_destroy_context(context);
+}
+
+
+Test(random, index_zero_is_the_seed_sequence)
+{
+	// given: a context seeded without index
+	struct rba_context * context = rba_create_context(9);
+
+	// when: generating the scramble of index 0
+	char * expected_scramble = rba_generate_scramble_r(context, SCRAMBLE_SIZE, NO_OPTIONS);
+	char * scramble = rba_generate_scramble_at(9, 0, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// then: they are the same
+	cr_assert_str_eq(scramble, expected_scramble, "expected [%s], got [%s]", expected_scramble, scramble);
+
+	free(scramble);
+	free(expected_scramble);
+	rba_destroy_context(context);
+}
+
+
+Test(random, indexes_generate_different_scrambles)
+{
+	// given
+	uint64_t seed = 12;
+
+	// when: generating consecutive indexes
+	char * first_scramble = rba_generate_scramble_at(seed, 1000, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	char * second_scramble = rba_generate_scramble_at(seed, 1001, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+	// then: they differ
+	cr_assert_str_neq(first_scramble, second_scramble, "both indexes generated [%s]", first_scramble);
+
+	free(first_scramble);
+	free(second_scramble);
+}
+
+
+Test(random, split_batches_match_whole_batch)
+{
+	// given: a batch, and the same indexes split in 2 batches
+	uint64_t seed = 77;
+	struct rba_scramble_batch * whole_batch = rba_generate_scrambles_at(seed, 0, 100, SCRAMBLE_SIZE, NO_OPTIONS);
+	struct rba_scramble_batch * first_half = rba_generate_scrambles_at(seed, 0, 50, SCRAMBLE_SIZE, NO_OPTIONS);
+	struct rba_scramble_batch * second_half = rba_generate_scrambles_at(seed, 50, 50, SCRAMBLE_SIZE, NO_OPTIONS);
+
+	// then: each scramble is the one of its index, whatever the batch
+	for (size_t index = 0; index < 100; index++)
+	{
+		struct rba_scramble_batch * half = index < 50 ? first_half : second_half;
+		char * expected_scramble = rba_generate_scramble_at(seed, index, SCRAMBLE_SIZE, NO_OPTIONS);
+
+		cr_assert_str_eq(
+			whole_batch->strings + whole_batch->offsets[index],
+			expected_scramble,
+			"scramble %zu of the whole batch differs",
+			index);
+		cr_assert_str_eq(
+			half->strings + half->offsets[index % 50],
+			expected_scramble,
+			"scramble %zu of the split batches differs",
+			index);
+
+		free(expected_scramble);
+	}
+
+	free(whole_batch);
+	free(first_half);
+	free(second_half);
+}
+
+
+Test(random, context_reseeded_at_index_matches_scramble_at)
+{
+	// given: a context which already generated scrambles
+	struct rba_context * context = rba_create_context(0);
+	char buffer[3 * SCRAMBLE_SIZE];
+	free(rba_generate_scramble_r(context, SCRAMBLE_SIZE, NO_OPTIONS));
+
+	// when: reseeding it at an index
+	rba_seed_context_at(context, 5, 123456789);
+	char * scramble = rba_generate_scramble_r(context, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+	size_t length = rba_generate_scramble_into_at(5, 123456789, buffer, sizeof(buffer), SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+	// then: it generates the scramble of this index
+	cr_assert_neq(length, 0, "the scramble should fit in %zu bytes", sizeof(buffer));
+	cr_assert_str_eq(scramble, buffer, "expected [%s], got [%s]", buffer, scramble);
+
+	free(scramble);
+	rba_destroy_context(context);
+}
@@ -1,4 +1,5 @@
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <criterion/criterion.h>
@@ -16,6 +17,12 @@
 #define BIG_SIZE 8192
 
 
+/**
+ * Statistical tests need millions of moves to detect small biases
+ */
+#define STATISTICS_SIZE (1 << 21)
+
+
 /**
  * Scramble tests rely on some helpers to be more concise, better make sure
  * 	they still work when modified
@@ -72,6 +79,25 @@ static char const * valid_extended_moves[] =
 
 
 
+/**
+ * All moves the generator picks with wide moves, every wide layer but the
+ * 	ones skipping the middle layers
+ */
+static char const * generated_extended_moves[] =
+{
+	"L",  "R",  "U",  "D",  "F",  "B",  "E",  "M",  "S",
+	"L'", "R'", "U'", "D'", "F'", "B'", "E'", "M'", "S'",
+	"L2", "R2", "U2", "D2", "F2", "B2", "E2", "M2", "S2",
+
+	"l",  "r",  "u",  "d",  "f",  "b",
+	"l'", "r'", "u'", "d'", "f'", "b'",
+	"l2", "r2", "u2", "d2", "f2", "b2",
+
+	/* sentinel */
+	NULL
+};
+
+
 /**
  * Parameterized tests arguments for symbols check
  */
@@ -89,6 +115,29 @@ typedef struct layers_symbols_params
 } layers_symbols_params;
 
 
+/**
+ * Parameterized tests arguments for distribution check
+ */
+typedef struct moves_distribution_params
+{
+	/**
+	 * The valid moves set matching the flags
+	 */
+	char ** valid_moves;
+
+	/**
+	 * The layers range option
+	 */
+	enum rba_option flags;
+
+	/**
+	 * The chi-square value a uniform distribution stays below with
+	 * 	a probability of 0.999
+	 */
+	double critical_chi_square;
+} moves_distribution_params;
+
+
 /**
  * Parameterized tests arguments for moves check
  */
@@ -146,6 +195,26 @@ static void free_layers_moves_params(struct criterion_test_params * crp)
 
 
 
+/**
+ * Called by Criterion, if specified in cr_make_param_array()
+ * Deallocates strings which were allocated for a parameterized test
+ *
+ * @param crp - provided by Criterion
+ */
+static void free_moves_distribution_params(struct criterion_test_params * crp)
+{
+	for (size_t i = 0; i < crp->length; i++)
+	{
+		moves_distribution_params params = ((moves_distribution_params *) crp->params)[i];
+
+		for (int j = 0; params.valid_moves[j] != NULL; j++)
+			cr_free(params.valid_moves[j]);
+
+		cr_free(params.valid_moves);
+	}
+}
+
+
 /* Init random generator before running any test */
 TestSuite(scramble, .init = init_random);
 
@@ -300,6 +369,285 @@ Test(scramble, doesnt_contain_consecutive_moves_on_same_axis)
 
 
 
+Test(scramble, wide_scramble_doesnt_contain_consecutive_moves_on_same_axis)
+{
+	// given
+	size_t scramble_size = BIG_SIZE;
+
+	// when
+	char * scramble = rba_generate_scramble(scramble_size, USE_WIDE_MOVES);
+
+	// then
+	char const * first_repeating_axis = find_repeated_axis(scramble);
+	cr_assert_null(
+		first_repeating_axis,
+		"repeating axis [%.6s...] found at position %ld in [%.*s...]",
+		first_repeating_axis,
+		first_repeating_axis - scramble,
+		(int) (first_repeating_axis - scramble + 10),
+		scramble);
+}
+
+
+ParameterizedTestParameters(scramble, moves_are_uniformly_distributed)
+{
+	static moves_distribution_params params[2];
+
+	/* Base layers only, 27 moves so 26 degrees of freedom */
+	params[0] = (moves_distribution_params) { cr_strsdup(valid_base_moves), NO_OPTIONS, 54.05 };
+
+	/* With wide moves, 45 moves so 44 degrees of freedom */
+	params[1] = (moves_distribution_params) { cr_strsdup(generated_extended_moves), USE_WIDE_MOVES, 78.75 };
+
+	return cr_make_param_array(
+		moves_distribution_params,
+		params,
+		2,
+		free_moves_distribution_params);
+}
+
+
+ParameterizedTest(
+	moves_distribution_params * params,
+	scramble,
+	moves_are_uniformly_distributed)
+{
+	// given: millions of moves from a seeded generator
+	struct rba_context * context = rba_create_context(20240101);
+	char * scramble = rba_generate_scramble_r(context, STATISTICS_SIZE, params->flags);
+	size_t moves_count = 0;
+	size_t counts[64] = { 0 };
+
+	// when: counting each move
+	while (params->valid_moves[moves_count] != NULL)
+		moves_count++;
+
+	for (char * move = strtok(scramble, " "); move != NULL; move = strtok(NULL, " "))
+	{
+		int index = find_move_index((char const * const *) params->valid_moves, move);
+		cr_assert_geq(index, 0, "invalid move [%s]", move);
+		counts[index]++;
+	}
+
+	// then: every move is as likely
+	double chi_square = uniform_chi_square(counts, moves_count);
+	cr_assert_lt(
+		chi_square,
+		params->critical_chi_square,
+		"moves are not uniformly distributed, chi-square is %f",
+		chi_square);
+
+	free(scramble);
+	rba_destroy_context(context);
+}
+
+
+Test(scramble, into_returns_zero_on_invalid_size)
+{
+	// given
+	char buffer[16];
+	size_t invalid_size = 0;
+
+	// when
+	size_t length = rba_generate_scramble_into(buffer, sizeof(buffer), invalid_size, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, 0, "scramble of length 0 makes no sense");
+}
+
+
+Test(scramble, into_returns_zero_on_too_small_buffer)
+{
+	// given: room for a single move
+	char buffer[3];
+
+	// when: writing 2 moves
+	size_t length = rba_generate_scramble_into(buffer, sizeof(buffer), 2, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, 0, "the scramble can't fit in the buffer");
+	cr_assert_eq(buffer[0], '\0', "the buffer should be left empty, found [%s]", buffer);
+}
+
+
+ParameterizedTestParameters(scramble, into_fits_in_computed_buffer_size)
+{
+	static layers_moves_params params[2];
+
+	/* Base layers only */
+	params[0] = (layers_moves_params) { cr_strsdup(valid_base_moves), NO_OPTIONS };
+
+	/* With wide moves */
+	params[1] = (layers_moves_params) { cr_strsdup(valid_extended_moves), USE_WIDE_MOVES };
+
+	return cr_make_param_array(layers_moves_params, params, 2, free_layers_moves_params);
+}
+
+
+ParameterizedTest(layers_moves_params * params, scramble, into_fits_in_computed_buffer_size)
+{
+	// given: a buffer sized for a big scramble
+	size_t size = BIG_SIZE;
+	size_t capacity = rba_compute_scramble_buffer_size(size, params->flags);
+	char * buffer = malloc(capacity);
+
+	// when: writing the scramble into it
+	size_t length = rba_generate_scramble_into(buffer, capacity, size, params->flags);
+
+	// then: the whole scramble is writen, and made of valid moves
+	cr_assert_neq(length, 0, "the scramble should fit in %zu bytes", capacity);
+	cr_assert_eq(length, strlen(buffer), "expected %zu characters, found %zu", length, strlen(buffer));
+	cr_assert_eq(count_occurrences(buffer, ' '), size - 1, "expected %zu moves", size);
+
+	char * first_invalid_move = find_invalid_move(
+		buffer,
+		(char const * const *) params->valid_moves);
+	cr_assert_null(first_invalid_move, "invalid move [%s] found", first_invalid_move);
+
+	free(buffer);
+}
+
+
+
+Test(scramble, batch_returns_null_on_invalid_count)
+{
+	// given
+	size_t invalid_count = 0;
+
+	// when
+	struct rba_scramble_batch * batch = rba_generate_scrambles(invalid_count, 20, NO_OPTIONS);
+
+	// then
+	cr_assert_null(batch, "a batch without scrambles makes no sense");
+}
+
+
+Test(scramble, batch_returns_null_on_overflowing_count)
+{
+	// given: offsets alone taking more than the address space
+	size_t huge_count = (size_t) -1 / 2;
+
+	// when
+	struct rba_scramble_batch * batch = rba_generate_scrambles(huge_count, 1, NO_OPTIONS);
+
+	// then
+	cr_assert_null(batch, "a batch of %zu scrambles can't be allocated", huge_count);
+}
+
+
+Test(scramble, batch_stores_scrambles_back_to_back)
+{
+	// given
+	size_t count = 100;
+	size_t size = 25;
+
+	// when
+	struct rba_scramble_batch * batch = rba_generate_scrambles(count, size, USE_WIDE_MOVES);
+
+	// then: each scramble starts right after the previous one
+	cr_assert_not_null(batch, "the batch should be allocated");
+	cr_assert_eq(batch->count, count, "expected %zu scrambles, found %zu", count, batch->count);
+	cr_assert_eq(batch->offsets[0], 0, "the first scramble should start the strings");
+
+	for (size_t index = 0; index < count; index++)
+	{
+		char const * scramble = batch->strings + batch->offsets[index];
+
+		cr_assert_eq(
+			batch->offsets[index + 1],
+			batch->offsets[index] + strlen(scramble) + 1,
+			"scramble %zu isn't followed by the next one",
+			index);
+		cr_assert_eq(
+			count_occurrences(scramble, ' '),
+			size - 1,
+			"expected %zu moves in [%s]",
+			size,
+			scramble);
+	}
+
+	free(batch);
+}
+
+
+Test(scramble, batch_matches_one_by_one_generation)
+{
+	// given: 2 contexts with the same seed
+	struct rba_context * batch_context = rba_create_context(5);
+	struct rba_context * single_context = rba_create_context(5);
+	size_t count = 16;
+
+	// when: generating a batch with the first one
+	struct rba_scramble_batch * batch = rba_generate_scrambles_r(batch_context, count, BIG_SIZE, NO_OPTIONS);
+
+	// then: it contains what the second one generates scramble by scramble
+	for (size_t index = 0; index < count; index++)
+	{
+		char * expected_scramble = rba_generate_scramble_r(single_context, BIG_SIZE, NO_OPTIONS);
+
+		cr_assert_str_eq(
+			batch->strings + batch->offsets[index],
+			expected_scramble,
+			"scramble %zu differs",
+			index);
+
+		free(expected_scramble);
+	}
+
+	free(batch);
+	rba_destroy_context(batch_context);
+	rba_destroy_context(single_context);
+}
+
+
+
+Test(scramble, moves_match_singmaster_scramble)
+{
+	// given: 2 contexts with the same seed
+	struct rba_context * moves_context = rba_create_context(11);
+	struct rba_context * string_context = rba_create_context(11);
+	rba_move_code moves[BIG_SIZE];
+	size_t capacity = rba_compute_scramble_buffer_size(BIG_SIZE, USE_WIDE_MOVES);
+	char * buffer = malloc(capacity);
+
+	// when: generating moves with the first one, and a string with the second one
+	size_t count = rba_generate_scramble_moves_r(moves_context, moves, BIG_SIZE, USE_WIDE_MOVES);
+	char * scramble = rba_generate_scramble_r(string_context, BIG_SIZE, USE_WIDE_MOVES);
+
+	// then: the moves are the codes of the scramble
+	cr_assert_eq(count, BIG_SIZE, "expected %d moves, got %zu", BIG_SIZE, count);
+	cr_assert_neq(rba_write_move_codes(moves, count, buffer, capacity), 0, "moves should be valid");
+	cr_assert_str_eq(buffer, scramble, "moves don't match the scramble");
+
+	free(buffer);
+	free(scramble);
+	rba_destroy_context(moves_context);
+	rba_destroy_context(string_context);
+}
+
+
+Test(scramble, base_moves_have_base_codes)
+{
+	// given
+	rba_move_code moves[BIG_SIZE];
+
+	// when
+	size_t count = rba_generate_scramble_moves(moves, BIG_SIZE, NO_OPTIONS);
+
+	// then
+	for (size_t index = 0; index < count; index++)
+	{
+		cr_assert_lt(
+			moves[index],
+			BASE_MOVE_CODES_COUNT,
+			"code %d at position %zu is not a base move",
+			moves[index],
+			index);
+	}
+}
+
+
+
 
 #ifdef CHECK_HELPERS
 
@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The length of the random sequences to simplify, short so that some axes
+ * repeat
+ */
+#define SEQUENCE_SIZE 64
+
+
+/**
+ * The number of random sequences to simplify
+ */
+#define SEQUENCES_COUNT 200
+
+
+
+
+/**
+ * Reads a sequence in singmaster notation, which must be valid
+ *
+ * @param scramble - the sequence to read
+ *
+ * @param moves - the buffer to write the codes to, SEQUENCE_SIZE codes
+ *
+ * @return size_t - the number of moves
+ */
+static size_t read_moves(char const * scramble, rba_move_code * moves)
+{
+	size_t count = rba_read_move_codes(scramble, moves, SEQUENCE_SIZE);
+
+	cr_assert_gt(count, 0, "[%s] should be read", scramble);
+
+	return count;
+}
+
+
+/**
+ * Draws a sequence of random moves turning around 2 axes only, so that
+ * consecutive moves often commute, wide moves included
+ *
+ * @param moves - the buffer to write the codes to, SEQUENCE_SIZE codes
+ */
+static void draw_moves(rba_move_code * moves)
+{
+	/* L M R U E D l r u d */
+	static rba_move_code const layers[] = { 0, 1, 2, 3, 4, 5, 9, 10, 11, 12 };
+
+	for (size_t index = 0; index < SEQUENCE_SIZE; index++)
+		moves[index] = 3 * layers[rand() % (sizeof(layers) / sizeof(* layers))] + rand() % 3;
+}
+
+
+/**
+ * Tells whether 2 sequences of moves give the same cube
+ *
+ * @param moves - the first sequence
+ *
+ * @param count - the number of moves of the first sequence
+ *
+ * @param other_moves - the second sequence
+ *
+ * @param other_count - the number of moves of the second sequence
+ *
+ * @return int - 1 if the cubes are the same, 0 otherwise
+ */
+static int give_same_cube(
+	rba_move_code const * moves,
+	size_t count,
+	rba_move_code const * other_moves,
+	size_t other_count)
+{
+	struct rba_cube cube;
+	struct rba_cube other_cube;
+
+	rba_init_cube(& cube);
+	rba_init_cube(& other_cube);
+	rba_apply_moves(& cube, moves, count);
+	rba_apply_moves(& other_cube, other_moves, other_count);
+
+	return memcmp(cube.facelets, other_cube.facelets, FACELETS_COUNT) == 0;
+}
+
+
+
+
+Test(simplifier, merges_turns_of_the_same_layer)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code expected_moves[SEQUENCE_SIZE];
+	size_t count = read_moves("R R U2 U F F F", moves);
+	size_t expected_count = read_moves("R2 U' F'", expected_moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, moves, count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, expected_count, "expected %zu moves, got %zu", expected_count, length);
+	cr_assert_arr_eq(moves, expected_moves, length, "the turns of each layer should be merged");
+}
+
+
+Test(simplifier, commutes_moves_around_the_same_axis)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code expected_moves[SEQUENCE_SIZE];
+	size_t count = read_moves("R L R U D' U", moves);
+	size_t expected_count = read_moves("L R2 U2 D'", expected_moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, moves, count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, expected_count, "expected %zu moves, got %zu", expected_count, length);
+	cr_assert_arr_eq(moves, expected_moves, length, "the moves of each axis should be merged");
+}
+
+
+Test(simplifier, cancels_nested_identities)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code expected_moves[SEQUENCE_SIZE];
+	size_t count = read_moves("F R U D U' D' R' F2", moves);
+	size_t expected_count = read_moves("F'", expected_moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, moves, count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, expected_count, "expected %zu moves, got %zu", expected_count, length);
+	cr_assert_arr_eq(moves, expected_moves, length, "the moves should cancel out until F' is left");
+}
+
+
+Test(simplifier, simplifies_identity_to_nothing)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	size_t count = read_moves("R U U' R' L2 L2", moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, moves, count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, 0, "the moves should cancel out, got %zu moves", length);
+}
+
+
+Test(simplifier, uses_wide_moves_when_shorter)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code expected_moves[SEQUENCE_SIZE];
+	size_t count = read_moves("R M' U E' D", moves);
+	size_t expected_count = read_moves("r D u", expected_moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, moves, count, USE_WIDE_MOVES);
+
+	// then
+	cr_assert_eq(length, expected_count, "expected %zu moves, got %zu", expected_count, length);
+	cr_assert_arr_eq(moves, expected_moves, length, "face and slice moves should become wide moves");
+}
+
+
+Test(simplifier, normalizes_wide_moves)
+{
+	// given
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code simplified[2 * SEQUENCE_SIZE];
+	rba_move_code expected_moves[SEQUENCE_SIZE];
+	size_t count = read_moves("r b' d2", moves);
+	size_t expected_count = read_moves("M' R S B' E2 D2", expected_moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, simplified, 2 * count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, expected_count, "expected %zu moves, got %zu", expected_count, length);
+	cr_assert_arr_eq(simplified, expected_moves, length, "wide moves should become face and slice moves");
+}
+
+
+Test(simplifier, keeps_random_sequences_effect)
+{
+	srand(42);
+
+	for (size_t index = 0; index < SEQUENCES_COUNT; index++)
+	{
+		// given
+		rba_move_code moves[SEQUENCE_SIZE];
+		rba_move_code wide_moves[SEQUENCE_SIZE];
+		rba_move_code normalized_moves[2 * SEQUENCE_SIZE];
+		rba_move_code simplified_again[2 * SEQUENCE_SIZE];
+		draw_moves(moves);
+		memcpy(wide_moves, moves, sizeof(moves));
+
+		// when
+		size_t wide_length = rba_simplify_moves(wide_moves, SEQUENCE_SIZE, wide_moves, SEQUENCE_SIZE, USE_WIDE_MOVES);
+		size_t normalized_length = rba_simplify_moves(
+			moves,
+			SEQUENCE_SIZE,
+			normalized_moves,
+			2 * SEQUENCE_SIZE,
+			NO_OPTIONS);
+		size_t length_again = rba_simplify_moves(
+			normalized_moves,
+			normalized_length,
+			simplified_again,
+			2 * SEQUENCE_SIZE,
+			NO_OPTIONS);
+
+		// then
+		cr_assert_leq(wide_length, normalized_length, "wide moves should make sequence %zu shorter", index);
+		cr_assert(
+			give_same_cube(moves, SEQUENCE_SIZE, wide_moves, wide_length),
+			"sequence %zu simplified with wide moves should give the same cube",
+			index);
+		cr_assert(
+			give_same_cube(moves, SEQUENCE_SIZE, normalized_moves, normalized_length),
+			"normalized sequence %zu should give the same cube",
+			index);
+		cr_assert_eq(length_again, normalized_length, "sequence %zu should already be simplified", index);
+		cr_assert_arr_eq(simplified_again, normalized_moves, length_again, "sequence %zu should be unchanged", index);
+		for (size_t move = 0; move < normalized_length; move++)
+			cr_assert_lt(normalized_moves[move], BASE_MOVE_CODES_COUNT, "move %zu should not be a wide move", move);
+	}
+}
+
+
+Test(simplifier, doesnt_simplify_invalid_code)
+{
+	// given
+	rba_move_code moves[] = { 0, 0, MOVE_CODES_COUNT };
+	rba_move_code expected_moves[] = { 0, 0, MOVE_CODES_COUNT };
+
+	// when
+	size_t length = rba_simplify_moves(moves, 3, moves, 3, USE_WIDE_MOVES);
+
+	// then
+	cr_assert_eq(length, 0, "code %d is invalid, got %zu moves", MOVE_CODES_COUNT, length);
+	cr_assert_arr_eq(moves, expected_moves, 3, "the moves should be left untouched");
+}
+
+
+Test(simplifier, doesnt_overflow_buffer)
+{
+	// given: r needs 2 moves without wide moves
+	rba_move_code moves[SEQUENCE_SIZE];
+	rba_move_code simplified[SEQUENCE_SIZE];
+	size_t count = read_moves("r", moves);
+
+	// when
+	size_t length = rba_simplify_moves(moves, count, simplified, count, NO_OPTIONS);
+
+	// then
+	cr_assert_eq(length, 0, "[R M'] doesn't fit in %zu codes, got %zu moves", count, length);
+}
@@ -0,0 +1,271 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/moves.h"
+
+
+/**
+ * Long enough for a random walk to reach any state
+ */
+#define SCRAMBLE_SIZE 100
+
+
+/**
+ * The number of cubes solved by each test, solving takes a few milliseconds
+ */
+#define SOLVES_COUNT 32
+
+
+/**
+ * The number of threads solving cubes in parallel
+ */
+#define THREADS_COUNT 4
+
+
+/**
+ * The number of random state scrambles to compute statistics on
+ */
+#define STATISTICS_SIZE 300
+
+
+/**
+ * The chi-square value with 5 degrees of freedom exceeded with a 0.1%
+ * probability
+ */
+#define CHI_SQUARE_CRITICAL_VALUE 20.52
+
+
+/**
+ * The stickers of the up-right-front corner: U9, R1 and F3
+ */
+#define URF_FACELETS 8, 9, 20
+
+
+
+
+
+
+Test(solver, solves_scrambled_cubes)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+		struct rba_cube cube;
+		scramble_cube(context, & cube, SCRAMBLE_SIZE, NO_OPTIONS);
+
+		// when
+		size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+		size_t applied_count = rba_apply_moves(& cube, solution, length);
+
+		// then
+		cr_assert_gt(length, 0, "scrambled cube %zu should be solved", index);
+		cr_assert_eq(applied_count, length, "the solution should only contain valid moves");
+		cr_assert(rba_is_cube_solved(& cube), "the solution of cube %zu should solve it", index);
+		for (size_t move = 0; move < length; move++)
+			cr_assert(is_face_move(solution[move]), "move %d should be a face move", solution[move]);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(solver, solves_cubes_turned_with_slice_and_wide_moves)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given: the centers are moved too
+		rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+		struct rba_cube cube;
+		scramble_cube(context, & cube, SCRAMBLE_SIZE, USE_WIDE_MOVES);
+
+		// when
+		size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+		rba_apply_moves(& cube, solution, length);
+
+		// then
+		cr_assert_gt(length, 0, "scrambled cube %zu should be solved", index);
+		cr_assert(rba_is_cube_solved(& cube), "the solution of cube %zu should solve it", index);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(solver, threads_find_the_same_solutions_as_a_single_thread)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		rba_move_code expected_solution[RANDOM_STATE_MIN_LENGTH];
+		rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+		struct rba_cube cube;
+		scramble_cube(context, & cube, SCRAMBLE_SIZE, NO_OPTIONS);
+
+		// when
+		size_t expected_length = rba_solve_cube(& cube, expected_solution, RANDOM_STATE_MIN_LENGTH);
+		size_t length = rba_solve_cube_parallel(& cube, solution, RANDOM_STATE_MIN_LENGTH, THREADS_COUNT);
+		rba_apply_moves(& cube, solution, length);
+
+		// then
+		cr_assert_gt(length, 0, "scrambled cube %zu should be solved", index);
+		cr_assert_eq(length, expected_length, "expected %zu moves for cube %zu, got %zu", expected_length, index, length);
+		cr_assert_arr_eq(solution, expected_solution, length, "cube %zu should have the same solution", index);
+		cr_assert(rba_is_cube_solved(& cube), "the solution of cube %zu should solve it", index);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(solver, doesnt_solve_solved_cube)
+{
+	// given
+	rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+
+	// when
+	size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+
+	// then
+	cr_assert_eq(length, 0, "a solved cube needs no move, got %zu", length);
+}
+
+
+Test(solver, doesnt_solve_twisted_corner)
+{
+	// given: a single corner twisted in place, unreachable with moves
+	size_t const facelets[] = { URF_FACELETS };
+	rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	uint8_t color = cube.facelets[facelets[0]];
+	cube.facelets[facelets[0]] = cube.facelets[facelets[1]];
+	cube.facelets[facelets[1]] = cube.facelets[facelets[2]];
+	cube.facelets[facelets[2]] = color;
+
+	// when
+	size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+
+	// then
+	cr_assert_eq(length, 0, "a twisted corner can't be solved, got %zu moves", length);
+}
+
+
+Test(solver, doesnt_solve_invalid_colors)
+{
+	// given: a sticker with no matching center
+	rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+	struct rba_cube cube;
+	rba_init_cube(& cube);
+	cube.facelets[0] = FACES_COUNT;
+
+	// when
+	size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+
+	// then
+	cr_assert_eq(length, 0, "color %d is not a face, got %zu moves", FACES_COUNT, length);
+}
+
+
+Test(solver, random_state_scrambles_are_short_face_moves_sequences)
+{
+	struct rba_context * context = rba_create_context(42);
+
+	for (size_t index = 0; index < SOLVES_COUNT; index++)
+	{
+		// given
+		rba_move_code scramble[RANDOM_STATE_MIN_LENGTH];
+		struct rba_cube cube;
+		rba_init_cube(& cube);
+
+		// when
+		size_t length = rba_generate_scramble_moves_r(
+			context,
+			scramble,
+			RANDOM_STATE_MIN_LENGTH,
+			RANDOM_STATE | USE_WIDE_MOVES);
+		rba_apply_moves(& cube, scramble, length);
+
+		// then
+		cr_assert_gt(length, 0, "scramble %zu should be found", index);
+		cr_assert_leq(length, RANDOM_STATE_MIN_LENGTH, "scramble %zu is too long: %zu moves", index, length);
+		cr_assert_not(rba_is_cube_solved(& cube), "scramble %zu should mix the cube", index);
+		for (size_t move = 0; move < length; move++)
+			cr_assert(is_face_move(scramble[move]), "move %d should be a face move", scramble[move]);
+	}
+
+	rba_destroy_context(context);
+}
+
+
+Test(solver, random_state_scramble_strings_match_move_codes)
+{
+	// given: 2 generators with the same seed
+	struct rba_context * string_context = rba_create_context(42);
+	struct rba_context * moves_context = rba_create_context(42);
+	rba_move_code expected_moves[RANDOM_STATE_MIN_LENGTH];
+	rba_move_code moves[RANDOM_STATE_MIN_LENGTH];
+
+	// when
+	char * scramble = rba_generate_scramble_r(string_context, RANDOM_STATE_MIN_LENGTH, RANDOM_STATE);
+	size_t expected_length = rba_generate_scramble_moves_r(
+		moves_context,
+		expected_moves,
+		RANDOM_STATE_MIN_LENGTH,
+		RANDOM_STATE);
+	size_t length = rba_read_move_codes(scramble, moves, RANDOM_STATE_MIN_LENGTH);
+
+	// then
+	cr_assert_not_null(scramble, "the scramble should be generated");
+	cr_assert_eq(length, expected_length, "expected %zu moves in [%s], got %zu", expected_length, scramble, length);
+	cr_assert_arr_eq(moves, expected_moves, length, "[%s] should be the same scramble", scramble);
+
+	free(scramble);
+	rba_destroy_context(string_context);
+	rba_destroy_context(moves_context);
+}
+
+
+Test(solver, random_state_scrambles_give_uniform_stickers)
+{
+	// given: on a uniform random state, a corner sticker has each color 1
+	// time out of 6
+	struct rba_context * context = rba_create_context(42);
+	size_t counts[FACES_COUNT] = { 0 };
+	double expected_count = (double) STATISTICS_SIZE / FACES_COUNT;
+	double chi_square = 0.;
+
+	// when
+	for (size_t index = 0; index < STATISTICS_SIZE; index++)
+	{
+		rba_move_code scramble[RANDOM_STATE_MIN_LENGTH];
+		struct rba_cube cube;
+		size_t length = rba_generate_scramble_moves_r(context, scramble, RANDOM_STATE_MIN_LENGTH, RANDOM_STATE);
+		rba_init_cube(& cube);
+		rba_apply_moves(& cube, scramble, length);
+		counts[cube.facelets[0]]++;
+	}
+
+	// then
+	for (size_t color = 0; color < FACES_COUNT; color++)
+		chi_square += (counts[color] - expected_count) * (counts[color] - expected_count) / expected_count;
+	cr_assert_lt(
+		chi_square,
+		CHI_SQUARE_CRITICAL_VALUE,
+		"the colors of sticker 0 are not uniform, chi-square is %f",
+		chi_square);
+
+	rba_destroy_context(context);
+}
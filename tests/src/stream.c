@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+#include "helpers/scramble.h"
+
+
+/**
+ * The number of chunks to stream, enough to cross many chunk boundaries
+ */
+#define CHUNKS_COUNT 2048
+
+
+/**
+ * A small chunk size, so moves are cut at every possible position
+ */
+#define CHUNK_SIZE 7
+
+
+
+
+/**
+ * Every move the stream may generate with wide moves
+ */
+static char const * valid_extended_moves[] =
+{
+	"L",  "R",  "U",  "D",  "F",  "B",  "E",  "M",  "S",
+	"L'", "R'", "U'", "D'", "F'", "B'", "E'", "M'", "S'",
+	"L2", "R2", "U2", "D2", "F2", "B2", "E2", "M2", "S2",
+
+	"l",  "r",  "u",  "d",  "f",  "b",
+	"l'", "r'", "u'", "d'", "f'", "b'",
+	"l2", "r2", "u2", "d2", "f2", "b2",
+
+	/* sentinel */
+	NULL
+};
+
+
+
+
+/**
+ * Streams chunks back to back into a single string
+ *
+ * @param stream - the stream to read from
+ *
+ * @return char * - the NULL-terminated concatenation of the chunks
+ */
+static char * stream_chunks(struct rba_stream * stream)
+{
+	char * scramble = malloc(CHUNKS_COUNT * CHUNK_SIZE + 1);
+	size_t length = 0;
+
+	for (size_t chunk = 0; chunk < CHUNKS_COUNT; chunk++)
+	{
+		size_t writen_bytes = rba_stream_fill(stream, scramble + length, CHUNK_SIZE);
+
+		cr_assert_geq(writen_bytes, CHUNK_SIZE - 2, "chunk %zu is only %zu bytes", chunk, writen_bytes);
+		length += writen_bytes;
+	}
+	scramble[length] = '\0';
+
+	return scramble;
+}
+
+
+
+
+Test(stream, chunks_form_a_valid_scramble)
+{
+	// given
+	struct rba_stream * stream = rba_create_stream(1, USE_WIDE_MOVES);
+
+	// when: streaming many small chunks
+	char * scramble = stream_chunks(stream);
+
+	// then: the concatenation is a scramble, even across chunks
+	cr_assert_eq(scramble[strlen(scramble) - 1], ' ', "each move should be followed by a space");
+	scramble[strlen(scramble) - 1] = '\0';
+
+	char const * first_repeating_axis = find_repeated_axis(scramble);
+	cr_assert_null(
+		first_repeating_axis,
+		"repeating axis [%.6s...] found at position %ld",
+		first_repeating_axis,
+		first_repeating_axis - scramble);
+
+	char * first_invalid_move = find_invalid_move(scramble, valid_extended_moves);
+	cr_assert_null(first_invalid_move, "invalid move [%s] found", first_invalid_move);
+
+	free(scramble);
+	rba_destroy_stream(stream);
+}
+
+
+Test(stream, writes_nothing_in_too_small_buffer)
+{
+	// given: a buffer too small for a move and its separator
+	struct rba_stream * stream = rba_create_stream(2, NO_OPTIONS);
+	char buffer[2];
+
+	// when
+	size_t writen_bytes = rba_stream_fill(stream, buffer, sizeof(buffer));
+
+	// then
+	cr_assert_eq(writen_bytes, 0, "%zu bytes writen in a 2-bytes buffer", writen_bytes);
+
+	rba_destroy_stream(stream);
+}
+
+
+Test(stream, rejects_random_state)
+{
+	// when
+	struct rba_stream * stream = rba_create_stream(4, RANDOM_STATE);
+	struct rba_stream * pocket_stream = rba_create_stream(4, RANDOM_STATE | POCKET_CUBE);
+
+	// then
+	cr_assert_null(stream, "random state streams should be rejected");
+	cr_assert_null(pocket_stream, "random state 2x2x2 streams should be rejected");
+}
+
+
+Test(stream, moves_match_chunks)
+{
+	// given: 2 streams with the same seed
+	struct rba_stream * chunks_stream = rba_create_stream(3, USE_WIDE_MOVES);
+	struct rba_stream * moves_stream = rba_create_stream(3, USE_WIDE_MOVES);
+	char * scramble = stream_chunks(chunks_stream);
+	size_t count = count_occurrences(scramble, ' ');
+	rba_move_code * moves = malloc(count);
+	char * expected_scramble = malloc(3 * count);
+
+	// when: generating the same number of moves one by one
+	for (size_t index = 0; index < count; index++)
+		moves[index] = rba_stream_next_move(moves_stream);
+
+	// then: they are the moves of the chunks
+	cr_assert_neq(rba_write_move_codes(moves, count, expected_scramble, 3 * count), 0, "moves should be valid");
+	scramble[strlen(scramble) - 1] = '\0';
+	cr_assert_str_eq(scramble, expected_scramble, "moves don't match the chunks");
+
+	free(moves);
+	free(scramble);
+	free(expected_scramble);
+	rba_destroy_stream(chunks_stream);
+	rba_destroy_stream(moves_stream);
+}
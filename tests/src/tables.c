@@ -0,0 +1,312 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <criterion/criterion.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+/**
+ * The template of the names of the files written by the tests
+ */
+#define TABLES_PATH_TEMPLATE "/tmp/rubiks-algos-tables-XXXXXX"
+
+
+/**
+ * The layout of the header of a tables file
+ */
+#define MAGIC "RBA-TBLS"
+#define MAGIC_SIZE 8
+#define VERSION_OFFSET 8
+#define BYTE_ORDER_OFFSET 12
+#define HEADER_SIZE 64
+
+
+/**
+ * The byte order mark as written by a machine with the other byte order
+ */
+#define SWAPPED_BYTE_ORDER 0x04030201
+
+
+/**
+ * The number of threads building tables to compare with a single thread
+ */
+#define THREADS_COUNT 4
+
+
+
+
+/**
+ * Creates an empty file with a unique name
+ *
+ * @param path - the buffer to write the name of the file to, at least
+ * 	sizeof(TABLES_PATH_TEMPLATE) long
+ */
+static void create_tables_path(char * path)
+{
+	int descriptor;
+
+	strcpy(path, TABLES_PATH_TEMPLATE);
+	descriptor = mkstemp(path);
+	cr_assert_geq(descriptor, 0, "a temporary file should be created");
+	close(descriptor);
+}
+
+
+/**
+ * Writes a tables header alone, every field but the given one being valid
+ *
+ * @param path - the file to write
+ *
+ * @param offset - the offset of the field to set
+ *
+ * @param value - the value of the field
+ */
+static void write_header(char const * path, size_t offset, uint32_t value)
+{
+	unsigned char header[HEADER_SIZE] = { 0 };
+	uint32_t byte_order = 0x01020304;
+	uint32_t version = 1;
+	FILE * file = fopen(path, "wb");
+
+	memcpy(header, MAGIC, MAGIC_SIZE);
+	memcpy(header + VERSION_OFFSET, & version, sizeof(version));
+	memcpy(header + BYTE_ORDER_OFFSET, & byte_order, sizeof(byte_order));
+	memcpy(header + offset, & value, sizeof(value));
+
+	cr_assert_not_null(file, "%s should be opened", path);
+	fwrite(header, sizeof(header), 1, file);
+	fclose(file);
+}
+
+
+/**
+ * Reads a whole file
+ *
+ * @param path - the file to read
+ *
+ * @param size - the size of the file, output
+ *
+ * @return unsigned char * - the content of the file, to free
+ */
+static unsigned char * read_file(char const * path, long * size)
+{
+	FILE * file = fopen(path, "rb");
+	unsigned char * content;
+
+	cr_assert_not_null(file, "%s should be opened", path);
+	fseek(file, 0, SEEK_END);
+	* size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	content = malloc(* size);
+	cr_assert_not_null(content, "%s should fit in memory", path);
+	cr_assert_eq(fread(content, * size, 1, file), 1, "%s should be read", path);
+	fclose(file);
+
+	return content;
+}
+
+
+/**
+ * Gives the size of a file
+ *
+ * @param path - the file to measure
+ *
+ * @return long - the number of bytes of the file
+ */
+static long file_size(char const * path)
+{
+	FILE * file = fopen(path, "rb");
+	long size;
+
+	cr_assert_not_null(file, "%s should be opened", path);
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fclose(file);
+
+	return size;
+}
+
+
+
+
+Test(tables, saved_tables_are_loaded_and_solve)
+{
+	// given
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	rba_move_code scramble[] = { 6, 9, 7, 10, 20, 33 };
+	rba_move_code solution[RANDOM_STATE_MIN_LENGTH];
+	struct rba_cube cube;
+	create_tables_path(path);
+	rba_init_cube(& cube);
+	rba_apply_moves(& cube, scramble, sizeof(scramble) / sizeof(* scramble));
+
+	// when
+	enum rba_tables_status save_status = rba_save_solver_tables(path);
+	enum rba_tables_status load_status = rba_load_solver_tables(path, 1);
+	size_t length = rba_solve_cube(& cube, solution, RANDOM_STATE_MIN_LENGTH);
+	rba_apply_moves(& cube, solution, length);
+
+	// then
+	cr_assert_eq(save_status, TABLES_OK, "tables should be saved, got status %d", save_status);
+	cr_assert_eq(load_status, TABLES_OK, "tables should be loaded, got status %d", load_status);
+	cr_assert_gt(file_size(path), HEADER_SIZE, "the file should contain the tables");
+	cr_assert(rba_is_cube_solved(& cube), "the cube should still be solved");
+
+	remove(path);
+}
+
+
+Test(tables, threads_build_the_same_tables_as_a_single_thread)
+{
+	// given: tables are built once per process
+	char single_thread_path[sizeof(TABLES_PATH_TEMPLATE)];
+	char threads_path[sizeof(TABLES_PATH_TEMPLATE)];
+	long single_thread_size;
+	long threads_size;
+	int child_status;
+	pid_t child;
+	create_tables_path(single_thread_path);
+	create_tables_path(threads_path);
+
+	// when
+	child = fork();
+	cr_assert_geq(child, 0, "a process should be forked");
+	if (child == 0)
+	{
+		int built = (rba_build_solver_tables(1) == TABLES_OK)
+			&& (rba_save_solver_tables(single_thread_path) == TABLES_OK);
+
+		_exit(built ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+	enum rba_tables_status build_status = rba_build_solver_tables(THREADS_COUNT);
+	enum rba_tables_status save_status = rba_save_solver_tables(threads_path);
+	waitpid(child, & child_status, 0);
+
+	// then
+	cr_assert_eq(build_status, TABLES_OK, "tables should be built, got status %d", build_status);
+	cr_assert_eq(save_status, TABLES_OK, "tables should be saved, got status %d", save_status);
+	cr_assert(WIFEXITED(child_status) && (WEXITSTATUS(child_status) == EXIT_SUCCESS), "a single thread should build tables");
+	unsigned char * single_thread_tables = read_file(single_thread_path, & single_thread_size);
+	unsigned char * threads_tables = read_file(threads_path, & threads_size);
+	cr_assert_eq(threads_size, single_thread_size, "the files should have the same size");
+	cr_assert(
+		memcmp(threads_tables, single_thread_tables, threads_size) == 0,
+		"%d threads should build the same tables as a single thread",
+		THREADS_COUNT);
+
+	free(single_thread_tables);
+	free(threads_tables);
+	remove(single_thread_path);
+	remove(threads_path);
+}
+
+
+Test(tables, doesnt_load_missing_file)
+{
+	// when
+	enum rba_tables_status status = rba_load_solver_tables("/nonexistent/rubiks-algos.tables", 1);
+
+	// then
+	cr_assert_eq(status, TABLES_IO_ERROR, "expected an input/output error, got status %d", status);
+}
+
+
+Test(tables, doesnt_load_other_files)
+{
+	// given: a file without magic
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	create_tables_path(path);
+	write_header(path, 0, 0x464C457F);
+
+	// when
+	enum rba_tables_status status = rba_load_solver_tables(path, 1);
+
+	// then
+	cr_assert_eq(status, TABLES_INVALID_FILE, "expected an invalid file, got status %d", status);
+
+	remove(path);
+}
+
+
+Test(tables, doesnt_load_other_versions)
+{
+	// given
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	create_tables_path(path);
+	write_header(path, VERSION_OFFSET, 1000);
+
+	// when
+	enum rba_tables_status status = rba_load_solver_tables(path, 1);
+
+	// then
+	cr_assert_eq(status, TABLES_VERSION_MISMATCH, "expected a version mismatch, got status %d", status);
+
+	remove(path);
+}
+
+
+Test(tables, doesnt_load_other_byte_order)
+{
+	// given
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	create_tables_path(path);
+	write_header(path, BYTE_ORDER_OFFSET, SWAPPED_BYTE_ORDER);
+
+	// when
+	enum rba_tables_status status = rba_load_solver_tables(path, 1);
+
+	// then
+	cr_assert_eq(status, TABLES_ENDIANNESS_MISMATCH, "expected an endianness mismatch, got status %d", status);
+
+	remove(path);
+}
+
+
+Test(tables, doesnt_load_truncated_file)
+{
+	// given
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	create_tables_path(path);
+	cr_assert_eq(rba_save_solver_tables(path), TABLES_OK, "tables should be saved");
+	cr_assert_eq(truncate(path, file_size(path) / 2), 0, "%s should be truncated", path);
+
+	// when
+	enum rba_tables_status status = rba_load_solver_tables(path, 0);
+
+	// then
+	cr_assert_eq(status, TABLES_INVALID_FILE, "expected an invalid file, got status %d", status);
+
+	remove(path);
+}
+
+
+Test(tables, doesnt_load_corrupted_file)
+{
+	// given: a bit flipped in the tables
+	char path[sizeof(TABLES_PATH_TEMPLATE)];
+	FILE * file;
+	int byte;
+	create_tables_path(path);
+	cr_assert_eq(rba_save_solver_tables(path), TABLES_OK, "tables should be saved");
+	file = fopen(path, "r+b");
+	cr_assert_not_null(file, "%s should be opened", path);
+	fseek(file, file_size(path) / 2, SEEK_SET);
+	byte = fgetc(file);
+	fseek(file, file_size(path) / 2, SEEK_SET);
+	fputc(byte ^ 0x10, file);
+	fclose(file);
+
+	// when
+	enum rba_tables_status status = rba_load_solver_tables(path, 1);
+
+	// then
+	cr_assert_eq(status, TABLES_CHECKSUM_MISMATCH, "expected a checksum mismatch, got status %d", status);
+
+	remove(path);
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../include/rubiks_algos.h"
+
+
+
+
+/**
+ * Describes each status of the saving and loading of tables
+ */
+static char const * const status_messages[] =
+{
+	"ok",
+	"input/output error",
+	"out of memory",
+	"not a tables file, or truncated",
+	"made by another version of the library",
+	"made on a machine with another byte order",
+	"corrupted"
+};
+
+
+
+
+/**
+ * Builds the tables of the solver and writes them to the given file, then
+ * loads the file back to check it
+ */
+int main(int argc, char const * argv[])
+{
+	enum rba_tables_status status;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <tables file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	status = rba_save_solver_tables(argv[1]);
+	if (status == TABLES_OK)
+		status = rba_load_solver_tables(argv[1], 1);
+
+	if (status != TABLES_OK)
+	{
+		fprintf(stderr, "%s: %s\n", argv[1], status_messages[status]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}